@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <ftw.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "booma.h"
+#include "boomaapplication.h"
+
+struct BenchmarkSettings {
+    int Blocks = 1000;
+    int Warmup = 20;
+    std::string Mode = "";
+    std::string DataType = "";
+    std::string InputType = "GENERATOR";
+    std::string InputFile = "";
+    std::vector<std::string> ExtraOptions;
+};
+
+void PrintUsage() {
+    std::cout << "Usage: booma-bench [-option [parameter, ...]] [-- booma options]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Runs every receiver chain (mode and input datatype) as fast as possible, with a" << std::endl;
+    std::cout << "synthetic input and no output, and writes one JSON object per chain to stdout." << std::endl;
+    std::cout << "The chains run with a temporary configuration, the stored configuration is not changed." << std::endl;
+    std::cout << "IQ, I and Q chains gets a complex sine, REAL chains a realvalued sine." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Number of blocks to measure (default 1000)                -b blocks" << std::endl;
+    std::cout << "Number of blocks to run before measuring (default 20)     -w blocks" << std::endl;
+    std::cout << "Only run this receiver                                    -m CW|AURORAL|AM|SSB|RTTY" << std::endl;
+    std::cout << "Only run this input datatype                              -it REAL|IQ|I|Q" << std::endl;
+    std::cout << "Use a pcm or wav file as input instead of the generator   -i PCM|WAV filename" << std::endl;
+    std::cout << "Show this help and exit                                   -h --help" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Any options after '--' are passed on to the receiver chain, fx. '-- -dp HALFBAND -pl 4'" << std::endl;
+}
+
+bool ParseArguments(int argc, char** argv, BenchmarkSettings* settings) {
+    for( int i = 1; i < argc; i++ ) {
+        if( strcmp(argv[i], "--") == 0 ) {
+            for( i++; i < argc; i++ ) {
+                settings->ExtraOptions.push_back(argv[i]);
+            }
+            break;
+        }
+        if( strcmp(argv[i], "-b") == 0 && i < argc - 1 ) {
+            settings->Blocks = atoi(argv[++i]);
+            continue;
+        }
+        if( strcmp(argv[i], "-w") == 0 && i < argc - 1 ) {
+            settings->Warmup = atoi(argv[++i]);
+            continue;
+        }
+        if( strcmp(argv[i], "-m") == 0 && i < argc - 1 ) {
+            settings->Mode = argv[++i];
+            continue;
+        }
+        if( strcmp(argv[i], "-it") == 0 && i < argc - 1 ) {
+            settings->DataType = argv[++i];
+            continue;
+        }
+        if( strcmp(argv[i], "-i") == 0 && i < argc - 2 ) {
+            settings->InputType = argv[++i];
+            settings->InputFile = argv[++i];
+            if( settings->InputType != "PCM" && settings->InputType != "WAV" ) {
+                std::cout << "Input must be PCM or WAV" << std::endl;
+                return false;
+            }
+            continue;
+        }
+        if( strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0 ) {
+            PrintUsage();
+            exit(0);
+        }
+        std::cout << "Unknown option '" << argv[i] << "'" << std::endl;
+        PrintUsage();
+        return false;
+    }
+    return true;
+}
+
+void RunBenchmark(BenchmarkSettings* settings, std::string mode, std::string dataType) {
+
+    // Command line for the receiver chain: synthetic or file input, no output, stage timing enabled
+    std::vector<std::string> arguments = { "booma-bench", "-config", "booma-bench", "-it", dataType, "-i", settings->InputType };
+    arguments.push_back(settings->InputType == "GENERATOR" ? "1000" : settings->InputFile);
+    std::vector<std::string> common = { "-m", mode, "-o", "-1", "-st" };
+    arguments.insert(arguments.end(), common.begin(), common.end());
+    arguments.insert(arguments.end(), settings->ExtraOptions.begin(), settings->ExtraOptions.end());
+    std::vector<char*> argv;
+    for( std::vector<std::string>::iterator it = arguments.begin(); it != arguments.end(); it++ ) {
+        argv.push_back((char*) (*it).c_str());
+    }
+
+    std::stringstream ss;
+    ss << "version " << BOOMABENCH_MAJORVERSION << "." << BOOMABENCH_MINORVERSION << "." << BOOMABENCH_BUILDNO;
+    BoomaApplication app("Booma-Bench", ss.str(), argv.size(), &argv[0]);
+
+    std::cout << "{\"mode\":\"" << mode << "\",\"datatype\":\"" << dataType << "\",\"input\":\"" << settings->InputType << "\"";
+
+    // Chains that can not be build (fx. receivers that does not support the datatype) are reported but not run
+    if( app.IsFaulty() ) {
+        std::cout << ",\"status\":\"unsupported\"}" << std::endl;
+        return;
+    }
+
+    // Warm up, then measure
+    if( settings->Warmup > 0 ) {
+        app.RunBlocks(settings->Warmup);
+    }
+    app.ResetStageStatistics();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    app.RunBlocks(settings->Blocks);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Seconds of signal processed, IQ blocks contain BLOCKSIZE / 2 complex samples
+    int samplesPerBlock = dataType == "REAL" ? BLOCKSIZE : BLOCKSIZE / 2;
+    double signalSeconds = ((double) settings->Blocks * samplesPerBlock) / app.GetOutputSampleRate();
+
+    std::cout << ",\"status\":\"ok\"";
+    std::cout << ",\"blocks\":" << settings->Blocks;
+    std::cout << ",\"blocksize\":" << BLOCKSIZE;
+    std::cout << ",\"samplerate\":" << app.GetOutputSampleRate();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << ",\"seconds\":" << seconds;
+    std::cout << ",\"blocks_per_second\":" << (seconds > 0 ? settings->Blocks / seconds : 0);
+    std::cout << ",\"realtime_factor\":" << (seconds > 0 ? signalSeconds / seconds : 0);
+    std::cout << ",\"stages\":[";
+    std::vector<BoomaStageStatistics> stages = app.GetStageStatistics();
+    for( std::vector<BoomaStageStatistics>::iterator it = stages.begin(); it != stages.end(); it++ ) {
+        std::cout << (it == stages.begin() ? "" : ",");
+        std::cout << "{\"name\":\"" << (*it).Name << "\",\"calls\":" << (*it).Calls << ",\"ns_per_sample\":" << (*it).NanosecondsPerSample;
+        std::cout << ",\"min_ns\":" << (*it).Min << ",\"p50_ns\":" << (*it).P50 << ",\"p99_ns\":" << (*it).P99 << ",\"max_ns\":" << (*it).Max << "}";
+    }
+    std::cout << "]}" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+int RemoveFile(const char* path, const struct stat* stats, int type, struct FTW* ftw) {
+    return remove(path);
+}
+
+int main(int argc, char** argv) {
+
+    BenchmarkSettings settings;
+    if( !ParseArguments(argc, argv, &settings) ) {
+        return 1;
+    }
+
+    // Keep the configuration of the chains in a temporary home, so that it is not added to
+    // the stored configuration of the user
+    char home[] = "/tmp/booma-bench-XXXXXX";
+    if( mkdtemp(home) == nullptr ) {
+        std::cout << "Unable to create a temporary configuration directory" << std::endl;
+        return 1;
+    }
+    setenv("HOME", home, 1);
+    int result = 0;
+
+    std::vector<std::string> modes = { "CW", "AM", "SSB", "AURORAL", "RTTY" };
+    std::vector<std::string> dataTypes = { "REAL", "IQ", "I", "Q" };
+    try {
+        for( std::vector<std::string>::iterator mode = modes.begin(); mode != modes.end(); mode++ ) {
+            if( settings.Mode != "" && settings.Mode != *mode ) {
+                continue;
+            }
+            for( std::vector<std::string>::iterator dataType = dataTypes.begin(); dataType != dataTypes.end(); dataType++ ) {
+                if( settings.DataType != "" && settings.DataType != *dataType ) {
+                    continue;
+                }
+                RunBenchmark(&settings, *mode, *dataType);
+            }
+        }
+    }
+    catch( BoomaException *boomaException ) {
+        HError("Caught BoomaException: %s", boomaException->what());
+        std::cout << "Caught unexpected internal exception (" << boomaException->What() << ")" << std::endl;
+        result = 1;
+    }
+    catch( ... ) {
+        HError("Caught unknown exception");
+        std::cout << "Caught unknown exception" << std::endl;
+        result = 1;
+    }
+
+    nftw(home, RemoveFile, 16, FTW_DEPTH | FTW_PHYS);
+    return result;
+}
@@ -25,6 +25,9 @@ void Info::GetInfo() {
         case WAV_FILE:
             std::cout << "WAV file " << _app->GetWavFile() << std::endl;
             break;
+        case BLC_FILE:
+            std::cout << "BLC file " << _app->GetBlcFile() << std::endl;
+            break;
         case SILENCE:
             std::cout << "Silence" << std::endl;
             break;
@@ -63,6 +66,36 @@ void Info::GetInfo() {
     std::cout << "Average signal measurement: " << _app->GetSignalSum() << std::endl;
     std::cout << std::endl;
 
+    // Input ring buffer
+    std::cout << "Input overflows: " << _app->GetInputOverflows() << " blocks dropped" << std::endl;
+    std::cout << "Input underruns: " << _app->GetInputUnderruns() << std::endl;
+    std::cout << std::endl;
+
+    // Pipeline stages
+    std::vector<BoomaPipelineStatistics> pipeline = _app->GetPipelineStatistics();
+    if( !pipeline.empty() ) {
+        std::cout << "Pipeline:" << std::endl;
+        for( std::vector<BoomaPipelineStatistics>::iterator it = pipeline.begin(); it != pipeline.end(); it++ ) {
+            std::cout << "  " << (*it).Name << ": " << (*it).Blocks << " blocks, queue " << (*it).HighWater << "/" << (*it).Depth
+                      << ", " << (*it).FullWaits << " waits, latency avg " << (*it).AverageLatency << "ms max " << (*it).MaxLatency << "ms" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    // Additional receiver channels
+    if( _app->GetReceiverChannelCount() > 0 ) {
+        std::cout << "Receiver channels:" << std::endl;
+        for( int i = 0; i < _app->GetReceiverChannelCount(); i++ ) {
+            std::cout << "  " << _app->GetReceiverChannelName(i) << " " << _app->GetReceiverChannelFrequency(i) << "Hz ";
+            if( _app->IsReceiverChannelActive(i) ) {
+                std::cout << "S" << _app->GetReceiverChannelSignalLevel(i) << " (" << _app->GetReceiverChannelOptionInfoString(i) << ")" << std::endl;
+            } else {
+                std::cout << "(outside input spectrum)" << std::endl;
+            }
+        }
+        std::cout << std::endl;
+    }
+
     // RF spectrum
     double rfSpectrum[_app->GetRfFftSize()];
     int rfN = _app->GetRfSpectrum(rfSpectrum);
@@ -76,6 +109,94 @@ void Info::GetInfo() {
     std::cout << std::endl;
 }
 
+void Info::GetStageTiming() {
+
+    // Stage timing must be enabled when the receiver is created
+    if( !_app->GetStageTiming() ) {
+        std::cout << "Stage timing is not enabled, restart with '-st'" << std::endl;
+        return;
+    }
+
+    // Per stage call count, time per sample and latency per call (in microseconds)
+    std::vector<BoomaStageStatistics> stages = _app->GetStageStatistics();
+    printf("%-32s %10s %10s %10s %10s %10s %10s\n", "Stage", "Calls", "ns/sample", "Min us", "P50 us", "P99 us", "Max us");
+    for( std::vector<BoomaStageStatistics>::iterator it = stages.begin(); it != stages.end(); it++ ) {
+        printf("%-32s %10lu %10.2f %10.1f %10.1f %10.1f %10.1f\n", (*it).Name.c_str(), (*it).Calls, (*it).NanosecondsPerSample,
+               (*it).Min / 1000, (*it).P50 / 1000, (*it).P99 / 1000, (*it).Max / 1000);
+    }
+}
+
+void Info::GetDumpStatistics() {
+
+    // Only the asynchronous writers ('-aio', '-dsm' and '-dsz') has counters
+    std::vector<BoomaAsyncWriterStatistics> writers = _app->GetDumpStatistics();
+    if( writers.empty() ) {
+        std::cout << "No asynchronous dump writers, use '-aio' or segmented dumps" << std::endl;
+        return;
+    }
+
+    // Queued and written data, dropped samples and time per write (in microseconds)
+    printf("%-32s %12s %12s %10s %10s %10s %10s\n", "Writer", "Queued kB", "Written kB", "Dropped", "Writes", "Avg us", "Max us");
+    for( std::vector<BoomaAsyncWriterStatistics>::iterator it = writers.begin(); it != writers.end(); it++ ) {
+        printf("%-32s %12lu %12lu %10lu %10lu %10.1f %10.1f\n", (*it).Name.c_str(), (*it).QueuedBytes / 1024, (*it).WrittenBytes / 1024,
+               (*it).DroppedSamples, (*it).Writes, (*it).AverageLatency, (*it).MaxLatency);
+
+        // Live segmented dumps drops samples when the disk falls behind, show it with the current segment
+        if( (*it).Segment != "" ) {
+            printf("    segment %s, %lu samples dropped\n", (*it).Segment.c_str(), (*it).DroppedSamples);
+        }
+    }
+}
+
+void Info::GetRemoteStatistics() {
+
+    // Only remote heads and servers has stream counters, delays requires the framed wire format ('-wf' or '-udp')
+    std::vector<BoomaRemoteStatistics> streams = _app->GetRemoteStatistics();
+    if( streams.empty() ) {
+        std::cout << "No remote streams" << std::endl;
+        return;
+    }
+
+    // Throughput, delay from the server timestamp (in milliseconds), clock drift (in ppm), queue depth and dropped blocks
+    printf("%-12s %10s %10s %10s %10s %10s %10s %10s\n", "Stream", "kB/s", "Latency", "Max", "Jitter", "Drift", "Queued", "Dropped");
+    for( std::vector<BoomaRemoteStatistics>::iterator it = streams.begin(); it != streams.end(); it++ ) {
+        if( (*it).HasTimestamps ) {
+            printf("%-12s %10.1f %10.1f %10.1f %10.1f %10.1f %10lu %10lu\n", (*it).Name.c_str(), (*it).BytesPerSecond / 1024,
+                   (*it).Latency, (*it).MaxLatency, (*it).Jitter, (*it).ClockDrift, (*it).QueueDepth, (*it).Dropped);
+        } else {
+            printf("%-12s %10.1f %10s %10s %10s %10s %10lu %10lu\n", (*it).Name.c_str(), (*it).BytesPerSecond / 1024,
+                   "-", "-", "-", "-", (*it).QueueDepth, (*it).Dropped);
+        }
+    }
+}
+
+void Info::GetDecodedText() {
+    if( !_app->HasDecoder() ) {
+        std::cout << "No decoder, start a CW receiver with '-cwd' or an RTTY receiver" << std::endl;
+        return;
+    }
+
+    // Text decoded since the last call, with the estimated speed
+    printf("%-12s %3d wpm: %s\n", "Receiver", _app->GetDecoderWpm(), _app->GetDecodedText().c_str());
+    for( int i = 0; i < _app->GetReceiverChannelCount(); i++ ) {
+        printf("%-12s %3d wpm: %s\n", _app->GetReceiverChannelName(i).c_str(), _app->GetReceiverChannelDecoderWpm(i), _app->GetReceiverChannelDecodedText(i).c_str());
+    }
+}
+
+void Info::GetSkimmerSpots() {
+    if( !_app->HasSkimmer() ) {
+        std::cout << "No skimmer, start with '-sk'" << std::endl;
+        return;
+    }
+
+    // Signals with decoded text, lowest frequency first
+    std::vector<BoomaSkimmerSpot> spots = _app->GetSkimmerSpots();
+    printf("%-12s %6s %4s %-12s %s\n", "Frequency", "SNR dB", "WPM", "Callsign", "Text");
+    for( std::vector<BoomaSkimmerSpot>::iterator it = spots.begin(); it != spots.end(); it++ ) {
+        printf("%-12ld %6d %4d %-12s %s\n", (*it).Frequency, (*it).Snr, (*it).Wpm, (*it).Callsign.c_str(), (*it).Text.c_str());
+    }
+}
+
 void Info::Spectrum(std::string name, int fSample, double* spectrum, int n, int frequencyMarker) {
 
     // Find maximum magnitude for 2 bins
@@ -22,6 +22,11 @@ class Info {
         }
 
         void GetInfo();
+        void GetStageTiming();
+        void GetDumpStatistics();
+        void GetRemoteStatistics();
+        void GetDecodedText();
+        void GetSkimmerSpots();
 };
 
 #endif
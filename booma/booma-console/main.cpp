@@ -30,6 +30,7 @@ std::string TranslateReceiverModeType(ReceiverModeType type) {
         case ReceiverModeType::CW: return "CW";
         case ReceiverModeType::AM: return "AM";
         case ReceiverModeType::SSB: return "SSB";
+        case ReceiverModeType::RTTY: return "RTTY";
         default: return "UNKNOWN_RECEIVER";
     }
 }
@@ -58,6 +59,23 @@ int main(int argc, char** argv) {
     try {
         BoomaApplication app("Booma-Console", ss.str(), argc, argv);
 
+        // Batch mode - process the input file as fast as possible, then exit
+        if( app.GetBatchMode() ) {
+            std::cout << "Batch processing is starting" << std::endl;
+            BoomaBatchReport report;
+            if( !app.RunBatch(&report) ) {
+                std::cout << "Batch processing failed, check the log" << std::endl;
+                return 1;
+            }
+            std::cout << "Batch processing has been completed" << std::endl;
+            std::cout << "Segments: " << report.Segments << std::endl;
+            std::cout << "Input: " << report.InputSeconds << " seconds" << std::endl;
+            std::cout << "Output: " << report.OutputSamples << " samples written to " << app.GetOutputFilename() << std::endl;
+            std::cout << "Processing time: " << report.Seconds << " seconds" << std::endl;
+            std::cout << "Realtime factor: " << report.RealtimeFactor << "x" << std::endl;
+            return 0;
+        }
+
         // Wait for scheduled start time or stop now if we have passed a scheduled stop time
         if( app.GetSchedule().Before() ) {
             HLog("Scheduled start is pending. Waiting %ld seconds", app.GetSchedule().Duration());
@@ -135,7 +153,7 @@ int main(int argc, char** argv) {
             else
             {
                 // Does the command requires an option ?
-                if( cmd == 'f' || cmd == 'g' || cmd == 'v' || cmd == 'r' || cmd == 'o' || cmd == 'b' || cmd == 'c' || cmd == 'd' || cmd == 'w' || cmd == 'e' || cmd == 'z' || cmd == 'n' || cmd == 'u' ) {
+                if( cmd == 'f' || cmd == 'g' || cmd == 'v' || cmd == 'r' || cmd == 'o' || cmd == 'b' || cmd == 'c' || cmd == 'd' || cmd == 'w' || cmd == 'e' || cmd == 'z' || cmd == 'n' || cmd == 'u' || cmd == 'R' ) {
                     std::cin >> opt;
                 }
                 else
@@ -197,6 +215,19 @@ int main(int argc, char** argv) {
                 app.ToggleDumpAudio();
             }
 
+            // Capture the buffered rf and audio
+            else if( cmd == 'R' ) {
+                if( app.GetCaptureSeconds() <= 0 ) {
+                    std::cout << "The capture buffer is not enabled, restart with '-cap seconds'" << std::endl;
+                }
+                else if( atoi(opt.c_str()) <= 0 ) {
+                    app.StopCapture();
+                }
+                else if( !app.Capture(atoi(opt.c_str())) ) {
+                    std::cout << "A capture is already running" << std::endl;
+                }
+            }
+
             // Increase/decrease rf gain
             else if( cmd == 'g' ) {
                 if( !app.GetRfGainEnabled() ) {
@@ -245,6 +276,11 @@ int main(int argc, char** argv) {
                     std::this_thread::sleep_for(std::chrono::milliseconds(1000));
                     app.Run();
                 }
+                else if( opt == "RTTY" ) {
+                    app.ChangeReceiver(ReceiverModeType::RTTY);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                    app.Run();
+                }
                 else
                 {
                     std::cout << "Unknown receiver type" << std::endl;
@@ -357,12 +393,13 @@ int main(int argc, char** argv) {
                 std::cout << "Change frequency:                   f <frequency>  or  f +<amount>  or  -<amount>" << std::endl;
                 std::cout << "Change RF gain:                     g <[+|-]gain> or g 0 (enable auto RF gain)" << std::endl;
                 std::cout << "Change volume:                      v <volume>     or  v +<amount>  or  -<amount>" << std::endl;
-                std::cout << "Change receiver type:               r <AM|CW|SSB|AURORAL> or  s (reinitialize current receiver)" << std::endl;
+                std::cout << "Change receiver type:               r <AM|CW|SSB|AURORAL|RTTY> or  s (reinitialize current receiver)" << std::endl;
                 std::cout << "Change 1.st IF filter width:        w width" << std::endl;
                 std::cout << "List receiver options:              l" << std::endl;
                 std::cout << "Set receiver option:                o <NAME=VALUE>" << std::endl;
                 std::cout << "Toggle audio recording on/off:      u" << std::endl;
                 std::cout << "Toggle rf recording on/off:         p" << std::endl;
+                std::cout << "Capture buffered rf and audio:      R <seconds after> or R 0 (stop) (requires -cap)" << std::endl;
                 std::cout << "Enter measurement mode:             m" << std::endl;
                 std::cout << "Restart current receiver:           s" << std::endl;
                 std::cout << "Get configuration sections:         t" << std::endl;
@@ -383,6 +420,11 @@ int main(int argc, char** argv) {
                 std::cout << std::endl;
                 std::cout << "Get help (this text):               ?  or  h" << std::endl;
                 std::cout << "Get reception status:               i" << std::endl;
+                std::cout << "Get stage timing (requires -st):    y  or  Y (reset)" << std::endl;
+                std::cout << "Get dump writer counters:           D" << std::endl;
+                std::cout << "Get remote stream counters:         N" << std::endl;
+                std::cout << "Get decoded CW (-cwd) or RTTY text: T" << std::endl;
+                std::cout << "Get skimmer spots (-sk):            S" << std::endl;
                 std::cout << "Quit:                               q" << std::endl;
                 std::cout << "----------------------------------------------------------------------------------------------------" << std::endl;
             }
@@ -392,6 +434,37 @@ int main(int argc, char** argv) {
                 info.GetInfo();
             }
 
+            // Get stage timing
+            else if( cmd == 'y' ) {
+                info.GetStageTiming();
+            }
+
+            // Reset stage timing
+            else if( cmd == 'Y' ) {
+                app.ResetStageStatistics();
+                std::cout << "Stage timing has been reset" << std::endl;
+            }
+
+            // Get dump writer counters
+            else if( cmd == 'D' ) {
+                info.GetDumpStatistics();
+            }
+
+            // Get remote stream counters
+            else if( cmd == 'N' ) {
+                info.GetRemoteStatistics();
+            }
+
+            // Get text decoded since the last time
+            else if( cmd == 'T' ) {
+                info.GetDecodedText();
+            }
+
+            // Get signals found by the skimmer
+            else if( cmd == 'S' ) {
+                info.GetSkimmerSpots();
+            }
+
             // Show a running meter indicating a relative signal power - for comparing antennas and their placement.
             // The measurement is not really comparable outside your own location and equipment, but it can be used
             // to gauge where the antenna is best placed on your property.
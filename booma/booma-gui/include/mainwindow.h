@@ -53,10 +53,13 @@ class MainWindow {
         Fl_Output* _statusbarRunningState = nullptr;
         Fl_Output* _statusbarRecording = nullptr;
         Fl_Output* _statusbarPreamp = nullptr;
+        Fl_Output* _statusbarRemote = nullptr;
+        std::string _statusbarRemoteTooltip;
 
         // Dynamic labels
         char _gainLabel[50];
         char _volumeLabel[50];
+        char _decodedTextLabel[50];
 
         // Display widgets
         Waterfall* _rfInputWaterfall;
@@ -64,6 +67,8 @@ class MainWindow {
         Fl_Slider* _signalLevelSlider;
         Fl_Slider* _signalLevelAverageSlider;
         Analysis* _analysis;
+        Fl_Output* _decodedText = nullptr;
+        std::string _decodedTextLine;
 
         // Compose GUI
         void SetupMenus();
@@ -88,6 +93,7 @@ class MainWindow {
         void HandleMenuButtonReceiverRestart();
         void HandleMenuButtonReceiverDumpRf();
         void HandleMenuButtonReceiverDumpAf();
+        void HandleMenuButtonReceiverCapture();
         void HandleMenuButtonReceiverScreenshot();
         void HandleMenuButtonReceiverInput(char* name, char* value);
         void HandleMenuButtonReceiverOutput(char* name, char* value);
@@ -116,6 +122,8 @@ class MainWindow {
         void SetVolumeSliderLabel();
         void UpdateState();
         void UpdateStatusbar();
+        void UpdateRemoteStatus();
+        void UpdateDecodedText();
         Fl_Color SignalLevelColor(int level);
 
         // Display threads
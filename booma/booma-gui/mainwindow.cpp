@@ -219,6 +219,13 @@ MainWindow::MainWindow(BoomaApplication* app):
                 Fl::unlock();
                 Fl::awake();
             }
+            if( isRunning && !_threadsPaused ) {
+                Fl::lock();
+                UpdateRemoteStatus();
+                UpdateDecodedText();
+                Fl::unlock();
+                Fl::awake();
+            }
             std::this_thread::sleep_for(std::chrono::seconds (1));
         }
         _threadsAlive--;
@@ -356,6 +363,7 @@ void MainWindow::SetupReceiverMenu() {
     RenameMenuItem("Receiver/Stop", "Start");
     RenameMenuItem("Receiver/Stop recording RF", "Record RF");
     RenameMenuItem("Receiver/Stop recording AF", "Record AF");
+    RenameMenuItem("Receiver/Stop capture", "Capture last seconds");
 
     if( _app->IsRunning() ) {
         _menubar->add("Receiver/Stop", "^s", HandleMenuButtonCallback, (void*) this);
@@ -366,6 +374,9 @@ void MainWindow::SetupReceiverMenu() {
 
     _menubar->add("Receiver/Record RF", "^p", HandleMenuButtonCallback, (void*) this);
     _menubar->add("Receiver/Record AF", "^u", HandleMenuButtonCallback, (void*) this, FL_MENU_DIVIDER);
+    if( _app->GetCaptureSeconds() > 0 ) {
+        _menubar->add("Receiver/Capture last seconds", "^t", HandleMenuButtonCallback, (void*) this, FL_MENU_DIVIDER);
+    }
 
     _menubar->add("Receiver/Screenshot", "^x", HandleMenuButtonCallback, (void*) this, FL_MENU_DIVIDER);
 }
@@ -421,6 +432,8 @@ void MainWindow::SetupReceiverModeMenu() {
     _menubar->add("Receiver/Mode/SSB", 0, HandleMenuButtonCallback, (void*) this,
                   FL_MENU_RADIO | (_app->GetReceiver() == ReceiverModeType::SSB ? FL_MENU_VALUE : 0) |
                   (_app->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ? FL_MENU_INACTIVE : 0));
+    _menubar->add("Receiver/Mode/RTTY", 0, HandleMenuButtonCallback, (void*) this,
+                  FL_MENU_RADIO | (_app->GetReceiver() == ReceiverModeType::RTTY ? FL_MENU_VALUE : 0));
 }
 
 void MainWindow::SetupSettingsMenu() {
@@ -476,25 +489,29 @@ void MainWindow::SetupStatusbar(){
     _statusbarConfig->box(FL_THIN_DOWN_FRAME);
     _statusbarConfig->color(FL_GRAY0);
 
-    _statusbarMode = new Fl_Output(_statusbarConfig->x() + _statusbarConfig->w(), _statusbar->y(), 100, 20);
+    _statusbarMode = new Fl_Output(_statusbarConfig->x() + _statusbarConfig->w(), _statusbar->y(), 80, 20);
     _statusbarMode->box(FL_THIN_DOWN_FRAME);
     _statusbarMode->color(FL_GRAY0);
 
-    _statusbarHardwareFreq = new Fl_Output(_statusbarMode->x() + _statusbarMode->w(), _statusbar->y(), 100, 20);
+    _statusbarHardwareFreq = new Fl_Output(_statusbarMode->x() + _statusbarMode->w(), _statusbar->y(), 90, 20);
     _statusbarHardwareFreq->box(FL_THIN_DOWN_FRAME);
     _statusbarHardwareFreq->color(FL_GRAY0);
 
-    _statusbarRunningState = new Fl_Output(_statusbarHardwareFreq->x() + _statusbarHardwareFreq->w(), _statusbar->y(), 100, 20);
+    _statusbarRunningState = new Fl_Output(_statusbarHardwareFreq->x() + _statusbarHardwareFreq->w(), _statusbar->y(), 80, 20);
     _statusbarRunningState->box(FL_THIN_DOWN_FRAME);
 
-    _statusbarRecording = new Fl_Output(_statusbarRunningState->x() + _statusbarRunningState->w(), _statusbar->y(), 130, 20);
+    _statusbarRecording = new Fl_Output(_statusbarRunningState->x() + _statusbarRunningState->w(), _statusbar->y(), 120, 20);
     _statusbarRecording->box(FL_THIN_DOWN_FRAME);
     _statusbarRecording->color(FL_GRAY0);
 
-    _statusbarPreamp = new Fl_Output(_statusbarRecording->x() + _statusbarRecording->w(), _statusbar->y(), 110, 20);
+    _statusbarPreamp = new Fl_Output(_statusbarRecording->x() + _statusbarRecording->w(), _statusbar->y(), 100, 20);
     _statusbarPreamp->box(FL_THIN_DOWN_FRAME);
     _statusbarPreamp->color(FL_GRAY0);
 
+    _statusbarRemote = new Fl_Output(_statusbarPreamp->x() + _statusbarPreamp->w(), _statusbar->y(), 70, 20);
+    _statusbarRemote->box(FL_THIN_DOWN_FRAME);
+    _statusbarRemote->color(FL_GRAY0);
+
     _statusbar->end();
     _statusbar->show();
 }
@@ -617,6 +634,11 @@ void MainWindow::SetupDisplays() {
 
     // Analysis window
     _analysis = new Analysis(148, _rfInputWaterfall->y() + _rfInputWaterfall->h() + 10, 560, 140, "Analysis", _app->GetAudioFftSize() / 2, 4, _app);
+
+    // Decoded text, between the displays and the frequency controls
+    strcpy(_decodedTextLabel, "CW");
+    _decodedText = new Fl_Output(90, _analysis->y() + _analysis->h() + 8, 615, 22, _decodedTextLabel);
+    _decodedText->tooltip("Decoded CW (start with '-cwd' and the CW receiver)");
 }
 
 void MainWindow::SetupNavigationMenu() {
@@ -663,6 +685,9 @@ void MainWindow::HandleMenuButton(char* name) {
     else if( strncmp(name, "Receiver/Record AF", 18) == 0 || strncmp(name, "Receiver/Stop recording AF", 26) == 0 ) {
         HandleMenuButtonReceiverDumpAf();
     }
+    else if( strncmp(name, "Receiver/Capture last seconds", 29) == 0 || strncmp(name, "Receiver/Stop capture", 21) == 0 ) {
+        HandleMenuButtonReceiverCapture();
+    }
     else if( strncmp(name, "Receiver/Start", 14) == 0 || strncmp(name, "Receiver/Stop", 13) == 0 ) {
         HandleMenuButtonReceiverStartStop();
     }
@@ -842,6 +867,8 @@ void MainWindow::HandleMenuButtonReceiverMode(char* name, char* value) {
             _app->ChangeReceiver(ReceiverModeType::CW);
         } else if (strcmp(requested, "SSB") == 0) {
             _app->ChangeReceiver(ReceiverModeType::SSB);
+        } else if (strcmp(requested, "RTTY") == 0) {
+            _app->ChangeReceiver(ReceiverModeType::RTTY);
         } else {
             HError("Unknown receiver mode '%s'", requested);
             fl_alert("Unknown receiver mode!!");
@@ -1444,6 +1471,17 @@ void MainWindow::HandleMenuButtonReceiverDumpAf() {
     UpdateState();
 }
 
+void MainWindow::HandleMenuButtonReceiverCapture() {
+
+    // Capture as many seconds after the trigger as there are in the buffer
+    if( _app->IsCapturing() ) {
+        _app->StopCapture();
+    } else {
+        _app->Capture(_app->GetCaptureSeconds());
+    }
+    UpdateState();
+}
+
 void MainWindow::HandleMenuButtonReceiverScreenshot() {
     _rfInputWaterfall->Screenshot();
     _afOutputWaterfall->Screenshot();
@@ -1472,6 +1510,13 @@ void MainWindow::UpdateState() {
         RenameMenuItem("Receiver/Stop recording AF", "Record AF");
     }
 
+    // Capture
+    if( _app->IsCapturing() ) {
+        RenameMenuItem("Receiver/Capture last seconds", "Stop capture");
+    } else {
+        RenameMenuItem("Receiver/Stop capture", "Capture last seconds");
+    }
+
     // Statusbar
     UpdateStatusbar();
 
@@ -1533,6 +1578,9 @@ void MainWindow::UpdateStatusbar() {
             case ReceiverModeType::SSB:
                 _statusbarMode->value("SSB");
                 break;
+            case ReceiverModeType::RTTY:
+                _statusbarMode->value("RTTY");
+                break;
             default:
                 _statusbarMode->value("(none)");
                 break;
@@ -1580,3 +1628,62 @@ void MainWindow::UpdateStatusbar() {
         _statusbarPreamp->value("");
     }
 }
+
+void MainWindow::UpdateRemoteStatus() {
+
+    if( _statusbarRemote == nullptr ) {
+        return;
+    }
+
+    // Show the delay of the received stream, or the throughput when there are no timestamps.
+    // All counters are available in the tooltip
+    std::vector<BoomaRemoteStatistics> streams = _app->GetRemoteStatistics();
+    if( streams.empty() ) {
+        _statusbarRemote->value("");
+        _statusbarRemote->tooltip(nullptr);
+        return;
+    }
+    char line[200];
+    BoomaRemoteStatistics first = streams.at(0);
+    if( first.HasTimestamps ) {
+        snprintf(line, sizeof(line), "%.0f ms", first.Latency);
+    } else {
+        snprintf(line, sizeof(line), "%.0f kB/s", first.BytesPerSecond / 1024);
+    }
+    _statusbarRemote->value(line);
+
+    _statusbarRemoteTooltip = "";
+    for( std::vector<BoomaRemoteStatistics>::iterator it = streams.begin(); it != streams.end(); it++ ) {
+        snprintf(line, sizeof(line), "%s: %.1f kB/s, queued %lu, dropped %lu", (*it).Name.c_str(), (*it).BytesPerSecond / 1024, (*it).QueueDepth, (*it).Dropped);
+        _statusbarRemoteTooltip += line;
+        if( (*it).HasTimestamps ) {
+            snprintf(line, sizeof(line), ", latency %.1f ms (max %.1f, jitter %.1f), drift %.1f ppm", (*it).Latency, (*it).MaxLatency, (*it).Jitter, (*it).ClockDrift);
+            _statusbarRemoteTooltip += line;
+        }
+        _statusbarRemoteTooltip += "\n";
+    }
+    _statusbarRemote->tooltip(_statusbarRemoteTooltip.c_str());
+}
+
+void MainWindow::UpdateDecodedText() {
+
+    if( _decodedText == nullptr ) {
+        return;
+    }
+
+    // Show the most recent text that fits the field, with the estimated speed in the label
+    if( !_app->HasDecoder() ) {
+        _decodedTextLine = "";
+        _decodedText->value("");
+        strcpy(_decodedTextLabel, "CW");
+        _decodedText->label(_decodedTextLabel);
+        return;
+    }
+    _decodedTextLine += _app->GetDecodedText();
+    if( _decodedTextLine.size() > 90 ) {
+        _decodedTextLine.erase(0, _decodedTextLine.size() - 90);
+    }
+    _decodedText->value(_decodedTextLine.c_str());
+    snprintf(_decodedTextLabel, sizeof(_decodedTextLabel), "%s %d wpm", _app->GetReceiver() == ReceiverModeType::RTTY ? "RTTY" : "CW", _app->GetDecoderWpm());
+    _decodedText->label(_decodedTextLabel);
+}
@@ -2,12 +2,16 @@
 #include <stdlib.h>
 #include <iostream>
 #include <signal.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "main.h"
 #include "booma.h"
 #include "boomaapplication.h"
 
 BoomaApplication* app;
+std::atomic<bool> isDone(false);
 
 void SetupSignalHandling()
 {
@@ -19,6 +23,14 @@ void SetupSignalHandling()
     sigaction (SIGTERM, &action, NULL);
 }
 
+void PrintRemoteStatistics()
+{
+    std::vector<BoomaRemoteStatistics> streams = app->GetRemoteStatistics();
+    for( std::vector<BoomaRemoteStatistics>::iterator it = streams.begin(); it != streams.end(); it++ ) {
+        printf("%s: %.1f kB/s, queued %lu, dropped %lu\n", (*it).Name.c_str(), (*it).BytesPerSecond / 1024, (*it).QueueDepth, (*it).Dropped);
+    }
+}
+
 int main(int argc, char** argv) 
 {
 	// Initialize Booma
@@ -33,7 +45,28 @@ int main(int argc, char** argv)
         // Run initial receiver (if any configured)
         app->Run();
         std::cout << "booma-remote " << ss.str() << " running. Press ctrl+c to quit" << std::endl;
+
+        // Print remote stream counters at a fixed interval ('-rstat seconds')
+        std::thread* statisticsThread = nullptr;
+        if( app->GetRemoteStatisticsInterval() > 0 ) {
+            statisticsThread = new std::thread([]() {
+                int seconds = 0;
+                while( !isDone ) {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                    if( ++seconds >= app->GetRemoteStatisticsInterval() ) {
+                        PrintRemoteStatistics();
+                        seconds = 0;
+                    }
+                }
+            });
+        }
+
         app->Wait();
+        isDone = true;
+        if( statisticsThread != nullptr ) {
+            statisticsThread->join();
+            delete statisticsThread;
+        }
         std::cout << std::endl << "booma-remote finished" << std::endl;
 
         // Cleanup
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include "boomabiquaddesigner.h"
+#include "test.h"
+
+// Poles (a1, a2) of the coefficient tables the CW receiver used before the designer, for a 6 kHz IF at 48 kHz
+struct Table {
+    int Width;
+    double Poles[4][2];
+};
+
+static const Table Tables[] = {
+    { 50, { { 1.408067592516551, -0.9938554560160351 }, { 1.4116734879341142, -0.9938710552646586 },
+            { 1.408045459371766, -0.9974456925740307 }, { 1.4167508604593735, -0.9974613476810194 } } },
+    { 100, { { 1.4026434633408733, -0.9883093940592698 }, { 1.4095146965221208, -0.9883657437885459 },
+             { 1.4025641509285973, -0.9951244773940543 }, { 1.4191527482568658, -0.9951812092261056 } } },
+    { 200, { { 1.3903155004925956, -0.9759828267704111 }, { 1.4044836752325582, -0.9762194821504804 },
+             { 1.3899786395895477, -0.9899122406330527 }, { 1.4241834185016982, -0.9901521572645293 } } },
+    { 500, { { 1.3578013970831393, -0.9429178695624337 }, { 1.3918033585781613, -0.9442389046006642 },
+             { 1.3559075775374545, -0.9755717421203991 }, { 1.437988425774804, -0.9769347083141211 } } },
+    { 1000, { { 1.2999716556158074, -0.8820266316104814 }, { 1.3714944005456748, -0.8875762227807565 },
+              { 1.2920291704550972, -0.9478234710900391 }, { 1.46455173397263, -0.9537131436046499 } } },
+    { 3000, { { 1.1052801524695883, -0.670102919351549 }, { 1.3208341719229677, -0.712714773030205 },
+              { 1.0466041855109196, -0.8394505074497361 }, { 1.5573059390887027, -0.8869145132418825 } } }
+};
+
+// Gain of one section at the given frequency
+static double SectionGain(const float* section, double frequency, int rate) {
+    std::complex<double> z = std::polar(1.0, -2 * M_PI * frequency / rate);
+    std::complex<double> b = (double) section[0] + ((double) section[1] * z) + ((double) section[2] * z * z);
+    std::complex<double> a = 1.0 - ((double) section[3] * z) - ((double) section[4] * z * z);
+    return std::abs(b / a);
+}
+
+// Gain of the complete filter at the given frequency
+static double Gain(const float* coefficients, double frequency, int rate) {
+    double gain = 1;
+    for( int i = 0; i < BoomaBiQuadDesigner::Sections; i++ ) {
+        gain *= SectionGain(&coefficients[i * 5], frequency, rate);
+    }
+    return gain;
+}
+
+// Frequency and bandwidth of the pole pair of a section, in Hz
+static void GetPole(double a1, double a2, int rate, double* frequency, double* bandwidth) {
+    double radius = sqrt(-a2);
+    *frequency = acos(a1 / (2 * radius)) * rate / (2 * M_PI);
+    *bandwidth = -log(radius) * rate / M_PI;
+}
+
+// Geometric center of the prewarped passband, where the designer scales the sections
+static double GetCenter(int center, int width, int rate) {
+    double low = tan(M_PI * (center - (width / 2.0)) / rate);
+    double high = tan(M_PI * (center + (width / 2.0)) / rate);
+    return atan(sqrt(low * high)) * rate / M_PI;
+}
+
+static void TestTables() {
+
+    // Every pole of the old tables must be found in the design. The 200 and 3000 Hz tables
+    // match exactly, the others were designed with slightly different band edges
+    for( const Table& table : Tables ) {
+        float* coefficients = BoomaBiQuadDesigner::GetBandpass(6000, table.Width, 48000);
+        double tolerance = table.Width * 0.05;
+        for( int i = 0; i < BoomaBiQuadDesigner::Sections; i++ ) {
+            double frequency;
+            double bandwidth;
+            GetPole(table.Poles[i][0], table.Poles[i][1], 48000, &frequency, &bandwidth);
+            bool isFound = false;
+            for( int j = 0; j < BoomaBiQuadDesigner::Sections; j++ ) {
+                double designedFrequency;
+                double designedBandwidth;
+                GetPole(coefficients[(j * 5) + 3], coefficients[(j * 5) + 4], 48000, &designedFrequency, &designedBandwidth);
+                isFound = isFound || (fabs(designedFrequency - frequency) < tolerance && fabs(designedBandwidth - bandwidth) < tolerance);
+            }
+            CHECK(isFound);
+        }
+    }
+}
+
+static void TestResponse() {
+    int rates[] = { 8000, 16000, 48000 };
+    int widths[] = { 50, 500, 1500 };
+    for( int rate : rates ) {
+        for( int width : widths ) {
+            int center = rate / 8;
+            float* coefficients = BoomaBiQuadDesigner::GetBandpass(center, width, rate);
+
+            // Each section has unity gain at the center
+            for( int i = 0; i < BoomaBiQuadDesigner::Sections; i++ ) {
+                CHECK_NEAR(SectionGain(&coefficients[i * 5], GetCenter(center, width, rate), rate), 1.0, 1e-3);
+            }
+
+            // The band edges are 3 dB down, everything far from the passband is gone
+            CHECK_NEAR(Gain(coefficients, center - (width / 2.0), rate), M_SQRT1_2, 0.01);
+            CHECK_NEAR(Gain(coefficients, center + (width / 2.0), rate), M_SQRT1_2, 0.01);
+            CHECK(Gain(coefficients, 0, rate) < 1e-3);
+            CHECK(Gain(coefficients, rate / 2.0, rate) < 1e-3);
+        }
+    }
+
+    // A passband that does not fit is narrowed, and the filter stays stable
+    float* coefficients = BoomaBiQuadDesigner::GetBandpass(1000, 3000, 8000);
+    for( int i = 0; i < BoomaBiQuadDesigner::Sections; i++ ) {
+        CHECK(-coefficients[(i * 5) + 4] < 1);
+    }
+    CHECK(Gain(coefficients, 0, 8000) < 1e-3);
+
+    // The design is cached
+    CHECK(BoomaBiQuadDesigner::GetBandpass(6000, 500, 48000) == BoomaBiQuadDesigner::GetBandpass(6000, 500, 48000));
+}
+
+int main(int argc, char** argv) {
+    TestTables();
+    TestResponse();
+    return TEST_RESULT();
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "boomacwdecoder.h"
+#include "booma.h"
+#include "test.h"
+
+#define RATE 8000
+
+// Append a keyed 700 Hz tone with the text, sent at the given speed, followed by a second of silence
+static void Key(std::vector<int16_t>* samples, std::string text, int wpm, int amplitude, int noise) {
+    static const std::map<char, std::string> codes = {
+        {'A', ".-"}, {'C', "-.-."}, {'D', "-.."}, {'E', "."}, {'I', ".."}, {'K', "-.-"}, {'P', ".--."},
+        {'Q', "--.-"}, {'R', ".-."}, {'S', "..."}, {'T', "-"}, {'5', "....."}, {'0', "-----"},
+        {'?', "..--.."}, {'/', "-..-."}
+    };
+
+    // Build the key as a sequence of units, one dot long each
+    std::string units;
+    for( char c : text ) {
+        if( c == ' ' ) {
+            units += "    ";
+            continue;
+        }
+        for( char element : codes.at(c) ) {
+            units += element == '-' ? "###_" : "#_";
+        }
+        units += "__";
+    }
+    units += std::string(1000 * wpm / 1200, '_');
+
+    int dot = (RATE * 1200) / (wpm * 1000);
+    for( char unit : units ) {
+        for( int i = 0; i < dot; i++ ) {
+            double tone = unit == '#' ? amplitude * sin(2 * M_PI * 700 * samples->size() / RATE) : 0;
+            samples->push_back((int16_t) (tone + (rand() % (2 * noise + 1)) - noise));
+        }
+    }
+}
+
+// Decode the samples in blocks of the given size and return the text
+static std::string Decode(BoomaCwDecoder* decoder, std::string* text, std::vector<int16_t>& samples, int blocksize) {
+    text->clear();
+    for( size_t i = 0; i < samples.size(); i += blocksize ) {
+        decoder->Write(&samples[i], std::min((size_t) blocksize, samples.size() - i));
+    }
+    return *text;
+}
+
+static void TestSpeeds() {
+    int speeds[] = { 12, 20, 35 };
+    for( int wpm : speeds ) {
+        std::string text;
+        BoomaCwDecoder decoder("cw", RATE, [&text](std::string decoded) { text += decoded; });
+
+        // Noise, then a call repeated. The first character may be lost while the decoder finds the speed
+        std::vector<int16_t> samples(RATE / 2);
+        for( size_t i = 0; i < samples.size(); i++ ) {
+            samples[i] = (rand() % 401) - 200;
+        }
+        Key(&samples, "CQ CQ DE PA5KT K", wpm, 8000, 200);
+        Key(&samples, "CQ CQ DE PA5KT K", wpm, 8000, 200);
+
+        Decode(&decoder, &text, samples, 1024);
+        CHECK(text.find(" CQ DE PA5KT K CQ CQ DE PA5KT K ") != std::string::npos);
+        CHECK(abs(decoder.GetWpm() - wpm) <= 2);
+        CHECK(decoder.GetSnr() > 20);
+        CHECK(decoder.GetIdleMilliseconds() >= 900);
+    }
+}
+
+static void TestSpeedChange() {
+
+    // The speed jumps from 15 to 30 wpm between two words
+    std::string text;
+    BoomaCwDecoder decoder("cw", RATE, [&text](std::string decoded) { text += decoded; });
+    std::vector<int16_t> samples;
+    Key(&samples, "TEST TEST", 15, 8000, 100);
+    Key(&samples, "SK PARIS", 30, 8000, 100);
+    Decode(&decoder, &text, samples, 333);
+    CHECK(text.find("PARIS ") != std::string::npos);
+    CHECK(abs(decoder.GetWpm() - 30) <= 2);
+}
+
+static void TestNoise() {
+
+    // Noise alone gives no text
+    std::string text;
+    BoomaCwDecoder decoder("cw", RATE, [&text](std::string decoded) { text += decoded; });
+    std::vector<int16_t> samples(RATE * 5);
+    for( size_t i = 0; i < samples.size(); i++ ) {
+        samples[i] = (rand() % 2001) - 1000;
+    }
+    CHECK(Decode(&decoder, &text, samples, 1024).empty());
+}
+
+static void TestTicks() {
+
+    // Levels given directly, 20 wpm is 30 ticks per dot. Unknown sequences are shown as '*'
+    std::string text;
+    BoomaCwDecoder decoder("cw", RATE, [&text](std::string decoded) { text += decoded; });
+    decoder.Reset(10);
+    std::string units = "#_#_#_#_#_#_#_#___#_###_______";
+    for( char unit : units ) {
+        for( int i = 0; i < 30; i++ ) {
+            decoder.Tick(unit == '#' ? 1000 : 10);
+        }
+    }
+    CHECK(text == "*A ");
+}
+
+int main(int argc, char** argv) {
+    srand(1);
+    TestSpeeds();
+    TestSpeedChange();
+    TestNoise();
+    TestTicks();
+    return TEST_RESULT();
+}
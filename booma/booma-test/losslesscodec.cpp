@@ -0,0 +1,136 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "boomalosslesscodec.h"
+#include "boomainputexception.h"
+#include "test.h"
+
+// Round trip a block of samples through a frame held in memory
+static bool RoundTrip(const std::vector<int16_t>& samples, int channels, size_t* frameSize) {
+    std::vector<uint8_t> frame;
+    BoomaLosslessCodec::Encode(samples.data(), samples.size(), channels, &frame);
+    *frameSize = frame.size();
+
+    std::vector<int16_t> decoded;
+    if( !BoomaLosslessCodec::DecodeFrame(frame.data(), frame.size(), channels, &decoded) ) {
+        return false;
+    }
+    return decoded == samples;
+}
+
+static void TestSignals() {
+    size_t size;
+
+    // Silence, a slow sine and full scale noise, mono and IQ
+    for( int channels = 1; channels <= 2; channels++ ) {
+        std::vector<int16_t> silence(4096, 0);
+        CHECK(RoundTrip(silence, channels, &size));
+        CHECK(size < silence.size() / 4);
+
+        std::vector<int16_t> sine(4096);
+        for( size_t i = 0; i < sine.size(); i++ ) {
+            sine[i] = (int16_t) (8000 * sin((2 * M_PI * 440 * (i / channels)) / 48000) + ((i % channels) * 100));
+        }
+        CHECK(RoundTrip(sine, channels, &size));
+        CHECK(size < sine.size() * sizeof(int16_t));
+
+        // Noise does not compress, the channels are stored raw
+        std::vector<int16_t> noise(4096);
+        srand(1);
+        for( size_t i = 0; i < noise.size(); i++ ) {
+            noise[i] = (int16_t) (rand() & 0xffff);
+        }
+        CHECK(RoundTrip(noise, channels, &size));
+        CHECK(size <= BoomaLosslessCodec::FrameHeaderSize + BoomaLosslessCodec::GetMaxPayloadSize(noise.size(), channels));
+
+        // Extremes, steps between full scale values gives the largest residuals
+        std::vector<int16_t> extremes(4096);
+        for( size_t i = 0; i < extremes.size(); i++ ) {
+            extremes[i] = (i / channels) % 2 == 0 ? 32767 : -32768;
+        }
+        CHECK(RoundTrip(extremes, channels, &size));
+    }
+
+    // Frames shorter than the predictor
+    std::vector<int16_t> tiny = { 1, -1 };
+    CHECK(RoundTrip(tiny, 1, &size));
+    CHECK(RoundTrip(tiny, 2, &size));
+}
+
+static void TestCorruptFrames() {
+    std::vector<int16_t> samples(1024);
+    for( size_t i = 0; i < samples.size(); i++ ) {
+        samples[i] = (int16_t) (i * 13);
+    }
+    std::vector<uint8_t> frame;
+    BoomaLosslessCodec::Encode(samples.data(), samples.size(), 1, &frame);
+
+    // Truncated frame
+    std::vector<int16_t> decoded;
+    CHECK(!BoomaLosslessCodec::DecodeFrame(frame.data(), frame.size() - 1, 1, &decoded));
+
+    // Payload size larger than any frame with this number of samples
+    std::vector<uint8_t> large(frame);
+    large[9] = 0x7f;
+    CHECK(!BoomaLosslessCodec::DecodeFrame(large.data(), large.size(), 1, &decoded));
+
+    // The same frame in a file is rejected before its payload is allocated
+    FILE* file = tmpfile();
+    CHECK(file != nullptr);
+    if( file == nullptr ) {
+        return;
+    }
+    fwrite(large.data(), 1, large.size(), file);
+    rewind(file);
+    bool isThrown = false;
+    try {
+        BoomaLosslessCodec::Decode(file, 1, &decoded);
+    } catch( BoomaInputException* e ) {
+        isThrown = true;
+        delete e;
+    }
+    CHECK(isThrown);
+    fclose(file);
+}
+
+static void TestFile() {
+
+    // Header and frames written and read back
+    FILE* file = tmpfile();
+    CHECK(file != nullptr);
+    if( file == nullptr ) {
+        return;
+    }
+    CHECK(BoomaLosslessCodec::WriteFileHeader(file, 2, 48000));
+    std::vector<int16_t> written;
+    for( int block = 0; block < 10; block++ ) {
+        std::vector<int16_t> samples(4096);
+        for( size_t i = 0; i < samples.size(); i++ ) {
+            samples[i] = (int16_t) (1000 * cos((block * 4096 + i) * 0.01));
+        }
+        std::vector<uint8_t> frame;
+        BoomaLosslessCodec::Encode(samples.data(), samples.size(), 2, &frame);
+        fwrite(frame.data(), 1, frame.size(), file);
+        written.insert(written.end(), samples.begin(), samples.end());
+    }
+    rewind(file);
+
+    int channels;
+    int samplerate;
+    CHECK(BoomaLosslessCodec::ReadFileHeader(file, &channels, &samplerate));
+    CHECK(channels == 2);
+    CHECK(samplerate == 48000);
+    std::vector<int16_t> read;
+    while( BoomaLosslessCodec::Decode(file, channels, &read) ) {}
+    CHECK(read == written);
+    fclose(file);
+}
+
+int main(int argc, char** argv) {
+    TestSignals();
+    TestCorruptFrames();
+    TestFile();
+    return TEST_RESULT();
+}
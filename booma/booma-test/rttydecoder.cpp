@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "boomarttydecoder.h"
+#include "booma.h"
+#include "test.h"
+
+#define RATE 16000
+
+// Continuous phase FSK signal
+class Sender {
+
+    private:
+
+        std::vector<int16_t>* _samples;
+        int _shift;
+        double _baudrate;
+        double _phase;
+        double _bits;
+        bool _isFigures;
+
+    public:
+
+        // Amplitude of each tone and of the noise added to the signal
+        int Mark;
+        int Space;
+        int Noise;
+
+        Sender(std::vector<int16_t>* samples, int shift, double baudrate):
+            _samples(samples),
+            _shift(shift),
+            _baudrate(baudrate),
+            _phase(0),
+            _bits(0),
+            _isFigures(false),
+            Mark(8000),
+            Space(8000),
+            Noise(500) {}
+
+        // Send a bit for the given number of bit lengths
+        void Bit(bool isMark, double length) {
+            double frequency = RTTY_TONE_CENTER + (isMark ? _shift / 2.0 : -_shift / 2.0);
+            _bits += length;
+            while( _samples->size() < _bits * RATE / _baudrate ) {
+                _phase += 2 * M_PI * frequency / RATE;
+                int noise = (rand() % (2 * Noise + 1)) - Noise;
+                _samples->push_back((int16_t) (((isMark ? Mark : Space) * sin(_phase)) + noise));
+            }
+        }
+
+        // Send a 5 bit code with start and stop bits
+        void Code(int code) {
+            Bit(false, 1);
+            for( int i = 0; i < 5; i++ ) {
+                Bit(((code >> i) & 1) == 1, 1);
+            }
+            Bit(true, 1.5);
+        }
+
+        // Send text, shifting between letters and figures as needed
+        void Text(std::string text) {
+            static const std::string letters = std::string("\0E\nA SIU\rDRJNFCKTZLWHYPQOBG\0MXV\0", 32);
+            static const std::string figures = std::string("\0003\n- \00087\r$4',!:(5\")2#6019?&\0./;\0", 32);
+            for( char c : text ) {
+                size_t letter = letters.find(c);
+                size_t figure = figures.find(c);
+                if( letter != std::string::npos && (letter == 4 || !_isFigures || figure == std::string::npos) ) {
+                    if( _isFigures && letter != 4 ) {
+                        Code(0x1F);
+                        _isFigures = false;
+                    }
+                    Code(letter);
+
+                    // Unshift on space, as the decoder does
+                    _isFigures = _isFigures && letter != 4;
+                } else {
+                    if( !_isFigures ) {
+                        Code(0x1B);
+                        _isFigures = true;
+                    }
+                    Code(figure);
+                }
+            }
+        }
+};
+
+static std::string Decode(BoomaRttyDecoder* decoder, std::string* text, std::vector<int16_t>& samples) {
+    text->clear();
+    for( size_t i = 0; i < samples.size(); i += 1000 ) {
+        decoder->Write(&samples[i], std::min((size_t) 1000, samples.size() - i));
+    }
+    return *text;
+}
+
+static void TestSettings() {
+    struct {
+        int Shift;
+        int Baudrate;
+        bool IsReversed;
+    } settings[] = { { 170, 4545, false }, { 170, 5000, false }, { 450, 7500, false }, { 170, 4545, true } };
+
+    for( auto setting : settings ) {
+        std::string text;
+        BoomaRttyDecoder decoder("rtty", RATE, [&text](std::string decoded) { text += decoded; });
+        decoder.SetReceiverOption("Shift", setting.Shift);
+        decoder.SetReceiverOption("Baudrate", setting.Baudrate);
+        decoder.SetReceiverOption("Reverse", setting.IsReversed ? 1 : 0);
+
+        // Idle at mark first. A reversed signal swaps the tones
+        std::vector<int16_t> samples;
+        Sender sender(&samples, setting.IsReversed ? -setting.Shift : setting.Shift, setting.Baudrate / 100.0);
+        sender.Bit(true, 10);
+        sender.Text("RYRY CQ DE PA5KT 599 73/\r\nK ");
+        sender.Bit(true, 10);
+
+        CHECK(Decode(&decoder, &text, samples) == "RYRY CQ DE PA5KT 599 73/ K ");
+    }
+}
+
+static void TestFading() {
+
+    // One of the tones faded to a fifth, the threshold follows the tone levels
+    int fades[][2] = { { 8000, 1600 }, { 1600, 8000 } };
+    for( auto fade : fades ) {
+        std::string text;
+        BoomaRttyDecoder decoder("rtty", RATE, [&text](std::string decoded) { text += decoded; });
+        std::vector<int16_t> samples;
+        Sender sender(&samples, 170, 45.45);
+        sender.Mark = fade[0];
+        sender.Space = fade[1];
+        sender.Noise = 200;
+        sender.Bit(true, 10);
+        sender.Text("THE QUICK BROWN FOX ");
+        sender.Bit(true, 10);
+
+        CHECK(Decode(&decoder, &text, samples) == "THE QUICK BROWN FOX ");
+    }
+}
+
+static void TestNoise() {
+
+    // The squelch drops nearly all characters framed from noise, 10 seconds could frame about 60
+    std::string text;
+    BoomaRttyDecoder decoder("rtty", RATE, [&text](std::string decoded) { text += decoded; });
+    std::vector<int16_t> samples(RATE * 10);
+    for( size_t i = 0; i < samples.size(); i++ ) {
+        samples[i] = (rand() % 8001) - 4000;
+    }
+    CHECK(Decode(&decoder, &text, samples).size() < 10);
+}
+
+int main(int argc, char** argv) {
+    srand(1);
+    TestSettings();
+    TestFading();
+    TestNoise();
+    return TEST_RESULT();
+}
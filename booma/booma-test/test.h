@@ -0,0 +1,31 @@
+#ifndef __BOOMATEST_H
+#define __BOOMATEST_H
+
+#include <iostream>
+
+/**
+ * Minimal checks for the unit tests. A failed check is reported with its location, and the
+ * test exits with a non-zero status from TEST_RESULT.
+ */
+static int _failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if( !(condition) ) { \
+            std::cout << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+            _failures++; \
+        } \
+    } while( false )
+
+#define CHECK_NEAR(value, expected, tolerance) \
+    do { \
+        if( !((value) >= (expected) - (tolerance) && (value) <= (expected) + (tolerance)) ) { \
+            std::cout << __FILE__ << ":" << __LINE__ << ": check failed: " << #value << " = " << (value) << ", expected " << (expected) << " +/- " << (tolerance) << std::endl; \
+            _failures++; \
+        } \
+    } while( false )
+
+#define TEST_RESULT() \
+    (std::cout << (_failures == 0 ? "ok" : "FAILED") << std::endl, _failures == 0 ? 0 : 1)
+
+#endif
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "boomatiming.h"
+#include "test.h"
+
+static void TestHistogram() {
+    BoomaTimingHistogram histogram;
+    CHECK(histogram.GetCount() == 0);
+    CHECK(histogram.GetPercentile(50) == 0);
+    CHECK(histogram.GetMin() == 0);
+
+    // 1 .. 100000 ns, percentiles are within a sub-bucket (1/16) below the exact value
+    for( int i = 1; i <= 100000; i++ ) {
+        histogram.Add(i);
+    }
+    CHECK(histogram.GetCount() == 100000);
+    CHECK(histogram.GetMin() == 1);
+    CHECK(histogram.GetMax() == 100000);
+    double percentiles[] = { 1, 50, 90, 99, 99.9, 100 };
+    for( double percentile : percentiles ) {
+        double exact = percentile * 1000;
+        double value = histogram.GetPercentile(percentile);
+        CHECK(value <= exact && value > exact * (1 - (1.0 / 16)));
+    }
+
+    // Small values are exact, large values are clamped to the exact min and max
+    histogram.Reset();
+    CHECK(histogram.GetCount() == 0);
+    CHECK(histogram.GetMax() == 0);
+    histogram.Add(7);
+    histogram.Add(7);
+    histogram.Add(9);
+    CHECK(histogram.GetPercentile(50) == 7);
+    CHECK(histogram.GetPercentile(100) == 9);
+    histogram.Reset();
+    histogram.Add(1e12);
+    histogram.Add(1e15);
+    CHECK(histogram.GetMin() == 1e12);
+    CHECK(histogram.GetPercentile(1) == 1e12);
+    CHECK(histogram.GetPercentile(100) <= 1e15 && histogram.GetPercentile(100) > 1e15 * (1 - (1.0 / 16)));
+}
+
+static void Sleep(int milliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+static void TestNesting() {
+
+    // The outer stage calls the inner stage, each stage reports its own time only
+    BoomaTimingCounter outer("outer");
+    BoomaTimingCounter inner("inner");
+    for( int i = 0; i < 5; i++ ) {
+        outer.Begin();
+        Sleep(10);
+        inner.Begin();
+        Sleep(30);
+        inner.End(100);
+        outer.End(200);
+    }
+
+    BoomaStageStatistics statistics = outer.GetStatistics();
+    CHECK(statistics.Name == "outer");
+    CHECK(statistics.Calls == 5);
+    CHECK(statistics.Samples == 1000);
+    CHECK(statistics.Min >= 10e6 && statistics.Max < 25e6);
+    CHECK(statistics.Nanoseconds >= 50e6 && statistics.Nanoseconds < 125e6);
+    CHECK_NEAR(statistics.NanosecondsPerSample, statistics.Nanoseconds / 1000, 1e-6);
+
+    statistics = inner.GetStatistics();
+    CHECK(statistics.Calls == 5);
+    CHECK(statistics.Samples == 500);
+    CHECK(statistics.Min >= 30e6 && statistics.Max < 45e6);
+    CHECK(statistics.P50 >= statistics.Min && statistics.P50 <= statistics.P99 && statistics.P99 <= statistics.Max);
+
+    // Timing on another thread does not leak into this thread
+    outer.Reset();
+    outer.Begin();
+    std::thread thread([&inner]() {
+        inner.Begin();
+        Sleep(30);
+        inner.End(1);
+    });
+    thread.join();
+    outer.End(1);
+    CHECK(outer.GetStatistics().Min >= 30e6);
+
+    outer.Reset();
+    statistics = outer.GetStatistics();
+    CHECK(statistics.Calls == 0 && statistics.Samples == 0 && statistics.Nanoseconds == 0);
+}
+
+// Reader giving a block after a short sleep
+class SlowReader : public HReader<int16_t> {
+
+    public:
+
+        SlowReader(): HReader<int16_t>("slow") {}
+
+        int Read(int16_t* dest, size_t blocksize) {
+            Sleep(5);
+            return blocksize;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+};
+
+static void TestCollection() {
+    SlowReader reader;
+
+    // Disabled probes are not added to the chain
+    BoomaTimingCollection disabled(false);
+    CHECK(disabled.Probe("reader", &reader) == &reader);
+
+    BoomaTimingCollection collection(true);
+    HReader<int16_t>* probe = collection.Probe("reader", &reader);
+    CHECK(probe != &reader);
+    int16_t block[256];
+    for( int i = 0; i < 3; i++ ) {
+        CHECK(probe->Read(block, 256) == 256);
+    }
+    std::vector<BoomaStageStatistics> statistics;
+    collection.GetStatistics(&statistics);
+    CHECK(statistics.size() == 1 && statistics[0].Name == "reader" && statistics[0].Calls == 3 && statistics[0].Samples == 768);
+    CHECK(statistics.size() == 1 && statistics[0].Min >= 5e6);
+
+    collection.Reset();
+    statistics.clear();
+    collection.GetStatistics(&statistics);
+    CHECK(statistics.size() == 1 && statistics[0].Calls == 0);
+}
+
+int main(int argc, char** argv) {
+    TestHistogram();
+    TestNesting();
+    TestCollection();
+    return TEST_RESULT();
+}
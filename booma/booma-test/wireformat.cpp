@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "boomawireformat.h"
+#include "boomawireencoder.h"
+#include "boomawiredecoder.h"
+#include "boomainputexception.h"
+#include "test.h"
+
+static std::vector<int16_t> Sine(int length, int channels, int amplitude) {
+    std::vector<int16_t> samples(length);
+    for( int i = 0; i < length; i++ ) {
+        samples[i] = (int16_t) (amplitude * sin((2 * M_PI * 1000 * (i / channels)) / 48000 + (i % channels)));
+    }
+    return samples;
+}
+
+// Largest difference between two equally long vectors
+static int MaxError(const std::vector<int16_t>& a, const std::vector<int16_t>& b) {
+    int error = 0;
+    for( size_t i = 0; i < a.size(); i++ ) {
+        error = std::max(error, abs(a[i] - b[i]));
+    }
+    return error;
+}
+
+// Encode one frame and decode it, returns the largest error or -1 if the frame did not decode
+static int RoundTrip(const std::vector<int16_t>& samples, int channels, WireFormatType format) {
+    std::vector<uint8_t> frame;
+    BoomaWireFormat::Encode(samples.data(), samples.size(), channels, format, 42, 1234567890123ULL, &frame);
+    if( !BoomaWireFormat::IsHeader(frame.data(), frame.size()) ) {
+        return -1;
+    }
+
+    size_t used;
+    WireFormatType decodedFormat;
+    uint32_t sequence;
+    uint64_t timestamp;
+    std::vector<int16_t> decoded;
+    if( BoomaWireFormat::Decode(frame.data(), frame.size(), &used, &decodedFormat, &sequence, &timestamp, &decoded) != BoomaWireFormat::DECODED
+            || used != frame.size() || decodedFormat != format || sequence != 42 || timestamp != 1234567890123ULL
+            || decoded.size() != samples.size() ) {
+        return -1;
+    }
+    return MaxError(samples, decoded);
+}
+
+static void TestFormats() {
+    for( int channels = 1; channels <= 2; channels++ ) {
+
+        // Lossless formats
+        std::vector<int16_t> loud = Sine(4096, channels, 20000);
+        CHECK(RoundTrip(loud, channels, RAW_WIRE) == 0);
+        CHECK(RoundTrip(loud, channels, BLC_WIRE) == 0);
+
+        // Reduced width, the error is at most half of the truncated range (shift 4 and 8)
+        int error = RoundTrip(loud, channels, PACK12_WIRE);
+        CHECK(error >= 0 && error <= 8);
+        error = RoundTrip(loud, channels, BLC12_WIRE);
+        CHECK(error >= 0 && error <= 8);
+        error = RoundTrip(loud, channels, PACK8_WIRE);
+        CHECK(error >= 0 && error <= 128);
+        error = RoundTrip(loud, channels, BLC8_WIRE);
+        CHECK(error >= 0 && error <= 128);
+
+        // Quiet signals keep their full resolution
+        std::vector<int16_t> quiet = Sine(4096, channels, 1000);
+        CHECK(RoundTrip(quiet, channels, PACK12_WIRE) == 0);
+        CHECK(RoundTrip(quiet, channels, BLC12_WIRE) == 0);
+    }
+
+    // Odd number of samples in the 12 bit packing
+    std::vector<int16_t> odd = Sine(1023, 1, 1000);
+    CHECK(RoundTrip(odd, 1, PACK12_WIRE) == 0);
+}
+
+static void TestStream() {
+
+    // Three frames, with garbage in front and split at every possible position
+    std::vector<int16_t> samples = Sine(512, 2, 5000);
+    std::vector<uint8_t> stream = { 1, 2, 3 };
+    for( uint32_t sequence = 0; sequence < 3; sequence++ ) {
+        BoomaWireFormat::Encode(samples.data(), samples.size(), 2, BLC_WIRE, sequence, 0, &stream);
+    }
+    for( size_t split = 0; split <= stream.size(); split += 97 ) {
+        std::vector<uint8_t> received(stream.begin(), stream.begin() + split);
+        std::vector<int16_t> decoded;
+        int frames = 0;
+        size_t next = split;
+        for( ;; ) {
+            size_t used;
+            WireFormatType format;
+            uint32_t sequence;
+            uint64_t timestamp;
+            BoomaWireFormat::Result result = BoomaWireFormat::Decode(received.data(), received.size(), &used, &format, &sequence, &timestamp, &decoded);
+            received.erase(received.begin(), received.begin() + used);
+            if( result == BoomaWireFormat::DECODED ) {
+                CHECK(sequence == (uint32_t) frames);
+                frames++;
+                continue;
+            }
+            if( next == stream.size() ) {
+                break;
+            }
+            received.insert(received.end(), stream.begin() + next, stream.end());
+            next = stream.size();
+        }
+        CHECK(frames == 3);
+        CHECK(decoded.size() == samples.size() * 3);
+    }
+
+    // A payload that does not match the sample count is reported as corrupt
+    std::vector<uint8_t> frame;
+    BoomaWireFormat::Encode(samples.data(), samples.size(), 2, PACK8_WIRE, 0, 0, &frame);
+    frame[12]++;
+    frame.push_back(0);
+    size_t used;
+    WireFormatType format;
+    uint32_t sequence;
+    uint64_t timestamp;
+    std::vector<int16_t> decoded;
+    CHECK(BoomaWireFormat::Decode(frame.data(), frame.size(), &used, &format, &sequence, &timestamp, &decoded) == BoomaWireFormat::CORRUPT);
+    CHECK(decoded.empty());
+}
+
+// Reader giving numbered blocks
+class Counter : public HReader<int16_t> {
+
+    public:
+
+        int Blocks;
+
+        Counter(): HReader<int16_t>("counter"), Blocks(0) {}
+
+        int Read(int16_t* dest, size_t blocksize) {
+            for( size_t i = 0; i < blocksize; i++ ) {
+                dest[i] = (int16_t) ((Blocks * blocksize) + i);
+            }
+            Blocks++;
+            return blocksize;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+};
+
+// Writer consumer the decoder attaches to
+class Source : public HWriterConsumer<int16_t> {
+
+    public:
+
+        HWriter<int16_t>* Writer = nullptr;
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            Writer = writer;
+        }
+};
+
+// Writer collecting the decoded samples
+class Collector : public HWriter<int16_t> {
+
+    public:
+
+        std::vector<int16_t> Samples;
+
+        Collector(): HWriter<int16_t>("collector") {}
+
+        int Write(int16_t* src, size_t blocksize) {
+            Samples.insert(Samples.end(), src, src + blocksize);
+            return blocksize;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+};
+
+static void TestEncoderDecoder() {
+
+    // Samples pass through the encoder and the decoder unchanged, with any framed format
+    WireFormatType formats[] = { RAW_WIRE, BLC_WIRE, NO_WIRE };
+    for( int i = 0; i < 3; i++ ) {
+        Counter counter;
+        BoomaWireEncoder encoder("encoder", &counter, formats[i], 1, 1024);
+        Source source;
+        BoomaWireDecoder decoder("decoder", &source, 1024, formats[i] != NO_WIRE);
+        Collector collector;
+        decoder.SetWriter(&collector);
+
+        int16_t block[1024];
+        for( int j = 0; j < 20; j++ ) {
+            CHECK(encoder.Read(block, 1024) == 1024);
+            source.Writer->Write(block, 1024);
+        }
+        CHECK(collector.Samples.size() >= 1024);
+        bool isInOrder = true;
+        for( size_t j = 0; j < collector.Samples.size(); j++ ) {
+            isInOrder = isInOrder && collector.Samples[j] == (int16_t) j;
+        }
+        CHECK(isInOrder);
+        CHECK(decoder.GetLostFrames() == 0);
+    }
+
+    // A head expecting frames refuses raw samples
+    Source source;
+    BoomaWireDecoder decoder("decoder", &source, 1024, true);
+    std::vector<int16_t> raw(1024, 0);
+    bool isThrown = false;
+    try {
+        source.Writer->Write(raw.data(), raw.size());
+    } catch( BoomaInputException* e ) {
+        isThrown = true;
+        delete e;
+    }
+    CHECK(isThrown);
+}
+
+int main(int argc, char** argv) {
+    TestFormats();
+    TestStream();
+    TestEncoderDecoder();
+    return TEST_RESULT();
+}
@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <strings.h>
+#include <unistd.h>
+
 #include <include/boomaamreceiver.h>
 #include "boomaapplication.h"
 #include "boomacwreceiver.h"
 #include "boomaauroralreceiver.h"
 #include "boomassbreceiver.h"
+#include "boomarttyreceiver.h"
 #include "booma.h"
 
 BoomaApplication::BoomaApplication(std::string appName, std::string appVersion, int argc, char** argv):
@@ -11,6 +18,8 @@ BoomaApplication::BoomaApplication(std::string appName, std::string appVersion,
     _input(NULL),
     _receiver(NULL),
     _output(NULL),
+    _decoder(NULL),
+    _skimmer(NULL),
     _isRunning(false) {
 
     // Initialize the Hardt toolkit.
@@ -43,6 +52,7 @@ BoomaApplication::~BoomaApplication() {
 
     // Reset all previous receiver components
     HLog("Reset receiver components");
+    DeleteReceiverChannels();
     if( _input != NULL ) {
         delete _input;
         _input = NULL;
@@ -51,6 +61,14 @@ BoomaApplication::~BoomaApplication() {
         delete _receiver;
         _receiver = NULL;
     }
+    if( _decoder != NULL ) {
+        delete _decoder;
+        _decoder = NULL;
+    }
+    if( _skimmer != NULL ) {
+        delete _skimmer;
+        _skimmer = NULL;
+    }
     if( _output != NULL ) {
         delete _output;
         _output = NULL;
@@ -68,6 +86,7 @@ bool BoomaApplication::Reconfigure() {
     Halt();
 
     // Reset all previous receiver components
+    DeleteReceiverChannels();
     if( _input != NULL ) {
         delete _input;
         _input = NULL;
@@ -76,6 +95,14 @@ bool BoomaApplication::Reconfigure() {
         delete _receiver;
         _receiver = NULL;
     }
+    if( _decoder != NULL ) {
+        delete _decoder;
+        _decoder = NULL;
+    }
+    if( _skimmer != NULL ) {
+        delete _skimmer;
+        _skimmer = NULL;
+    }
     if( _output != NULL ) {
         delete _output;
         _output = NULL;
@@ -158,6 +185,19 @@ bool BoomaApplication::InitializeReceiver() {
                 return false;
             }
         }
+        if( _opts->GetInputSourceType() == BLC_FILE ) {
+            if( access( _opts->GetBlcFile().c_str(), F_OK ) == -1 ) {
+                HError("Requested blc inputfile file %s does not exist", _opts->GetBlcFile().c_str());
+                _opts->SetFaulty(true);
+                return false;
+            }
+        }
+
+        // In batch mode, receiver chains are created for each segment when the batch is run
+        if( _opts->GetBatchMode() ) {
+            HLog("Batch mode, no receiver chain is created before running the batch");
+            return true;
+        }
 
         // Setup input
         try {
@@ -180,22 +220,10 @@ bool BoomaApplication::InitializeReceiver() {
 
         // Create receiver
         try {
-            switch (_opts->GetReceiverModeType()) {
-                case CW:
-                    _receiver = new BoomaCwReceiver(_opts, _input->GetIfFrequency());
-                    break;
-                case AM:
-                    _receiver = new BoomaAmReceiver(_opts, _input->GetIfFrequency());
-                    break;
-                case AURORAL:
-                    _receiver = new BoomaAuroralReceiver(_opts, _input->GetIfFrequency());
-                    break;
-                case SSB:
-                    _receiver = new BoomaSsbReceiver(_opts, _input->GetIfFrequency());
-                    break;
-                default:
-                    std::cout << "Unknown receiver type defined" << std::endl;
-                    return false;
+            _receiver = CreateReceiver(_input->GetIfFrequency());
+            if( _receiver == NULL ) {
+                std::cout << "Unknown receiver type defined" << std::endl;
+                return false;
             }
         } catch( BoomaReceiverException e ) {
             HError("Failed to create new receiver '%s', config is faulty", e.What().c_str());
@@ -217,7 +245,8 @@ bool BoomaApplication::InitializeReceiver() {
             } else {
                 HLog("Initial frequency %d is valid for the selected receiver", _opts->GetFrequency());
             }
-            _receiver->Build(_opts, _input);
+            _decoder = CreateDecoder(-1);
+            _receiver->Build(_opts, _input, _decoder);
         } catch( BoomaReceiverException e ) {
             HError("Failed to build receiver '%s', config is faulty", e.What().c_str());
             _opts->SetFaulty(true);
@@ -231,12 +260,27 @@ bool BoomaApplication::InitializeReceiver() {
         // Setup output
         try {
             _output = new BoomaOutput(_opts, _receiver);
+            if( _opts->GetTriggerRf() ) {
+                _output->SetTriggerRfCapture(_input->GetRfCapture());
+            }
         } catch( ... ) {
             HError("Failed to initialize output, unexpected exception was thrown. Config is faulty");
             _opts->SetFaulty(true);
             return false;
         }
 
+        // Setup additional receiver channels
+        if( !InitializeReceiverChannels() ) {
+            HError("Failed to initialize receiver channels. Config is faulty");
+            _opts->SetFaulty(true);
+            return false;
+        }
+
+        // Setup the skimmer on the same stream as the channels
+        if( _opts->GetSkimmer() ) {
+            _skimmer = new BoomaSkimmer("skimmer", _input->GetChannelWriterConsumer(), _opts->GetOutputSampleRate(), _opts->GetOriginalInputSourceType() == RTLSDR);
+        }
+
         // Set frequency - important when using a remote receiver
         SetFrequency(_opts->GetFrequency());
     }
@@ -250,6 +294,94 @@ bool BoomaApplication::InitializeReceiver() {
     return true;
 }
 
+BoomaReceiver* BoomaApplication::CreateReceiver(int frequency) {
+    switch (_opts->GetReceiverModeType()) {
+        case CW:
+            return new BoomaCwReceiver(_opts, frequency);
+        case AM:
+            return new BoomaAmReceiver(_opts, frequency);
+        case AURORAL:
+            return new BoomaAuroralReceiver(_opts, frequency);
+        case SSB:
+            return new BoomaSsbReceiver(_opts, frequency);
+        case RTTY:
+            return new BoomaRttyReceiver(_opts, frequency);
+        default:
+            HError("Unknown receiver type %d", _opts->GetReceiverModeType());
+            return NULL;
+    }
+}
+
+bool BoomaApplication::InitializeReceiverChannels() {
+
+    // Each channel gets its own receiver and output, all sharing the decimated stream from the input
+    std::vector<Channel*> channels = _opts->GetReceiverChannels();
+    for( std::vector<Channel*>::iterator it = channels.begin(); it != channels.end(); it++ ) {
+        HLog("Creating receiver channel '%s' at %ld", (*it)->Name.c_str(), (*it)->Frequency);
+        try {
+            BoomaChannelInput* channelInput = new BoomaChannelInput(_opts, _input, (*it)->Name, (*it)->Frequency);
+            _channelInputs.push_back(channelInput);
+            if( !channelInput->IsFrequencySupported(_opts, _input) ) {
+                HError("Channel '%s' at %ld is outside the input spectrum", (*it)->Name.c_str(), (*it)->Frequency);
+                return false;
+            }
+
+            BoomaReceiver* channelReceiver = CreateReceiver(channelInput->GetIfFrequency());
+            if( channelReceiver == NULL ) {
+                return false;
+            }
+            _channelReceivers.push_back(channelReceiver);
+            if( !channelReceiver->IsFrequencySupported(_opts, channelInput->GetIfFrequency()) ) {
+                HError("Channel '%s' at %ld is not supported by the receiver", (*it)->Name.c_str(), (*it)->Frequency);
+                return false;
+            }
+            _channelDecodedText.push_back("");
+            _channelDecoders.push_back(CreateDecoder(_channelDecoders.size()));
+            channelReceiver->Build(_opts, channelInput->GetLastWriterConsumer(), _channelDecoders.back());
+
+            // Channel output always goes to a file, the audio device is reserved for the main receiver
+            std::string name = (*it)->Name;
+            std::replace(name.begin(), name.end(), ' ', '_');
+            std::string suffix = _opts->GetDumpFileSuffix() == "" ? std::to_string(std::time(nullptr)) : _opts->GetDumpFileSuffix();
+            _channelOutputs.push_back(new BoomaOutput(_opts, channelReceiver, "CHANNEL_" + name + "_" + suffix + ".wav", "CHANNEL_OUTPUT_" + name));
+            _channelActive.push_back(true);
+        } catch( BoomaException* e ) {
+            HError("Failed to create receiver channel '%s': %s = %s", (*it)->Name.c_str(), e->Type().c_str(), e->What().c_str());
+            return false;
+        } catch( ... ) {
+            HError("Failed to create receiver channel '%s', unexpected exception was thrown", (*it)->Name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void BoomaApplication::DeleteReceiverChannels() {
+
+    // Same order as the main chain, the pipeline worker of a receiver writes to its output
+    // until the receiver is deleted
+    for( std::vector<BoomaChannelInput*>::iterator it = _channelInputs.begin(); it != _channelInputs.end(); it++ ) {
+        delete (*it);
+    }
+    _channelInputs.clear();
+    for( std::vector<BoomaReceiver*>::iterator it = _channelReceivers.begin(); it != _channelReceivers.end(); it++ ) {
+        delete (*it);
+    }
+    _channelReceivers.clear();
+    for( std::vector<BoomaDecoder*>::iterator it = _channelDecoders.begin(); it != _channelDecoders.end(); it++ ) {
+        SAFE_DELETE(*it);
+    }
+    _channelDecoders.clear();
+    for( std::vector<BoomaOutput*>::iterator it = _channelOutputs.begin(); it != _channelOutputs.end(); it++ ) {
+        delete (*it);
+    }
+    _channelOutputs.clear();
+    _channelActive.clear();
+
+    std::lock_guard<std::mutex> lock(_decodedTextMutex);
+    _channelDecodedText.clear();
+}
+
 bool BoomaApplication::SetFrequency(long int frequency) {
     if( IsFaulty() ) {
         return false;
@@ -264,6 +396,19 @@ bool BoomaApplication::SetFrequency(long int frequency) {
     // Tune the input and the receiver
     if( _input->SetFrequency(_opts, frequency) && _receiver->SetFrequency(_opts, _input->GetIfFrequency()) ) {
         _opts->SetFrequency(frequency);
+
+        // Channels stay at their own frequency, but move relative to the input
+        for( int i = 0; i < _channelInputs.size(); i++ ) {
+            _channelActive[i] = _channelInputs[i]->SetFrequency(_opts, _input) && _channelReceivers[i]->SetFrequency(_opts, _channelInputs[i]->GetIfFrequency());
+            if( !_channelActive[i] ) {
+                HLog("Channel '%s' can not be received at the new frequency %ld", _channelInputs[i]->GetName().c_str(), frequency);
+            }
+        }
+
+        // IQ input moves with the frequency, so all signals found by the skimmer has moved
+        if( _skimmer != NULL && _opts->GetOriginalInputSourceType() == RTLSDR ) {
+            _skimmer->Reset();
+        }
         return true;
     }
 
@@ -327,6 +472,46 @@ bool BoomaApplication::GetDumpAudio() {
     return _opts->GetDumpAudio();
 }
 
+bool BoomaApplication::Capture(int seconds) {
+    if( IsFaulty() || _opts->GetCaptureSeconds() <= 0 ) {
+        return false;
+    }
+
+    // Capture rf and audio from all channels at the same time, a remote head may lack either
+    bool isOk = _input != nullptr && _input->CaptureRf(seconds);
+    isOk = _output != nullptr && _output->CaptureAudio(seconds) && isOk;
+    for( std::vector<BoomaOutput*>::iterator it = _channelOutputs.begin(); it != _channelOutputs.end(); it++ ) {
+        isOk = (*it)->CaptureAudio(seconds) && isOk;
+    }
+    return isOk;
+}
+
+void BoomaApplication::StopCapture() {
+    if( IsFaulty() ) {
+        return;
+    }
+    if( _input != nullptr ) {
+        _input->StopCaptureRf();
+    }
+    if( _output != nullptr ) {
+        _output->StopCaptureAudio();
+    }
+    for( std::vector<BoomaOutput*>::iterator it = _channelOutputs.begin(); it != _channelOutputs.end(); it++ ) {
+        (*it)->StopCaptureAudio();
+    }
+}
+
+bool BoomaApplication::IsCapturing() {
+    if( IsFaulty() ) {
+        return false;
+    }
+    return (_input != nullptr && _input->IsCapturingRf()) || (_output != nullptr && _output->IsCapturingAudio());
+}
+
+int BoomaApplication::GetCaptureSeconds() {
+    return _opts->GetCaptureSeconds();
+}
+
 bool BoomaApplication::SetRfGain(int gain) {
     if( IsFaulty() ) {
         return false;
@@ -372,6 +557,294 @@ int BoomaApplication::GetRfSpectrum(double* spectrum) {
     return _input != nullptr ? _input->GetRfSpectrum(spectrum) : 0;
 }
 
+unsigned long BoomaApplication::GetInputOverflows() {
+    return _input != nullptr ? _input->GetInputOverflows() : 0;
+}
+
+unsigned long BoomaApplication::GetInputUnderruns() {
+    return _input != nullptr ? _input->GetInputUnderruns() : 0;
+}
+
+bool BoomaApplication::SeekInput(double seconds) {
+    return _input != nullptr ? _input->Seek(_opts, seconds) : false;
+}
+
+double BoomaApplication::GetInputPosition() {
+    return _input != nullptr ? _input->GetPosition(_opts) : 0;
+}
+
+std::vector<BoomaPipelineStatistics> BoomaApplication::GetPipelineStatistics() {
+    std::vector<BoomaPipelineStatistics> statistics;
+    if( _input != nullptr && _input->GetPipeline() != nullptr ) {
+        statistics.push_back(_input->GetPipeline()->GetStatistics());
+    }
+    if( _receiver != nullptr && _receiver->GetPipeline() != nullptr ) {
+        statistics.push_back(_receiver->GetPipeline()->GetStatistics());
+    }
+    for( int channel = 0; channel < (int) _channelReceivers.size(); channel++ ) {
+        if( _channelReceivers[channel]->GetPipeline() != nullptr ) {
+            BoomaPipelineStatistics channelStatistics = _channelReceivers[channel]->GetPipeline()->GetStatistics();
+            channelStatistics.Name = "channel_" + std::to_string(channel) + "_" + channelStatistics.Name;
+            statistics.push_back(channelStatistics);
+        }
+    }
+    return statistics;
+}
+
+void BoomaApplication::ResetPipelineStatistics() {
+    if( _input != nullptr && _input->GetPipeline() != nullptr ) {
+        _input->GetPipeline()->ResetStatistics();
+    }
+    if( _receiver != nullptr && _receiver->GetPipeline() != nullptr ) {
+        _receiver->GetPipeline()->ResetStatistics();
+    }
+    for( std::vector<BoomaReceiver*>::iterator it = _channelReceivers.begin(); it != _channelReceivers.end(); it++ ) {
+        if( (*it)->GetPipeline() != nullptr ) {
+            (*it)->GetPipeline()->ResetStatistics();
+        }
+    }
+}
+
+void BoomaApplication::RunBlocks(int blocks) {
+    if( _opts->IsFaulty() || _input == NULL ) {
+        HError("Unable to run blocks, configuration is faulty or there is no input");
+        return;
+    }
+
+    HLog("Running %d blocks", blocks);
+    _isTerminated = false;
+    _isRunning = true;
+    _input->Run(blocks);
+    _isTerminated = true;
+    _isRunning = false;
+}
+
+bool BoomaApplication::RunBatch(BoomaBatchReport* report) {
+    if( !_opts->GetBatchMode() || _opts->IsFaulty() ) {
+        HError("Unable to run batch, batch mode is not enabled or the configuration is faulty");
+        return false;
+    }
+
+    // Locate the samples in the input file
+    bool isWav = _opts->GetInputSourceType() == WAV_FILE;
+    std::string filename = isWav ? _opts->GetWavFile() : _opts->GetPcmFile();
+    long offset;
+    long length;
+    if( !BoomaFileSegmentReader::GetLayout(filename, isWav, &offset, &length) ) {
+        HError("Unable to read the layout of the input file %s", filename.c_str());
+        return false;
+    }
+
+    // Split the input into segments of whole blocks. All segments, except the first, starts with an
+    // overlap into the previous segment, so that filters and agc's can settle before the segment
+    // begins. Output produced from the overlap is discarded when the segments are merged.
+    // The overlap is whole blocks, but it is trimmed by samples: The output is cut at the sample
+    // matching the first input sample of the segment, scaled by the ratio of output to input
+    // samples of the segment, which is exact to within one output sample
+    int valuesPerSecond = _opts->GetOutputSampleRate() * (_opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ? 1 : 2);
+    long blocks = (length + BLOCKSIZE - 1) / BLOCKSIZE;
+    long overlapBlocks = (((long) _opts->GetBatchOverlap() * valuesPerSecond) + BLOCKSIZE - 1) / BLOCKSIZE;
+    long segments = _opts->GetBatchSegments() > 0 ? _opts->GetBatchSegments() : std::thread::hardware_concurrency();
+    long maxSegments = overlapBlocks > 0 ? blocks / overlapBlocks : blocks;
+    segments = segments > maxSegments ? maxSegments : segments;
+    segments = segments < 1 ? 1 : segments;
+    long segmentBlocks = (blocks + segments - 1) / segments;
+    HLog("Batch processing %ld blocks from %s in %ld segments of %ld blocks with %ld blocks overlap", blocks, filename.c_str(), segments, segmentBlocks, overlapBlocks);
+
+    // Create a receiver chain for each segment. Building a chain reads and updates the
+    // configuration, so the chains are created one by one on this thread
+    std::vector<BoomaInput*> inputs;
+    std::vector<BoomaReceiver*> receivers;
+    std::vector<BoomaOutput*> outputs;
+    std::vector<std::string> filenames;
+    std::vector<double> overlaps;
+    bool isOk = true;
+
+    // Segment files are unique to this run, so that runs writing to the same output does not collide
+    std::string run = std::to_string(getpid()) + "-" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    HReader<int16_t>* reader = nullptr;
+    try {
+        for( long first = 0; first < blocks; first += segmentBlocks ) {
+            long last = first + segmentBlocks < blocks ? first + segmentBlocks : blocks;
+            long start = first - overlapBlocks > 0 ? first - overlapBlocks : 0;
+            long end = last * BLOCKSIZE < length ? last * BLOCKSIZE : length;
+            std::string segmentFilename = _opts->GetOutputFilename() + ".segment-" + run + "-" + std::to_string(filenames.size()) + ".pcm";
+
+            reader = _opts->GetMemoryMappedInput()
+                ? (HReader<int16_t>*) new BoomaMappedFileReader("input_segment_mapped_reader", filename, isWav, start * BLOCKSIZE, end - (start * BLOCKSIZE))
+                : (HReader<int16_t>*) new BoomaFileSegmentReader("input_segment_reader", filename, offset + (start * BLOCKSIZE * sizeof(int16_t)), end - (start * BLOCKSIZE));
+
+            // The input owns the reader once it has been created
+            inputs.push_back(new BoomaInput(_opts, &_isTerminated, reader));
+            reader = nullptr;
+            receivers.push_back(CreateReceiver(inputs.back()->GetIfFrequency()));
+            if( receivers.back() == NULL ) {
+                throw new BoomaReceiverException("Unknown receiver type defined");
+            }
+            receivers.back()->Build(_opts, inputs.back());
+            outputs.push_back(new BoomaOutput(_opts, receivers.back(), segmentFilename));
+            filenames.push_back(segmentFilename);
+            overlaps.push_back((double) ((first - start) * BLOCKSIZE) / (double) (end - (start * BLOCKSIZE)));
+        }
+    } catch( ... ) {
+        HError("Failed to create receiver chains for the batch segments");
+        SAFE_DELETE(reader);
+        isOk = false;
+    }
+
+    // Run all segments in parallel
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    if( isOk ) {
+        _isTerminated = false;
+        _isRunning = true;
+        std::atomic<bool> failed(false);
+        std::vector<std::thread> threads;
+        for( std::vector<BoomaInput*>::iterator it = inputs.begin(); it != inputs.end(); it++ ) {
+            BoomaInput* input = *it;
+            threads.push_back(std::thread( [input, &failed]() {
+                try {
+                    input->Run();
+                } catch( ... ) {
+                    HError("Caught exception while processing a batch segment");
+                    failed = true;
+                }
+            } ));
+        }
+        for( std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); it++ ) {
+            (*it).join();
+        }
+        _isRunning = false;
+        isOk = !failed;
+    }
+
+    // Release the receiver chains, this closes the segment output files
+    for( std::vector<BoomaInput*>::iterator it = inputs.begin(); it != inputs.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaReceiver*>::iterator it = receivers.begin(); it != receivers.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaOutput*>::iterator it = outputs.begin(); it != outputs.end(); it++ ) {
+        delete *it;
+    }
+
+    // Merge the segment outputs into the final output file
+    long samples = 0;
+    isOk = MergeBatchSegments(filenames, overlaps, &samples) && isOk;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    report->Segments = filenames.size();
+    report->InputSeconds = (double) length / valuesPerSecond;
+    report->Seconds = seconds;
+    report->RealtimeFactor = seconds > 0 ? report->InputSeconds / seconds : 0;
+    report->OutputSamples = samples;
+    HLog("Batch processed %f seconds of input in %f seconds", report->InputSeconds, report->Seconds);
+    return isOk;
+}
+
+bool BoomaApplication::MergeBatchSegments(std::vector<std::string> filenames, std::vector<double> overlaps, long* samples) {
+
+    std::string filename = _opts->GetOutputFilename();
+    bool isWav = filename.length() > 4 && strcasecmp(filename.substr(filename.length() - 4).c_str(), ".wav") == 0;
+    FILE* output = fopen(filename.c_str(), "wb");
+    if( output == nullptr ) {
+        HError("Unable to create output file %s", filename.c_str());
+        return false;
+    }
+    uint8_t header[BoomaAsyncWriter::WavHeaderSize];
+    if( isWav ) {
+        BoomaAsyncWriter::CreateWavHeader(header, _opts->GetOutputSampleRate(), 0);
+        fwrite((void*) header, 1, BoomaAsyncWriter::WavHeaderSize, output);
+    }
+
+    // Append each segment, skipping the output produced from the overlap
+    bool isOk = true;
+    int16_t buffer[BLOCKSIZE];
+    *samples = 0;
+    for( int i = 0; i < filenames.size(); i++ ) {
+        FILE* segment = fopen(filenames.at(i).c_str(), "rb");
+        if( segment == nullptr ) {
+            HError("Unable to open batch segment output %s", filenames.at(i).c_str());
+            isOk = false;
+            continue;
+        }
+        fseek(segment, 0, SEEK_END);
+        long length = ftell(segment) / sizeof(int16_t);
+        long skip = (long) ((length * overlaps.at(i)) + 0.5);
+        fseek(segment, skip * sizeof(int16_t), SEEK_SET);
+
+        size_t read;
+        while( (read = fread((void*) buffer, sizeof(int16_t), BLOCKSIZE, segment)) > 0 ) {
+            fwrite((void*) buffer, sizeof(int16_t), read, output);
+            *samples += read;
+        }
+        fclose(segment);
+        remove(filenames.at(i).c_str());
+    }
+
+    if( isWav ) {
+        fseek(output, 0, SEEK_SET);
+        BoomaAsyncWriter::CreateWavHeader(header, _opts->GetOutputSampleRate(), *samples);
+        fwrite((void*) header, 1, BoomaAsyncWriter::WavHeaderSize, output);
+    }
+    fclose(output);
+    HLog("Merged %zu batch segments with %ld samples into %s", filenames.size(), *samples, filename.c_str());
+    return isOk;
+}
+
+std::vector<BoomaStageStatistics> BoomaApplication::GetStageStatistics() {
+    std::vector<BoomaStageStatistics> statistics;
+    if( _input != nullptr ) {
+        _input->GetTiming()->GetStatistics(&statistics);
+    }
+    if( _receiver != nullptr ) {
+        _receiver->GetTiming()->GetStatistics(&statistics);
+    }
+    if( _output != nullptr ) {
+        _output->GetTiming()->GetStatistics(&statistics);
+    }
+    return statistics;
+}
+
+void BoomaApplication::ResetStageStatistics() {
+    if( _input != nullptr ) {
+        _input->GetTiming()->Reset();
+    }
+    if( _receiver != nullptr ) {
+        _receiver->GetTiming()->Reset();
+    }
+    if( _output != nullptr ) {
+        _output->GetTiming()->Reset();
+    }
+}
+
+std::vector<BoomaAsyncWriterStatistics> BoomaApplication::GetDumpStatistics() {
+    std::vector<BoomaAsyncWriterStatistics> statistics;
+    if( _input != nullptr ) {
+        _input->GetDumpStatistics(&statistics);
+    }
+    if( _output != nullptr ) {
+        _output->GetDumpStatistics(&statistics);
+    }
+    return statistics;
+}
+
+std::vector<BoomaRemoteStatistics> BoomaApplication::GetRemoteStatistics() {
+    std::vector<BoomaRemoteStatistics> statistics;
+    if( _input != nullptr ) {
+        _input->GetRemoteStatistics(&statistics);
+    }
+    return statistics;
+}
+
+int BoomaApplication::GetRemoteStatisticsInterval() {
+    return _opts->GetRemoteStatisticsInterval();
+}
+
+bool BoomaApplication::GetStageTiming() {
+    return _opts->GetStageTiming();
+}
+
 int BoomaApplication::GetAudioFftSize() {
     return _output != nullptr ? _output->GetAudioFftSize() : 0;
 }
@@ -431,6 +904,14 @@ bool BoomaApplication::SetWavFile(std::string filename) {
     return _opts->SetWavFile(filename);
 }
 
+std::string BoomaApplication::GetBlcFile() {
+    return _opts->GetBlcFile();
+}
+
+bool BoomaApplication::SetBlcFile(std::string filename) {
+    return _opts->SetBlcFile(filename);
+}
+
 int BoomaApplication::GetSignalGeneratorFrequency() {
     return _opts->GetSignalGeneratorFrequency();
 }
@@ -539,12 +1020,146 @@ bool BoomaApplication::UseChannel(int id) {
     return false;
 }
 
+int BoomaApplication::GetReceiverChannelCount() {
+    return _channelInputs.size();
+}
+
+std::string BoomaApplication::GetReceiverChannelName(int channel) {
+    if( channel < 0 || channel >= _channelInputs.size() ) {
+        return "";
+    }
+    return _channelInputs[channel]->GetName();
+}
+
+long int BoomaApplication::GetReceiverChannelFrequency(int channel) {
+    if( channel < 0 || channel >= _channelInputs.size() ) {
+        return 0;
+    }
+    return _channelInputs[channel]->GetFrequency();
+}
+
+bool BoomaApplication::IsReceiverChannelActive(int channel) {
+    if( channel < 0 || channel >= _channelActive.size() ) {
+        return false;
+    }
+    return _channelActive[channel];
+}
+
+int BoomaApplication::GetReceiverChannelSignalLevel(int channel) {
+    if( !_isRunning || channel < 0 || channel >= _channelOutputs.size() ) {
+        return 0;
+    }
+
+    // Same relative S calculation as for the main receiver
+    int max = _channelOutputs[channel]->GetSignalMax() / _channelReceivers[channel]->GetRfAgcCurrentGain();
+    return ((20 * log10((float) ceil((max == 0 ? 1 : max)))) / 6) - 4;
+}
+
+bool BoomaApplication::SetReceiverChannelOption(int channel, std::string name, std::string value) {
+    if( channel < 0 || channel >= _channelReceivers.size() ) {
+        return false;
+    }
+    return _channelReceivers[channel]->SetOption(_opts, name, value);
+}
+
+std::string BoomaApplication::GetReceiverChannelOptionInfoString(int channel) {
+    if( channel < 0 || channel >= _channelReceivers.size() ) {
+        return "";
+    }
+    return _channelReceivers[channel]->GetOptionInfoString();
+}
+
+BoomaDecoder* BoomaApplication::CreateDecoder(int channel) {
+
+    // Channel -1 is the main receiver
+    std::function<void(std::string)> callback = [this, channel](std::string decoded) {
+        std::lock_guard<std::mutex> lock(_decodedTextMutex);
+        AddDecodedText(channel < 0 ? &_decodedText : &_channelDecodedText.at(channel), decoded);
+    };
+
+    // CW decoding is optional, the RTTY receiver is always decoded
+    switch( _opts->GetReceiverModeType() ) {
+        case CW:
+            if( !_opts->GetCwDecoder() ) {
+                return NULL;
+            }
+            return new BoomaCwDecoder(channel < 0 ? "receiver_cw_decoder" : "channel_cw_decoder_" + std::to_string(channel), _opts->GetOutputSampleRate(), callback);
+        case RTTY:
+            return new BoomaRttyDecoder(channel < 0 ? "receiver_rtty_decoder" : "channel_rtty_decoder_" + std::to_string(channel), _opts->GetOutputSampleRate(), callback);
+        default:
+            return NULL;
+    }
+}
+
+void BoomaApplication::AddDecodedText(std::string* text, std::string decoded) {
+
+    // Keep only the most recent text if nobody fetches it
+    text->append(decoded);
+    if( text->size() > 1024 ) {
+        text->erase(0, text->size() - 1024);
+    }
+}
+
+bool BoomaApplication::HasDecoder() {
+    return _decoder != NULL;
+}
+
+std::string BoomaApplication::GetDecodedText() {
+    std::lock_guard<std::mutex> lock(_decodedTextMutex);
+    std::string text = _decodedText;
+    _decodedText.clear();
+    return text;
+}
+
+int BoomaApplication::GetDecoderWpm() {
+    return _decoder != NULL ? _decoder->GetWpm() : 0;
+}
+
+std::string BoomaApplication::GetReceiverChannelDecodedText(int channel) {
+    std::lock_guard<std::mutex> lock(_decodedTextMutex);
+    if( channel < 0 || channel >= _channelDecodedText.size() ) {
+        return "";
+    }
+    std::string text = _channelDecodedText[channel];
+    _channelDecodedText[channel].clear();
+    return text;
+}
+
+int BoomaApplication::GetReceiverChannelDecoderWpm(int channel) {
+    if( channel < 0 || channel >= _channelDecoders.size() || _channelDecoders[channel] == NULL ) {
+        return 0;
+    }
+    return _channelDecoders[channel]->GetWpm();
+}
+
+bool BoomaApplication::HasSkimmer() {
+    return _skimmer != NULL;
+}
+
+std::vector<BoomaSkimmerSpot> BoomaApplication::GetSkimmerSpots() {
+    std::vector<BoomaSkimmerSpot> spots;
+    if( _skimmer == NULL ) {
+        return spots;
+    }
+
+    // Offsets are positions in the input stream, where the tuned frequency is at the IF
+    spots = _skimmer->GetSpots();
+    for( std::vector<BoomaSkimmerSpot>::iterator it = spots.begin(); it != spots.end(); it++ ) {
+        (*it).Frequency = _input->GetVirtualFrequency() + (*it).Offset - _input->GetIfFrequency();
+    }
+    std::sort(spots.begin(), spots.end(), [](BoomaSkimmerSpot a, BoomaSkimmerSpot b) { return a.Frequency < b.Frequency; });
+    return spots;
+}
+
 bool BoomaApplication::SetInputFilterWidth(int width) {
     if( IsFaulty() ) {
         return false;
     }
 
     _opts->SetInputFilterWidth(width);
+    for( std::vector<BoomaChannelInput*>::iterator it = _channelInputs.begin(); it != _channelInputs.end(); it++ ) {
+        (*it)->SetInputFilterWidth(_opts, width);
+    }
     return _input->SetInputFilterWidth(_opts, width);
 }
 
@@ -0,0 +1,68 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "boomaasyncfilewriter.h"
+
+BoomaAsyncFileWriter::BoomaAsyncFileWriter(std::string id, std::string filename, bool isWav, int samplerate, HWriterConsumer<int16_t>* previous, bool isBlocking, int buffers):
+        BoomaAsyncWriter(id, previous, buffers, isBlocking),
+        _filename(filename),
+        _isWav(isWav),
+        _samplerate(samplerate),
+        _fd(-1),
+        _size(0),
+        _synced(0),
+        _isFailed(false) {
+
+    HLog("Creating asynchronous writer for %s", filename.c_str());
+}
+
+BoomaAsyncFileWriter::~BoomaAsyncFileWriter() {
+    Stop();
+}
+
+bool BoomaAsyncFileWriter::Open() {
+    _fd = open(_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if( _fd == -1 ) {
+        HError("Unable to create %s", _filename.c_str());
+        _isFailed = true;
+        return false;
+    }
+
+    // The wav header is rewritten with the final size when the file is closed
+    if( _isWav ) {
+        uint8_t header[WavHeaderSize];
+        CreateWavHeader(header, _samplerate, 0);
+        if( !WriteFully(_fd, header, WavHeaderSize) ) {
+            HError("Failed to write wav header to %s", _filename.c_str());
+        }
+        _size = WavHeaderSize;
+    }
+    return true;
+}
+
+void BoomaAsyncFileWriter::WriteBuffer(int16_t* samples, size_t length) {
+    if( _fd == -1 && (_isFailed || !Open()) ) {
+        return;
+    }
+    if( !WriteFully(_fd, samples, length * sizeof(int16_t)) ) {
+        HError("Failed to write to %s", _filename.c_str());
+    }
+    _size += length * sizeof(int16_t);
+    StartWriteback(_fd, &_synced, _size);
+}
+
+void BoomaAsyncFileWriter::Close() {
+    if( _fd == -1 ) {
+        return;
+    }
+    if( _isWav ) {
+        uint8_t header[WavHeaderSize];
+        CreateWavHeader(header, _samplerate, (_size - WavHeaderSize) / sizeof(int16_t));
+        if( pwrite(_fd, header, WavHeaderSize, 0) != WavHeaderSize ) {
+            HError("Failed to update wav header in %s", _filename.c_str());
+        }
+    }
+    close(_fd);
+    _fd = -1;
+    HLog("Closed %s with %ld bytes", _filename.c_str(), (long) _size);
+}
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "boomaasyncwriter.h"
+#include "boomalittleendian.h"
+
+// Size of the buffers handed to the writer thread. A multiple of the page size
+#define ASYNC_BUFFER_SIZE (1024 * 1024)
+#define ASYNC_BUFFER_SAMPLES (ASYNC_BUFFER_SIZE / sizeof(int16_t))
+#define ASYNC_BUFFER_ALIGNMENT 4096
+
+// Amount of written data before writeback is started
+#define ASYNC_WRITEBACK_SIZE (1024 * 1024)
+
+BoomaAsyncWriter::BoomaAsyncWriter(std::string id, HWriterConsumer<int16_t>* previous, int buffers, bool isBlocking):
+        HWriter<int16_t>(id),
+        _buffers(buffers),
+        _isBlocking(isBlocking),
+        _started(0),
+        _current(nullptr),
+        _currentLength(0),
+        _allocated(0),
+        _thread(nullptr),
+        _isRunning(false),
+        _queuedBytes(0),
+        _writtenBytes(0),
+        _droppedSamples(0),
+        _writes(0),
+        _totalLatency(0),
+        _maxLatency(0) {
+
+    if( previous != nullptr ) {
+        previous->SetWriter(this);
+    }
+}
+
+BoomaAsyncWriter::~BoomaAsyncWriter() {
+    StopWorker();
+    for( std::deque<int16_t*>::iterator it = _free.begin(); it != _free.end(); it++ ) {
+        free(*it);
+    }
+    for( std::deque<std::pair<int16_t*, size_t>>::iterator it = _queue.begin(); it != _queue.end(); it++ ) {
+        free((*it).first);
+    }
+    if( _current != nullptr ) {
+        free(_current);
+    }
+}
+
+bool BoomaAsyncWriter::Start() {
+    if( _thread == nullptr ) {
+        _isRunning = true;
+        _thread = new std::thread(&BoomaAsyncWriter::WorkerThread, this);
+    }
+    return true;
+}
+
+bool BoomaAsyncWriter::Stop() {
+    Flush();
+    StopWorker();
+    Close();
+    return true;
+}
+
+void BoomaAsyncWriter::StopWorker() {
+    if( _thread != nullptr ) {
+
+        // The worker drains the queue before it stops
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isRunning = false;
+        }
+        _notEmpty.notify_all();
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+}
+
+void BoomaAsyncWriter::Flush() {
+    if( _current != nullptr && _currentLength > 0 ) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(std::make_pair(_current, _currentLength));
+        _queuedBytes += _currentLength * sizeof(int16_t);
+        _current = nullptr;
+        _currentLength = 0;
+        _notEmpty.notify_one();
+    }
+}
+
+int BoomaAsyncWriter::Write(int16_t* src, size_t blocksize) {
+
+    // The processing chain may not call Start() on its writers
+    if( _thread == nullptr ) {
+        Start();
+    }
+    if( _started == 0 ) {
+        _started = std::time(nullptr);
+    }
+
+    size_t done = 0;
+    while( done < blocksize ) {
+
+        // Get a free buffer, or allocate a new one if we are still below the limit
+        if( _current == nullptr ) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if( _isBlocking ) {
+                _available.wait(lock, [this] { return !_free.empty() || _allocated < _buffers; });
+            }
+            if( !_free.empty() ) {
+                _current = _free.front();
+                _free.pop_front();
+            } else if( _allocated < _buffers ) {
+                void* buffer;
+                if( posix_memalign(&buffer, ASYNC_BUFFER_ALIGNMENT, ASYNC_BUFFER_SIZE) == 0 ) {
+                    _current = (int16_t*) buffer;
+                    _allocated++;
+                }
+            }
+
+            // Drop the rest of the block rather than waiting for the disk
+            if( _current == nullptr ) {
+                _droppedSamples += blocksize - done;
+                return blocksize;
+            }
+            _currentLength = 0;
+        }
+
+        // Copy as much as there is room for, hand over the buffer when it is full
+        size_t length = std::min(blocksize - done, ASYNC_BUFFER_SAMPLES - _currentLength);
+        memcpy((void*) &_current[_currentLength], (void*) &src[done], length * sizeof(int16_t));
+        _currentLength += length;
+        done += length;
+        if( _currentLength == ASYNC_BUFFER_SAMPLES ) {
+            Flush();
+        }
+    }
+
+    return blocksize;
+}
+
+void BoomaAsyncWriter::WorkerThread() {
+    HLog("Asynchronous writer %s started", GetId().c_str());
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while( true ) {
+        _notEmpty.wait(lock, [this] { return !_queue.empty() || !_isRunning; });
+        if( _queue.empty() ) {
+            break;
+        }
+        std::pair<int16_t*, size_t> buffer = _queue.front();
+        _queue.pop_front();
+        lock.unlock();
+
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        WriteBuffer(buffer.first, buffer.second);
+        double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+        lock.lock();
+        _free.push_back(buffer.first);
+        _available.notify_one();
+        _queuedBytes -= buffer.second * sizeof(int16_t);
+        _writtenBytes += buffer.second * sizeof(int16_t);
+        _writes++;
+        _totalLatency += latency;
+        _maxLatency = latency > _maxLatency ? latency : _maxLatency;
+    }
+    HLog("Asynchronous writer %s stopped", GetId().c_str());
+}
+
+bool BoomaAsyncWriter::WriteFully(int fd, const void* data, size_t bytes) {
+    const char* next = (const char*) data;
+    while( bytes > 0 ) {
+        ssize_t result = write(fd, next, bytes);
+        if( result < 0 ) {
+            return false;
+        }
+        next += result;
+        bytes -= result;
+    }
+    return true;
+}
+
+void BoomaAsyncWriter::StartWriteback(int fd, off_t* synced, off_t size) {
+    if( size - *synced >= ASYNC_WRITEBACK_SIZE ) {
+        sync_file_range(fd, *synced, size - *synced, SYNC_FILE_RANGE_WRITE);
+        *synced = size;
+    }
+}
+
+void BoomaAsyncWriter::CreateWavHeader(uint8_t* header, int rate, long samples) {
+    uint32_t dataSize = samples * sizeof(int16_t);
+    memcpy(&header[0], "RIFF", 4);
+    WriteLittleEndian(&header[4], 36 + dataSize, 4);
+    memcpy(&header[8], "WAVEfmt ", 8);
+    WriteLittleEndian(&header[16], 16, 4);
+    WriteLittleEndian(&header[20], 1, 2);
+    WriteLittleEndian(&header[22], 1, 2);
+    WriteLittleEndian(&header[24], rate, 4);
+    WriteLittleEndian(&header[28], rate * sizeof(int16_t), 4);
+    WriteLittleEndian(&header[32], sizeof(int16_t), 2);
+    WriteLittleEndian(&header[34], 16, 2);
+    memcpy(&header[36], "data", 4);
+    WriteLittleEndian(&header[40], dataSize, 4);
+}
+
+void BoomaAsyncWriter::GetStatistics(BoomaAsyncWriterStatistics* statistics) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    statistics->Name = GetId();
+    statistics->QueuedBytes = _queuedBytes;
+    statistics->WrittenBytes = _writtenBytes;
+    statistics->DroppedSamples = _droppedSamples;
+    statistics->Writes = _writes;
+    statistics->AverageLatency = _writes > 0 ? _totalLatency / _writes : 0;
+    statistics->MaxLatency = _maxLatency;
+    statistics->Segment = _segment;
+}
+
+void BoomaAsyncWriter::SetSegment(std::string segment) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _segment = segment;
+}
+
+unsigned long BoomaAsyncWriter::GetDroppedSamples() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _droppedSamples;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include <hardtapi.h>
+
+#include "boomabiquaddesigner.h"
+
+std::mutex BoomaBiQuadDesigner::_mutex;
+std::map<std::tuple<int, int, int>, std::vector<float>> BoomaBiQuadDesigner::_designs;
+
+float* BoomaBiQuadDesigner::GetBandpass(int center, int width, int rate) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::tuple<int, int, int> key(center, width, rate);
+    std::map<std::tuple<int, int, int>, std::vector<float>>::iterator it = _designs.find(key);
+    if( it == _designs.end() ) {
+        it = _designs.insert(std::make_pair(key, std::vector<float>())).first;
+        Design(center, width, rate, &it->second);
+    }
+    return it->second.data();
+}
+
+void BoomaBiQuadDesigner::Design(int center, int width, int rate, std::vector<float>* coefficients) {
+
+    // Keep the passband inside 0 .. rate/2, with a small margin so that no pole ends up on the unit circle
+    int limit = (int) (std::min(center, (rate / 2) - center) * 1.9);
+    if( width > limit ) {
+        HLog("Narrowing %d Hz bandpass at %d Hz to %d Hz at samplerate %d", width, center, limit, rate);
+        width = limit;
+    }
+    width = std::max(width, 1);
+    HLog("Designing %d Hz bandpass at %d Hz for samplerate %d", width, center, rate);
+
+    // Prewarped analog band edges
+    double fs = rate;
+    double low = 2 * fs * tan(M_PI * (center - (width / 2.0)) / fs);
+    double high = 2 * fs * tan(M_PI * (center + (width / 2.0)) / fs);
+    double w0 = sqrt(low * high);
+    double bw = high - low;
+
+    // Lowpass prototype poles moved to the passband. Each prototype pole gives a pole in the upper
+    // half plane, its conjugate comes from the conjugate prototype pole
+    std::vector<std::complex<double>> poles;
+    for( int k = 0; k < Sections; k++ ) {
+        std::complex<double> p = std::polar(1.0, M_PI * (2 * k + 1 + Sections) / (2.0 * Sections));
+        std::complex<double> a = p * (bw / 2);
+        std::complex<double> d = std::sqrt((a * a) - (w0 * w0));
+        std::complex<double> s = (a + d).imag() > 0 ? a + d : a - d;
+
+        // Bilinear transform
+        poles.push_back(((2 * fs) + s) / ((2 * fs) - s));
+    }
+
+    // Lower poles gets the zeros at DC, higher poles the zeros at rate/2
+    std::sort(poles.begin(), poles.end(), [](std::complex<double> a, std::complex<double> b) { return std::arg(a) < std::arg(b); });
+
+    // Sections interleaved so that the zeros alternate between DC and rate/2
+    double w = 2 * atan(w0 / (2 * fs));
+    std::complex<double> z = std::polar(1.0, -w);
+    coefficients->resize(Coefficients);
+    for( int i = 0; i < Sections; i++ ) {
+        int pole = (i % 2 == 0) ? i / 2 : (Sections / 2) + (i / 2);
+        double b1 = (i % 2 == 0) ? -2 : 2;
+        double a1 = -2 * poles.at(pole).real();
+        double a2 = std::norm(poles.at(pole));
+
+        // Unity gain at the center of the passband
+        std::complex<double> gain = (1.0 + (b1 * z) + (z * z)) / (1.0 + (a1 * z) + (a2 * z * z));
+        double scale = 1 / std::abs(gain);
+
+        float* section = &(*coefficients)[i * 5];
+        section[0] = scale;
+        section[1] = b1 * scale;
+        section[2] = scale;
+        section[3] = -a1;
+        section[4] = -a2;
+    }
+}
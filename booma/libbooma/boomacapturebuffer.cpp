@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "boomacapturebuffer.h"
+
+// Room in the ring in addition to the history, in seconds, and the number of samples copied at a time
+#define CAPTURE_MARGIN_SECONDS 2
+#define CAPTURE_CHUNK_SAMPLES 65536
+
+BoomaCaptureBuffer::BoomaCaptureBuffer(std::string id, std::string prefix, int seconds, int samplerate, int channels, HWriterConsumer<int16_t>* previous):
+        HWriter<int16_t>(id),
+        _prefix(prefix),
+        _samplerate(samplerate),
+        _channels(channels),
+        _size((size_t) seconds * samplerate * channels),
+        _ring(nullptr),
+        _capacity(_size + ((size_t) CAPTURE_MARGIN_SECONDS * samplerate * channels)),
+        _written(0),
+        _captureThread(nullptr),
+        _isCapturing(false),
+        _isStopping(false),
+        _first(0),
+        _end(0) {
+
+    HLog("Creating capture buffer %s holding %d seconds (%lu samples)", prefix.c_str(), seconds, (unsigned long) _size);
+    _ring = new int16_t[_capacity];
+    memset((void*) _ring, 0, _capacity * sizeof(int16_t));
+    _captureThread = new std::thread(&BoomaCaptureBuffer::CaptureThread, this);
+    previous->SetWriter(this);
+}
+
+BoomaCaptureBuffer::~BoomaCaptureBuffer() {
+
+    // A running capture writes what it has received before the thread exits
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+        _end = std::min(_end, _written);
+        _arrived.notify_all();
+    }
+    _captureThread->join();
+    delete _captureThread;
+    delete[] _ring;
+}
+
+int BoomaCaptureBuffer::Write(int16_t* src, size_t blocksize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Keep the newest samples in the ring
+    size_t done = 0;
+    while( done < blocksize && _capacity > 0 ) {
+        size_t position = _written % _capacity;
+        size_t length = std::min(blocksize - done, _capacity - position);
+        memcpy((void*) &_ring[position], (void*) &src[done], length * sizeof(int16_t));
+        done += length;
+        _written += length;
+    }
+
+    // Wake a running capture
+    if( _isCapturing ) {
+        _arrived.notify_all();
+    }
+    return blocksize;
+}
+
+bool BoomaCaptureBuffer::Capture(int seconds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if( _isCapturing ) {
+        HLog("A capture is already running from %s", _prefix.c_str());
+        return false;
+    }
+
+    // Start with the oldest sample in the history, and end the requested time after the trigger.
+    // The capture thread is waiting, so the caller (possibly the processing thread) never waits
+    // for a thread to be created or joined
+    _first = _written - std::min(_written, (uint64_t) _size);
+    _end = seconds < 0 ? UINT64_MAX : _written + ((uint64_t) seconds * _samplerate * _channels);
+    _filename = _prefix + "_" + std::to_string(std::time(nullptr)) + ".wav";
+    _isCapturing = true;
+    _arrived.notify_all();
+    return true;
+}
+
+void BoomaCaptureBuffer::CaptureThread() {
+    HLog("Capture thread for %s started", _prefix.c_str());
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while( true ) {
+        _arrived.wait(lock, [this] { return _isCapturing || _isStopping; });
+        if( !_isCapturing ) {
+            break;
+        }
+        std::string filename = _filename;
+        uint64_t first = _first;
+        lock.unlock();
+        WriteCapture(filename, first);
+        lock.lock();
+        _isCapturing = false;
+    }
+    HLog("Capture thread for %s stopped", _prefix.c_str());
+}
+
+void BoomaCaptureBuffer::WriteCapture(std::string filename, uint64_t first) {
+
+    // Written only from this thread. It may wait for the disk, the margin in the ring covers short stalls
+    BoomaAsyncFileWriter* writer = new BoomaAsyncFileWriter(GetId() + "_capture_writer", filename, true, _samplerate, nullptr, true);
+
+    // Copy chunks out of the ring, and write them without holding the lock
+    std::vector<int16_t> chunk(CAPTURE_CHUNK_SAMPLES);
+    uint64_t next = first;
+    std::unique_lock<std::mutex> lock(_mutex);
+    HLog("Capturing %lu buffered samples and the following samples to %s", (unsigned long) (_written - first), filename.c_str());
+    while( true ) {
+        _arrived.wait(lock, [this, &next] { return next < _written || next >= _end; });
+        if( next >= _end ) {
+            break;
+        }
+
+        // Skip samples that have been overwritten
+        if( _written - next > _capacity ) {
+            HError("Capture to %s fell behind, %lu samples lost", filename.c_str(), (unsigned long) (_written - _capacity - next));
+            next = _written - _capacity;
+        }
+
+        size_t position = next % _capacity;
+        size_t length = (size_t) std::min(std::min(_written, _end) - next, (uint64_t) CAPTURE_CHUNK_SAMPLES);
+        length = std::min(length, _capacity - position);
+        memcpy((void*) chunk.data(), (void*) &_ring[position], length * sizeof(int16_t));
+        next += length;
+
+        lock.unlock();
+        writer->Write(chunk.data(), length);
+        lock.lock();
+    }
+    lock.unlock();
+
+    writer->Stop();
+    delete writer;
+    HLog("Capture to %s completed", filename.c_str());
+}
+
+void BoomaCaptureBuffer::StopCapture() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if( _isCapturing ) {
+        HLog("Stopping capture to %s", _filename.c_str());
+
+        // Everything received until now is still written
+        _end = std::min(_end, _written);
+        _arrived.notify_all();
+    }
+}
+
+bool BoomaCaptureBuffer::IsCapturing() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _isCapturing;
+}
+
+std::string BoomaCaptureBuffer::GetFilename() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _filename;
+}
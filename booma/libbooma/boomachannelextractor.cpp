@@ -0,0 +1,62 @@
+#include <cstdlib>
+
+#include "boomachannelextractor.h"
+#include "booma.h"
+
+BoomaChannelExtractor::BoomaChannelExtractor(std::string id, HReader<int16_t>* reader, int samplerate, int width, int span, int center, int offset, size_t blocksize, bool isRetuneAllowed):
+        HReader<int16_t>(id),
+        _samplerate(samplerate),
+        _width(width),
+        _span(span),
+        _center(center),
+        _offset(offset),
+        _isRetuneAllowed(isRetuneAllowed),
+        _mixer(nullptr),
+        _decimator(nullptr) {
+
+    int factor = samplerate / width;
+    int taps = (factor * FIR_TAPS_PER_PHASE) - 1;
+    HLog("Extracting %d Hz channels, decimating %d -> %d with %d taps", width, samplerate, width, taps);
+    _mixer = new ChannelMixer(id + "_mixer", reader);
+    _decimator = new BoomaFirDecimator(id + "_decimator", _mixer, factor,
+                                       HLowpassKaiserBessel<int16_t>(width / 2, samplerate, taps, 96).Calculate(),
+                                       taps, blocksize, true);
+}
+
+BoomaChannelExtractor::~BoomaChannelExtractor() {
+    delete _decimator;
+    delete _mixer;
+}
+
+bool BoomaChannelExtractor::Command(HCommand* command) {
+
+    // Everything but frequency changes goes to the device
+    if( command->Class != H_COMMAND_CLASS::TUNER || command->Opcode != H_COMMAND_OPCODE::SET_FREQUENCY ) {
+        return _mixer->Command(command);
+    }
+
+    // Move the channel if it stays inside the span received by the device
+    int frequency = command->Data.Value;
+    int offset = frequency - _center;
+    if( abs(offset) + (_width / 2) <= _span ) {
+        HLog("Moving extracted channel to %d (offset %d from device center %d)", frequency, offset, _center);
+        _mixer->Oscillator.SetFrequency(-offset, _samplerate);
+        return true;
+    }
+
+    // Retune the device to the new channel
+    if( !_isRetuneAllowed ) {
+        HError("Extracted channel %d is outside the span of the shared device (center %d)", frequency, _center);
+        return false;
+    }
+    // Keep the channel off the dc spike, at the same offset as an ordinary rtl-sdr input
+    HLog("Extracted channel %d is outside the span of the device, retuning to %d", frequency, frequency - _offset);
+    HCommand retune = *command;
+    retune.Data.Value = frequency - _offset;
+    if( !_mixer->Command(&retune) ) {
+        return false;
+    }
+    _center = frequency - _offset;
+    _mixer->Oscillator.SetFrequency(-_offset, _samplerate);
+    return true;
+}
@@ -0,0 +1,131 @@
+#include "boomachannelinput.h"
+
+BoomaChannelInput::BoomaChannelInput(ConfigOptions* opts, BoomaInput* input, std::string name, long int frequency):
+        _name(name),
+        _frequency(frequency),
+        _ifFrequency(0),
+        _bin(0),
+        _channelMultiplier(nullptr),
+        _channelIqFirFilter(nullptr),
+        _channelFirFilter(nullptr),
+        _lastConsumer(nullptr) {
+
+    // Find the part of the input spectrum that contains the channel
+    _bin = input->GetChannelizerBin(opts, frequency);
+    HLog("Channel '%s' is received from input channel %d", _name.c_str(), _bin);
+
+    // The input must have been configured with a splitter for additional channels
+    if( input->GetChannelWriterConsumer(_bin) == nullptr ) {
+        HError("Input has no channel splitter, can not create channel input for '%s'", _name.c_str());
+        throw new BoomaChannelInputException("Input has no channel splitter");
+    }
+
+    // Local devices deliver the frequency 'as is', so no filtering or mixing is needed
+    if( IsLocalInput(opts) ) {
+        HLog("Local input source, channel '%s' needs no filtering", _name.c_str());
+        _ifFrequency = input->GetIfFrequency() + GetChannelOffset(opts, input);
+        _lastConsumer = input->GetChannelWriterConsumer(_bin);
+        return;
+    }
+
+    // IQ data is centered at the main frequency (or the channelizer bin), so move the channel frequency to the
+    // center of the spectrum and remove (mostly) anything outside the input filter width. Same IF as the main receiver
+    if( opts->GetOriginalInputSourceType() == RTLSDR || _bin != 0 ) {
+        HLog("Setting up channel multiplier for channel '%s' (shift %d)", _name.c_str(), 0 - GetChannelOffset(opts, input));
+        _channelMultiplier = new HIqMultiplier<int16_t>("channel_iq_multiplier", input->GetChannelWriterConsumer(_bin), opts->GetOutputSampleRate(), 0 - GetChannelOffset(opts, input), 10, BLOCKSIZE);
+        _channelIqFirFilter = new BoomaFirFilter("channel_iq_fir", _channelMultiplier->Consumer(), opts->GetInputFilterWidth() == 0
+                ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
+                : HLowpassKaiserBessel<int16_t>(opts->GetInputFilterWidth(), opts->GetOutputSampleRate(), 51, 50).Calculate(),
+                51, BLOCKSIZE, true);
+        _ifFrequency = input->GetIfFrequency();
+        _lastConsumer = _channelIqFirFilter->Consumer();
+        return;
+    }
+
+    // Realvalued data contains the channel frequency at the same distance from the IF as in the spectrum,
+    // so add a bandpass filter around the channel frequency
+    _ifFrequency = input->GetIfFrequency() + GetChannelOffset(opts, input);
+    HLog("Setting up channel bandpass filter for channel '%s' at IF %d", _name.c_str(), _ifFrequency);
+    _channelFirFilter = new BoomaFirFilter("channel_fir", input->GetChannelWriterConsumer(_bin),
+        opts->GetInputFilterWidth() == 0
+            ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
+            : HBandpassKaiserBessel<int16_t>(_ifFrequency - (opts->GetInputFilterWidth() / 2), _ifFrequency + (opts->GetInputFilterWidth() / 2), opts->GetOutputSampleRate(), 51, 50).Calculate(),
+        51, BLOCKSIZE);
+    _lastConsumer = _channelFirFilter->Consumer();
+}
+
+BoomaChannelInput::~BoomaChannelInput() {
+    SAFE_DELETE(_channelMultiplier);
+    SAFE_DELETE(_channelIqFirFilter);
+    SAFE_DELETE(_channelFirFilter);
+}
+
+bool BoomaChannelInput::IsLocalInput(ConfigOptions* opts) {
+    return opts->GetInputSourceType() == InputSourceType::NO_INPUT_SOURCE_TYPE ||
+           opts->GetInputSourceType() == InputSourceType::AUDIO_DEVICE ||
+           opts->GetInputSourceType() == InputSourceType::SIGNAL_GENERATOR ||
+           opts->GetInputSourceType() == InputSourceType::SILENCE;
+}
+
+int BoomaChannelInput::GetChannelOffset(ConfigOptions* opts, BoomaInput* input) {
+    return input->GetChannelOffset(opts, _frequency, _bin);
+}
+
+bool BoomaChannelInput::IsFrequencySupported(ConfigOptions* opts, BoomaInput* input) {
+
+    // Channel must be inside the spectrum delivered by the input
+    if( _channelMultiplier != nullptr ) {
+        return abs(GetChannelOffset(opts, input)) < opts->GetOutputSampleRate() / 2;
+    }
+    int ifFrequency = input->GetIfFrequency() + GetChannelOffset(opts, input);
+    return ifFrequency > 0 && ifFrequency < opts->GetOutputSampleRate() / 2;
+}
+
+bool BoomaChannelInput::SetFrequency(ConfigOptions* opts, BoomaInput* input) {
+
+    // The main frequency has changed, so the channel has moved relative to the input IF
+    if( !IsFrequencySupported(opts, input) ) {
+        HError("Channel '%s' at %ld is outside the input spectrum when tuned to %d", _name.c_str(), _frequency, input->GetVirtualFrequency());
+        return false;
+    }
+
+    // Move the channel to the center of the IQ spectrum
+    if( _channelMultiplier != nullptr ) {
+        HLog("Setting new shift %d for channel '%s'", 0 - GetChannelOffset(opts, input), _name.c_str());
+        _channelMultiplier->SetFrequency(0 - GetChannelOffset(opts, input));
+        _ifFrequency = input->GetIfFrequency();
+        return true;
+    }
+
+    // Move the bandpass filter (REAL input)
+    _ifFrequency = input->GetIfFrequency() + GetChannelOffset(opts, input);
+    if( _channelFirFilter != nullptr && opts->GetInputFilterWidth() != 0 ) {
+        HLog("Moving bandpass filter for channel '%s' to IF %d", _name.c_str(), _ifFrequency);
+        _channelFirFilter->SetCoefficients(HBandpassKaiserBessel<int16_t>(_ifFrequency - (opts->GetInputFilterWidth() / 2), _ifFrequency + (opts->GetInputFilterWidth() / 2), opts->GetOutputSampleRate(), 51, 50).Calculate(), 51);
+    }
+    return true;
+}
+
+bool BoomaChannelInput::SetInputFilterWidth(ConfigOptions* opts, int width) {
+
+    // Change filter width for an IQ channel filter
+    if( _channelIqFirFilter != nullptr ) {
+        HLog("Setting new filter width %d for channel '%s'", width, _name.c_str());
+        _channelIqFirFilter->SetCoefficients(width == 0
+                ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
+                : HLowpassKaiserBessel<int16_t>(width, opts->GetOutputSampleRate(), 51, 50).Calculate(), 51);
+        return true;
+    }
+
+    // Change filter width for a realvalued channel filter
+    if( _channelFirFilter != nullptr ) {
+        HLog("Setting new filter width %d for channel '%s'", width, _name.c_str());
+        _channelFirFilter->SetCoefficients(width == 0
+                ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
+                : HBandpassKaiserBessel<int16_t>(_ifFrequency - (width / 2), _ifFrequency + (width / 2), opts->GetOutputSampleRate(), 51, 50).Calculate(),
+                51);
+        return true;
+    }
+
+    return false;
+}
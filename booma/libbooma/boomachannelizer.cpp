@@ -0,0 +1,182 @@
+#include <cmath>
+
+#include "boomachannelizer.h"
+
+BoomaChannelizer::BoomaChannelizer(std::string id, HReader<int16_t>* reader, int channels, int inputRate, int cutoff, int tapsPerPhase, size_t blocksize):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _channels(channels),
+        _tapsPerPhase(tapsPerPhase),
+        _length(channels * tapsPerPhase),
+        _blocksize(blocksize),
+        _coefficients(channels * tapsPerPhase),
+        _i((channels * tapsPerPhase) - 1 + (channels * blocksize / 2), 0),
+        _q((channels * tapsPerPhase) - 1 + (channels * blocksize / 2), 0),
+        _input(nullptr),
+        _phases(channels),
+        _bins(channels),
+        _fft(channels),
+        _consumers(channels, nullptr),
+        _outputs(channels, nullptr) {
+
+    HLog("Creating polyphase channelizer with %d channels, %d taps per phase and cutoff %d at %d", channels, tapsPerPhase, cutoff, inputRate);
+    _input = new int16_t[blocksize];
+
+    // Prototype lowpass filter: windowed sinc with a Kaiser window (beta = 8, approx. 80dB stopband)
+    float beta = 8;
+    float fc = (float) cutoff / (float) inputRate;
+    float center = (float) (_length - 1) / 2;
+    float sum = 0;
+    for( int n = 0; n < _length; n++ ) {
+        float t = n - center;
+        float sinc = t == 0 ? 2 * fc : sin(2 * M_PI * fc * t) / (M_PI * t);
+        float r = (2 * n / (float) (_length - 1)) - 1;
+        _coefficients[n] = sinc * Bessel(beta * sqrt(1 - r * r)) / Bessel(beta);
+        sum += _coefficients[n];
+    }
+
+    // Unity gain in the passband
+    for( int n = 0; n < _length; n++ ) {
+        _coefficients[n] /= sum;
+    }
+}
+
+BoomaChannelizer::~BoomaChannelizer() {
+    delete[] _input;
+    for( int k = 0; k < _channels; k++ ) {
+        SAFE_DELETE(_consumers[k]);
+        if( _outputs[k] != nullptr ) {
+            delete[] _outputs[k];
+        }
+    }
+}
+
+float BoomaChannelizer::Bessel(float x) {
+
+    // Zeroth order modified Bessel function of the first kind (power series)
+    float sum = 1;
+    float term = 1;
+    for( int k = 1; k < 25; k++ ) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+HWriterConsumer<int16_t>* BoomaChannelizer::GetChannel(int bin) {
+    if( bin <= 0 || bin >= _channels ) {
+        HError("No channelizer output for bin %d (channel 0 is read from the channelizer)", bin);
+        return nullptr;
+    }
+    if( _consumers[bin] == nullptr ) {
+        _consumers[bin] = new ChannelConsumer();
+        _outputs[bin] = new int16_t[_blocksize];
+    }
+    return _consumers[bin];
+}
+
+bool BoomaChannelizer::Start() {
+    for( int k = 1; k < _channels; k++ ) {
+        if( _consumers[k] != nullptr && _consumers[k]->Writer != nullptr ) {
+            _consumers[k]->Writer->Start();
+        }
+    }
+    return _reader->Start();
+}
+
+bool BoomaChannelizer::Stop() {
+    for( int k = 1; k < _channels; k++ ) {
+        if( _consumers[k] != nullptr && _consumers[k]->Writer != nullptr ) {
+            _consumers[k]->Writer->Stop();
+        }
+    }
+    return _reader->Stop();
+}
+
+static inline int16_t Clip(float value) {
+    return value > 32767 ? 32767 : (value < -32768 ? -32768 : (int16_t) value);
+}
+
+int BoomaChannelizer::Read(int16_t* dest, size_t blocksize) {
+
+    if( blocksize != _blocksize ) {
+        HError("Channelizer read with blocksize %d, expected %d", blocksize, _blocksize);
+        return 0;
+    }
+    int n = blocksize / 2;
+    int history = _length - 1;
+
+    // Read M input blocks for one block of output, deinterleaving into the I and Q buffers
+    for( int r = 0; r < _channels; r++ ) {
+        int read = _reader->Read(_input, blocksize);
+        if( read <= 0 ) {
+            return read;
+        }
+        float* i = &_i[history + r * n];
+        float* q = &_q[history + r * n];
+        for( int j = 0; j < n; j++ ) {
+            i[j] = _input[2 * j];
+            q[j] = _input[(2 * j) + 1];
+        }
+    }
+
+    // Do we need anything but channel 0 ?
+    bool allChannels = false;
+    for( int k = 1; k < _channels; k++ ) {
+        if( _consumers[k] != nullptr && _consumers[k]->Writer != nullptr ) {
+            allChannels = true;
+            break;
+        }
+    }
+
+    for( int m = 0; m < n; m++ ) {
+
+        // Polyphase filter, one output per phase for the newest M input samples
+        int newest = history + ((m + 1) * _channels) - 1;
+        for( int p = 0; p < _channels; p++ ) {
+            float re = 0;
+            float im = 0;
+            for( int k = 0; k < _tapsPerPhase; k++ ) {
+                int tap = p + (k * _channels);
+                re += _coefficients[tap] * _i[newest - tap];
+                im += _coefficients[tap] * _q[newest - tap];
+            }
+            _phases[p] = std::complex<float>(re, im);
+        }
+
+        // Channel 0 is the plain sum of all phases. Only run the FFT if other channels are in use
+        if( !allChannels ) {
+            std::complex<float> sum = 0;
+            for( int p = 0; p < _channels; p++ ) {
+                sum += _phases[p];
+            }
+            dest[2 * m] = Clip(sum.real());
+            dest[(2 * m) + 1] = Clip(sum.imag());
+            continue;
+        }
+
+        // Modulate each phase to its channel and return to baseband
+        _fft.Inverse(&_phases[0], &_bins[0]);
+        dest[2 * m] = Clip(_bins[0].real());
+        dest[(2 * m) + 1] = Clip(_bins[0].imag());
+        for( int k = 1; k < _channels; k++ ) {
+            if( _outputs[k] != nullptr ) {
+                _outputs[k][2 * m] = Clip(_bins[k].real());
+                _outputs[k][(2 * m) + 1] = Clip(_bins[k].imag());
+            }
+        }
+    }
+
+    // Keep the newest input samples as history for the next block
+    std::copy(_i.end() - history, _i.end(), _i.begin());
+    std::copy(_q.end() - history, _q.end(), _q.begin());
+
+    // Push all other channels
+    for( int k = 1; k < _channels; k++ ) {
+        if( _consumers[k] != nullptr && _consumers[k]->Writer != nullptr ) {
+            _consumers[k]->Writer->Write(_outputs[k], blocksize);
+        }
+    }
+
+    return blocksize;
+}
@@ -0,0 +1,15 @@
+#include "boomachannelreconstructor.h"
+
+BoomaChannelReconstructor::BoomaChannelReconstructor(std::string id, HWriterConsumer<int16_t>* previous, int width, int samplerate, size_t blocksize):
+        BoomaFirInterpolator(id, previous, samplerate / width, width / 2, samplerate, 2, blocksize),
+        _samplerate(samplerate) {
+
+    HLog("Reconstructing %d Hz channels", width);
+}
+
+void BoomaChannelReconstructor::WriteBlock(int16_t* src, size_t blocksize) {
+
+    // Shift to the expected position
+    _oscillator.Mix(src, blocksize);
+    BoomaFirInterpolator::WriteBlock(src, blocksize);
+}
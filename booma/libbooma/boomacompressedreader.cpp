@@ -0,0 +1,63 @@
+#include <cstring>
+
+#include "boomacompressedreader.h"
+#include "boomainputexception.h"
+
+BoomaCompressedReader::BoomaCompressedReader(std::string id, std::string filename, int channels, int samplerate):
+        HReader<int16_t>(id),
+        _file(nullptr),
+        _channels(0),
+        _samplerate(0),
+        _position(0),
+        _isEndOfFile(false) {
+
+    _file = fopen(filename.c_str(), "rb");
+    if( _file == nullptr ) {
+        HError("Unable to open %s", filename.c_str());
+        throw new BoomaInputException("Unable to open compressed input file");
+    }
+    if( !BoomaLosslessCodec::ReadFileHeader(_file, &_channels, &_samplerate) ) {
+        HError("%s is not a BLC file", filename.c_str());
+        fclose(_file);
+        throw new BoomaInputException("Input file is not a BLC file");
+    }
+    HLog("Reading compressed file %s with %d channels at samplerate %d", filename.c_str(), _channels, _samplerate);
+
+    // The samples are given to the chain as they are, so the layout must match the configuration
+    if( _channels != channels ) {
+        HError("%s has %d channels, the configured input datatype expects %d", filename.c_str(), _channels, channels);
+        fclose(_file);
+        throw new BoomaInputException("Number of channels in the BLC file does not match the input datatype");
+    }
+    if( _samplerate != samplerate ) {
+        HError("%s has samplerate %d, the configured samplerate is %d", filename.c_str(), _samplerate, samplerate);
+        fclose(_file);
+        throw new BoomaInputException("Samplerate of the BLC file does not match the configured samplerate");
+    }
+}
+
+BoomaCompressedReader::~BoomaCompressedReader() {
+    fclose(_file);
+}
+
+int BoomaCompressedReader::Read(int16_t* dest, size_t blocksize) {
+
+    // Decompress frames until we have a full block or reach the end of the file
+    while( _samples.size() - _position < blocksize && !_isEndOfFile ) {
+        _samples.erase(_samples.begin(), _samples.begin() + _position);
+        _position = 0;
+        _isEndOfFile = !BoomaLosslessCodec::Decode(_file, _channels, &_samples);
+    }
+
+    size_t available = _samples.size() - _position;
+    if( available == 0 ) {
+        return 0;
+    }
+    size_t length = available < blocksize ? available : blocksize;
+    memcpy((void*) dest, (void*) &_samples[_position], length * sizeof(int16_t));
+    if( length < blocksize ) {
+        memset((void*) &dest[length], 0, (blocksize - length) * sizeof(int16_t));
+    }
+    _position += length;
+    return blocksize;
+}
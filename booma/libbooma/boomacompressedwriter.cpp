@@ -0,0 +1,117 @@
+#include "boomacompressedwriter.h"
+
+BoomaCompressedWriter::BoomaCompressedWriter(std::string id, std::string filename, int channels, int samplerate, HWriterConsumer<int16_t>* previous, int depth):
+        HWriter<int16_t>(id),
+        _filename(filename),
+        _channels(channels),
+        _samplerate(samplerate),
+        _depth(depth),
+        _file(nullptr),
+        _thread(nullptr),
+        _isRunning(false),
+        _samples(0),
+        _bytes(0) {
+
+    HLog("Creating compressed writer for %s with %d channels", filename.c_str(), channels);
+    previous->SetWriter(this);
+}
+
+BoomaCompressedWriter::~BoomaCompressedWriter() {
+    StopWorker();
+    if( _file != nullptr ) {
+        fclose(_file);
+    }
+}
+
+bool BoomaCompressedWriter::Start() {
+    if( _thread == nullptr ) {
+        _isRunning = true;
+        _thread = new std::thread(&BoomaCompressedWriter::WorkerThread, this);
+    }
+    return true;
+}
+
+bool BoomaCompressedWriter::Stop() {
+    StopWorker();
+    if( _file != nullptr ) {
+        fflush(_file);
+    }
+    return true;
+}
+
+void BoomaCompressedWriter::StopWorker() {
+    if( _thread != nullptr ) {
+
+        // The worker drains the queue before it stops
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isRunning = false;
+        }
+        _notEmpty.notify_all();
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+}
+
+int BoomaCompressedWriter::Write(int16_t* src, size_t blocksize) {
+
+    // The processing chain may not call Start() on its writers
+    if( _thread == nullptr ) {
+        Start();
+    }
+
+    // Wait for room in the queue, then queue a copy of the block
+    std::unique_lock<std::mutex> lock(_mutex);
+    _notFull.wait(lock, [this] { return _queue.size() < _depth; });
+    _queue.push_back(std::vector<int16_t>(src, src + blocksize));
+    lock.unlock();
+    _notEmpty.notify_one();
+
+    return blocksize;
+}
+
+void BoomaCompressedWriter::WorkerThread() {
+    HLog("Compressed writer for %s started", _filename.c_str());
+
+    std::vector<uint8_t> frame;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while( true ) {
+        _notEmpty.wait(lock, [this] { return !_queue.empty() || !_isRunning; });
+        if( _queue.empty() ) {
+            break;
+        }
+        std::vector<int16_t> block;
+        block.swap(_queue.front());
+        _queue.pop_front();
+        lock.unlock();
+        _notFull.notify_one();
+
+        // Create the file when the first block arrives
+        if( _file == nullptr ) {
+            _file = fopen(_filename.c_str(), "wb");
+            if( _file == nullptr || !BoomaLosslessCodec::WriteFileHeader(_file, _channels, _samplerate) ) {
+                HError("Unable to create compressed file %s", _filename.c_str());
+            }
+        }
+
+        // Compress and write
+        frame.clear();
+        if( _file != nullptr ) {
+            BoomaLosslessCodec::Encode(block.data(), block.size() - (block.size() % _channels), _channels, &frame);
+            if( fwrite(frame.data(), 1, frame.size(), _file) != frame.size() ) {
+                HError("Failed to write to compressed file %s", _filename.c_str());
+            }
+        }
+
+        lock.lock();
+        _samples += block.size();
+        _bytes += frame.size();
+    }
+    HLog("Compressed writer for %s stopped", _filename.c_str());
+}
+
+double BoomaCompressedWriter::GetCompressionRatio() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _samples > 0 ? (double) _bytes / (_samples * sizeof(int16_t)) : 0;
+}
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "boomacwdecoder.h"
+#include "booma.h"
+
+BoomaCwDecoder::BoomaCwDecoder(std::string id, int samplerate, std::function<void(std::string)> callback):
+        BoomaDecoder(id),
+        _callback(callback),
+        _tickLength((samplerate * CW_DECODER_TICK_MS) / 1000),
+        _tickSamples(0),
+        _tickSum(0) {
+
+    HLog("Decoding CW at samplerate %d, %d samples per tick", samplerate, _tickLength);
+    Reset();
+}
+
+void BoomaCwDecoder::Decode(int16_t* src, int blocksize) {
+    for( int i = 0; i < blocksize; i++ ) {
+        _tickSum += abs(src[i]);
+        if( ++_tickSamples < _tickLength ) {
+            continue;
+        }
+        Tick((float) _tickSum / _tickSamples);
+        _tickSum = 0;
+        _tickSamples = 0;
+    }
+}
+
+void BoomaCwDecoder::Tick(float level) {
+
+    // Without a known noise level, start both levels at the first input. The noise floor
+    // will then move down in the first gap
+    if( _signal == 0 && _noise == 0 ) {
+        _signal = level;
+        _noise = level;
+    }
+
+    // Smoothed envelope
+    _envelope += (level - _envelope) / 2;
+
+    // Peaks follows the signal up fast and decays over seconds, the noise floor does
+    // the opposite. Both decays must be slower than the longest gap between words
+    _signal += (_envelope - _signal) / (_envelope > _signal ? 4 : 1500);
+    _noise += (_envelope - _noise) / (_envelope < _noise ? 4 : 1500);
+
+    // Key state, with hysteresis around the middle. No key without a clear signal
+    float span = _signal - _noise;
+    float threshold = _noise + (span * (_isMark ? 0.4f : 0.6f));
+    Track(_signal > _noise * 2 && _envelope > threshold);
+}
+
+void BoomaCwDecoder::Reset(float noise) {
+    _envelope = 0;
+    _signal = 0;
+    _noise = noise;
+    _isMark = false;
+    _ticks = 0;
+    _previous = 0;
+    _dot = 1200.0f / (20 * CW_DECODER_TICK_MS);
+    _lastMark = 0;
+    _symbol = 1;
+    _isWord = false;
+}
+
+void BoomaCwDecoder::Track(bool isMark) {
+
+    // States shorter than a quarter dot are noise (or a dropout) and merged into the previous state
+    int glitch = std::max(1, (int) (_dot / 4));
+    if( isMark != _isMark ) {
+        if( _ticks < glitch ) {
+            _ticks += _previous + 1;
+            _previous = 0;
+        } else {
+            _previous = _ticks;
+            _ticks = 1;
+        }
+        _isMark = isMark;
+    } else {
+        _ticks++;
+    }
+    if( _isMark || _ticks < glitch ) {
+        return;
+    }
+
+    // A space has started, add the mark before it
+    if( _previous > 0 ) {
+        AddElement(_previous);
+        _previous = 0;
+    }
+
+    // Characters end after 3 dots of space, words after 7 dots
+    if( _symbol > 1 && _ticks > 2 * _dot ) {
+        const std::string& alphabet = GetAlphabet();
+        char c = _symbol < (int) alphabet.size() ? alphabet.at(_symbol) : ' ';
+        Emit(std::string(1, c == ' ' ? '*' : c));
+        _symbol = 1;
+        _isWord = true;
+    }
+    if( _isWord && _ticks > 5 * _dot ) {
+        Emit(" ");
+        _isWord = false;
+    }
+}
+
+void BoomaCwDecoder::AddElement(int length) {
+
+    // Dashes are 3 dots long. A mark more than twice as long as the previous mark (or less than
+    // half as long) gives both a dot and a dash, which recovers the speed after a large change
+    bool isDash;
+    if( _lastMark > 0 && length > 2 * _lastMark ) {
+        isDash = true;
+        _dot = (_dot + ((_lastMark + (length / 3.0f)) / 2)) / 2;
+    } else if( _lastMark > 0 && 2 * length < _lastMark ) {
+        isDash = false;
+        _dot = (_dot + ((length + (_lastMark / 3.0f)) / 2)) / 2;
+    } else {
+        isDash = length > 2 * _dot;
+        _dot = ((3 * _dot) + (isDash ? length / 3.0f : length)) / 4;
+    }
+    _dot = std::max(_dot, 1200.0f / (CW_DECODER_MAX_WPM * CW_DECODER_TICK_MS));
+    _dot = std::min(_dot, 1200.0f / (CW_DECODER_MIN_WPM * CW_DECODER_TICK_MS));
+    _lastMark = length;
+
+    // Move down the morse tree, anything longer than the tree is an unknown character
+    if( _symbol < 128 ) {
+        _symbol = (_symbol * 2) + (isDash ? 1 : 0);
+    }
+}
+
+void BoomaCwDecoder::Emit(std::string text) {
+    if( _callback ) {
+        _callback(text);
+    }
+}
+
+int BoomaCwDecoder::GetWpm() {
+    return (int) ((1200 / (_dot * CW_DECODER_TICK_MS)) + 0.5f);
+}
+
+int BoomaCwDecoder::GetSnr() {
+    return _noise > 0 && _signal > _noise ? (int) (20 * log10(_signal / _noise)) : 0;
+}
+
+int BoomaCwDecoder::GetIdleMilliseconds() {
+    return _isMark ? 0 : _ticks * CW_DECODER_TICK_MS;
+}
+
+const std::string& BoomaCwDecoder::GetAlphabet() {
+
+    // Characters placed in a binary tree, starting at position 1 and going to 2n for a
+    // dot and 2n+1 for a dash. Unknown sequences are left as spaces
+    static const std::string alphabet = []() {
+        const char* codes[][2] = {
+            {".-", "A"}, {"-...", "B"}, {"-.-.", "C"}, {"-..", "D"}, {".", "E"}, {"..-.", "F"},
+            {"--.", "G"}, {"....", "H"}, {"..", "I"}, {".---", "J"}, {"-.-", "K"}, {".-..", "L"},
+            {"--", "M"}, {"-.", "N"}, {"---", "O"}, {".--.", "P"}, {"--.-", "Q"}, {".-.", "R"},
+            {"...", "S"}, {"-", "T"}, {"..-", "U"}, {"...-", "V"}, {".--", "W"}, {"-..-", "X"},
+            {"-.--", "Y"}, {"--..", "Z"}, {"-----", "0"}, {".----", "1"}, {"..---", "2"},
+            {"...--", "3"}, {"....-", "4"}, {".....", "5"}, {"-....", "6"}, {"--...", "7"},
+            {"---..", "8"}, {"----.", "9"}, {".-.-.-", "."}, {"--..--", ","}, {"..--..", "?"},
+            {"-..-.", "/"}, {"-...-", "="}, {".-.-.", "+"}, {"-....-", "-"}, {"-.--.", "("},
+            {"-.--.-", ")"}, {".----.", "'"}, {"---...", ":"}, {".--.-.", "@"}
+        };
+        std::string tree(128, ' ');
+        for( auto code : codes ) {
+            int position = 1;
+            for( const char* element = code[0]; *element != '\0'; element++ ) {
+                position = (position * 2) + (*element == '-' ? 1 : 0);
+            }
+            tree[position] = code[1][0];
+        }
+        return tree;
+    }();
+    return alphabet;
+}
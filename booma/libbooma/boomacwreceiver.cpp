@@ -1,56 +1,5 @@
 #include "boomacwreceiver.h"
 
-float BoomaCwReceiver::_bandpassCoeffs[6][20] =
-{
-    // 50 Hz @ 6KHz
-    {
-        0.002048572294543357, 0.004097144589086714, 0.002048572294543357, 1.408067592516551, -0.9938554560160351,// b0, b1, b2, a1, a2
-        0.0078125, -0.015625, 0.0078125, 1.4116734879341142, -0.9938710552646586,// b0, b1, b2, a1, a2
-        0.0009765625, 0.001953125, 0.0009765625, 1.408045459371766, -0.9974456925740307,// b0, b1, b2, a1, a2
-        0.0078125, -0.015625, 0.0078125, 1.4167508604593735, -0.9974613476810194// b0, b1, b2, a1, a2
-    },
-
-    // 100 Hz @ 6KHz
-    {
-        0.0033509644355716028, 0.0067019288711432055, 0.0033509644355716028, 1.4026434633408733, -0.9883093940592698,// b0, b1, b2, a1, a2
-        0.015625, -0.03125, 0.015625, 1.4095146965221208, -0.9883657437885459,// b0, b1, b2, a1, a2
-        0.001953125, 0.00390625, 0.001953125, 1.4025641509285973, -0.9951244773940543,// b0, b1, b2, a1, a2
-        0.015625, -0.03125, 0.015625, 1.4191527482568658, -0.9951812092261056// b0, b1, b2, a1, a2
-    },
-
-    // 200 Hz @ 6KHz
-    {
-        0.007439398273347204, 0.014878796546694408, 0.007439398273347204, 1.3903155004925956, -0.9759828267704111,// b0, b1, b2, a1, a2
-        0.03125, -0.0625, 0.03125, 1.4044836752325582, -0.9762194821504804,// b0, b1, b2, a1, a2
-        0.00390625, 0.0078125, 0.00390625, 1.3899786395895477, -0.9899122406330527,// b0, b1, b2, a1, a2
-        0.03125, -0.0625, 0.03125, 1.4241834185016982, -0.9901521572645293// b0, b1, b2, a1, a2
-    },
-
-    // 500 Hz @ 6KHz
-    {
-        0.01472079702256931, 0.02944159404513862, 0.01472079702256931, 1.3578013970831393, -0.9429178695624337,// b0, b1, b2, a1, a2
-        0.125, -0.25, 0.125, 1.3918033585781613, -0.9442389046006642,// b0, b1, b2, a1, a2
-        0.0078125, 0.015625, 0.0078125, 1.3559075775374545, -0.9755717421203991,// b0, b1, b2, a1, a2
-        0.0625, -0.125, 0.0625, 1.437988425774804, -0.9769347083141211// b0, b1, b2, a1, a2
-    },
-
-    // 1  KHz @ 6KHz
-    {
-        0.03309018753561541, 0.06618037507123083, 0.03309018753561541, 1.2999716556158074, -0.8820266316104814,// b0, b1, b2, a1, a2
-        0.25, -0.5, 0.25, 1.3714944005456748, -0.8875762227807565,// b0, b1, b2, a1, a2
-        0.015625, 0.03125, 0.015625, 1.2920291704550972, -0.9478234710900391,// b0, b1, b2, a1, a2
-        0.125, -0.25, 0.125, 1.46455173397263, -0.9537131436046499// b0, b1, b2, a1, a2
-    },
-
-    // 3 KHz @ 6KHz
-    {
-            0.1194878224582199, 0.2389756449164398, 0.1194878224582199, 1.1052801524695883, -0.670102919351549,// b0, b1, b2, a1, a2
-            0.5, -1, 0.5, 1.3208341719229677, -0.712714773030205,// b0, b1, b2, a1, a2
-            0.0625, 0.125, 0.0625, 1.0466041855109196, -0.8394505074497361,// b0, b1, b2, a1, a2
-            0.25, -0.5, 0.25, 1.5573059390887027, -0.8869145132418825// b0, b1, b2, a1, a2
-    }
-};
-
 int BoomaCwReceiver::_bandpassWidths[] =
 {
     50,
@@ -61,15 +10,6 @@ int BoomaCwReceiver::_bandpassWidths[] =
     3000
 };
 
-float BoomaCwReceiver::_cwCoeffs[] =
-{
-    // 400 Hz @ 1000 Hz
-    0.001780904520508367, 0.003561809041016734, 0.001780904520508367, 1.9305185311207878, -0.9492636159174858,// b0, b1, b2, a1, a2
-    0.5, -1, 0.5, 1.9427984657253758, -0.9565053806179769,// b0, b1, b2, a1, a2
-    0.001953125, 0.00390625, 0.001953125, 1.953016385053386, -0.9766112182691846,// b0, b1, b2, a1, a2
-    0.25, -0.5, 0.25, 1.9726460120356664, -0.9838372084850454// b0, b1, b2, a1, a2
-};
-
 BoomaCwReceiver::BoomaCwReceiver(ConfigOptions* opts, int initialFrequency):
         BoomaReceiver(opts, initialFrequency),
         _humfilter(nullptr),
@@ -80,7 +20,11 @@ BoomaCwReceiver::BoomaCwReceiver(ConfigOptions* opts, int initialFrequency):
         _ifFilter(nullptr),
         _beatToneMixer(nullptr),
         _postSelect(nullptr),
-        _passbandGain(nullptr) {
+        _passbandGain(nullptr),
+        _ifDecimator(nullptr),
+        _interpolator(nullptr),
+        _internalRate(0),
+        _internalIf(0) {
 
         std::vector<OptionValue> bandwidthValues {
             OptionValue {"50", "Narrow CW IF filter at 50Hz", 0},
@@ -125,6 +69,9 @@ BoomaCwReceiver::BoomaCwReceiver(ConfigOptions* opts, int initialFrequency):
                 OptionValue {"8", "Passband gain factor 6", 8},
                 OptionValue {"9", "Passband gain factor 6", 9},
                 OptionValue {"10", "Passband gain factor 6", 10},};
+        std::vector<OptionValue> lowRateValues {
+                OptionValue {"Off", "Filter at the output samplerate", 0},
+                OptionValue {"On", "Filter at a low internal samplerate (restart the receiver to change)", 1}};
 
         Option bandwidthOption {
             "Bandwidth",
@@ -157,12 +104,20 @@ BoomaCwReceiver::BoomaCwReceiver(ConfigOptions* opts, int initialFrequency):
                 4
         };
 
+        Option lowRateOption {
+                "LowRate",
+                "Decimate before the narrow filters",
+                lowRateValues,
+                0
+        };
+
         // Register options
         RegisterOption(bandwidthOption);
         RegisterOption(beattoneOption);
         RegisterOption(ifshiftOption);
         RegisterOption(passbandGainOption);
         RegisterOption(iqPassbandGainOption);
+        RegisterOption(lowRateOption);
     }
 
 HWriterConsumer<int16_t>* BoomaCwReceiver::PreProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
@@ -187,26 +142,26 @@ HWriterConsumer<int16_t>* BoomaCwReceiver::PreProcess(ConfigOptions* opts, HWrit
         // Gain after preselect filtering
         _passbandGain = new HGain<int16_t>("cw_receiver_pre_process_gain", _preselect->Consumer(), GetOption("PassbandGain"), BLOCKSIZE);
 
-        // Mix down to IF frequency = 6000Hz
+        // Mix down to the IF frequency
         HLog("- IF Mixer");
-        _ifMixer = new HMultiplier<int16_t>("cw_receiver_pre_process_if_mixer", _passbandGain->Consumer(), opts->GetOutputSampleRate(), GetFrequency() - 6000 + offset, 10, BLOCKSIZE);
+        _ifMixer = new HMultiplier<int16_t>("cw_receiver_pre_process_if_mixer", _passbandGain->Consumer(), opts->GetOutputSampleRate(), GetFrequency() - GetIfFrequency(opts) + offset, 10, BLOCKSIZE);
 
-        // Return signal at IF = 6KHz
+        // Return signal at IF
         return _ifMixer->Consumer();
     }
 
     // If we get iq data, then the input spectrum is centered with the tuned frequency at 0
-    // so we need to move the (positive) frequency of interest to the IF frequency = 6KHz and
+    // so we need to move the (positive) frequency of interest to the IF frequency (6KHz) and
     // convert to realvalued samples at the output samplerate.
     // We do not need to filter away other frequencies, that is handled by the receivers IF filter.
     // Also, since we are decimating IQ samples, there will be nothing outside +- 3KHz, so by
-    // moving the center to 6KHz, we translate all negative frequencies to positive.
+    // moving the center to the IF, we translate all negative frequencies to positive.
     if( opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ||
             opts->GetInputSourceDataType() == I_INPUT_SOURCE_DATA_TYPE ||
             opts->GetInputSourceDataType() == Q_INPUT_SOURCE_DATA_TYPE) {
 
-        // Move the center frequency up to 6KHz which is the IF frequency
-        _iqMultiplier = new HIqMultiplier<int16_t>("cw_receiver_iq_multiplier", previous, opts->GetOutputSampleRate(), 6000, 10, BLOCKSIZE);
+        // Move the center frequency up to the IF frequency
+        _iqMultiplier = new HIqMultiplier<int16_t>("cw_receiver_iq_multiplier", previous, opts->GetOutputSampleRate(), GetIfFrequency(opts), 10, BLOCKSIZE);
 
         // Get the I branch ==> convert to realvalued samples
         _iq2IConverter = new HIq2IConverter<int16_t>("cw_receiver_iq_2_i_converter", _iqMultiplier->Consumer(), BLOCKSIZE);
@@ -214,7 +169,7 @@ HWriterConsumer<int16_t>* BoomaCwReceiver::PreProcess(ConfigOptions* opts, HWrit
         // Gain after converting to realvalued samples
         _passbandGain = new HGain<int16_t>("cw_receiver_iq_to_real_value_converter", _iq2IConverter->Consumer(), GetOption("IQPassbandGain"), BLOCKSIZE);
 
-        // Return signal at IF = 6KHz
+        // Return signal at IF
         return _passbandGain->Consumer();
     }
 
@@ -229,24 +184,67 @@ HWriterConsumer<int16_t>* BoomaCwReceiver::Receive(ConfigOptions* opts, HWriterC
     int offset = GetIfOffset();
     HLog("IF mixer offset due to IF shift set to %dHz", offset);
 
-    // Narrow if filter consisting of a number of cascaded 2. order bandpass filters
+    // Move the IF to a low samplerate before the narrow filters, if enabled. The narrow filters
+    // then process a fraction of the samples, and the decimator only calculates the samples kept.
+    // The decimator places the IF right at the beattone, so there is no beattone mixer
+    _internalRate = opts->GetOutputSampleRate();
+    _internalIf = GetIfFrequency(opts);
+    size_t blocksize = BLOCKSIZE;
+    int factor = GetOption("LowRate") == 1 ? GetLowRateFactor(opts) : 0;
+    if( factor > 1 ) {
+        HLog("- IF decimator");
+        _ifDecimator = new BoomaIfDecimator("cw_receiver_receive_if_decimator", previous, _internalIf, opts->GetOutputSampleRate(), factor);
+        _internalRate = _ifDecimator->GetSamplerate();
+        _internalIf = GetOption("Beattone") + offset;
+        _ifDecimator->SetShift(_internalIf);
+        blocksize = _ifDecimator->GetBlocksize(BLOCKSIZE);
+        previous = _ifDecimator->Consumer();
+    }
+
+    // Narrow if filter consisting of a number of cascaded 2. order bandpass filters,
+    // designed for the IF and the internal samplerate
     HLog("- IF filter");
-    _ifFilter = new HCascadedBiQuadFilter<int16_t>("cw_receiver_receive_biquad", previous, _bandpassCoeffs[GetOption("Bandwidth")], 20, BLOCKSIZE);
+    _ifFilter = new HCascadedBiQuadFilter<int16_t>("cw_receiver_receive_biquad", previous, GetIfCoefficients(), BoomaBiQuadDesigner::Coefficients, blocksize);
+    previous = _ifFilter->Consumer();
 
     // Mix down to the output frequency.
-    // 6000Hz - 5160Hz = 840Hz
-    HLog("- Beat tone mixer");
-    _beatToneMixer = new HMultiplier<int16_t>("cw_receiver_receive_beat_tone_mixer", _ifFilter->Consumer(), opts->GetOutputSampleRate(), 6000 - GetOption("Beattone") - offset, 10, BLOCKSIZE);
+    // IF 6000Hz - 5160Hz = 840Hz
+    if( _ifDecimator == nullptr ) {
+        HLog("- Beat tone mixer");
+        _beatToneMixer = new HMultiplier<int16_t>("cw_receiver_receive_beat_tone_mixer", previous, _internalRate, _internalIf - GetOption("Beattone") - offset, 10, blocksize);
+        previous = _beatToneMixer->Consumer();
+    }
 
     // Smoother bandpass filter (2 stacked biquads) to remove artifacts from the very narrow detector
     // filter above
     HLog("- Output filter");
-    _postSelect = new HCascadedBiQuadFilter<int16_t>("cw_receiver_receive_output_filter", _beatToneMixer->Consumer(), _cwCoeffs, 20, BLOCKSIZE);
+    _postSelect = new HCascadedBiQuadFilter<int16_t>("cw_receiver_receive_output_filter", previous, GetOutputCoefficients(), BoomaBiQuadDesigner::Coefficients, blocksize);
+
+    // Back to the output samplerate
+    if( _ifDecimator != nullptr ) {
+        HLog("- Interpolator");
+        _interpolator = new BoomaFirInterpolator("cw_receiver_receive_interpolator", _postSelect->Consumer(), factor, (_internalRate * 45) / 100, opts->GetOutputSampleRate(), 1, BLOCKSIZE);
+        return _interpolator->Consumer();
+    }
 
     // End of receiver
     return _postSelect->Consumer();
 }
 
+int BoomaCwReceiver::GetLowRateFactor(ConfigOptions* opts) {
+
+    // Largest factor giving a whole internal samplerate of at least CW_LOW_RATE, that can be divided by 4 (for the low IF)
+    int rate = opts->GetOutputSampleRate();
+    for( int factor = rate / CW_LOW_RATE; factor > 1; factor-- ) {
+        if( rate % factor == 0 && (rate / factor) % 4 == 0 ) {
+            HLog("Using internal samplerate %d for the narrow filters", rate / factor);
+            return factor;
+        }
+    }
+    HLog("Output samplerate %d is too low for a lower internal samplerate", rate);
+    return 0;
+}
+
 HWriterConsumer<int16_t>* BoomaCwReceiver::PostProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
     HLog("Creating CW receiver postprocessing chain");
 
@@ -263,13 +261,15 @@ BoomaCwReceiver::~BoomaCwReceiver() {
     SAFE_DELETE(_ifFilter);
     SAFE_DELETE(_beatToneMixer);
     SAFE_DELETE(_postSelect);
+    SAFE_DELETE(_ifDecimator);
+    SAFE_DELETE(_interpolator);
 }
 
 bool BoomaCwReceiver::SetInternalFrequency(ConfigOptions* opts, int frequency) {
 
-    // This receiver only operates from 6000 - samplerate/2. Or exactly on o (zero, IQ devices)
+    // This receiver only operates from IF - samplerate/2. Or exactly on o (zero, IQ devices)
     if( !IsFrequencySupported(opts, frequency) ) {
-        HError("Unsupported frequency %ld, must be greater than  %d and less than %d or zero", frequency, 6000, opts->GetOutputSampleRate() / 2);
+        HError("Unsupported frequency %ld, must be greater than  %d and less than %d or zero", frequency, GetIfFrequency(opts), opts->GetOutputSampleRate() / 2);
         return false;
     }
 
@@ -282,7 +282,7 @@ bool BoomaCwReceiver::SetInternalFrequency(ConfigOptions* opts, int frequency) {
         _preselect->SetCoefficients(frequency + offset, opts->GetOutputSampleRate(), 1.0f, 1, BLOCKSIZE);
     }
     if( _ifMixer != nullptr ) {
-        _ifMixer->SetFrequency(frequency - 6000 + offset);
+        _ifMixer->SetFrequency(frequency - GetIfFrequency(opts) + offset);
     }
 
     // Ready
@@ -291,6 +291,9 @@ bool BoomaCwReceiver::SetInternalFrequency(ConfigOptions* opts, int frequency) {
 
 void BoomaCwReceiver::OptionChanged(ConfigOptions* opts, std::string name, int value) {
     HLog("Option %s has changed to value %d", name.c_str(), value);
+    if( name == "LowRate" ) {
+        HLog("Changing between the low rate and the full rate path takes effect when the receiver is restarted");
+    }
 
     // Calculate mixer offsets due to if filter shifting
     int offset = GetIfOffset();
@@ -301,11 +304,19 @@ void BoomaCwReceiver::OptionChanged(ConfigOptions* opts, std::string name, int v
         _preselect->SetCoefficients(GetFrequency() + offset, opts->GetOutputSampleRate(), 1.0f, 1, BLOCKSIZE);
     }
     if( _ifMixer != nullptr ) {
-        _ifMixer->SetFrequency(GetFrequency() - 6000 + offset);
+        _ifMixer->SetFrequency(GetFrequency() - GetIfFrequency(opts) + offset);
     }
 
-    _ifFilter->SetCoefficients(_bandpassCoeffs[GetOption("Bandwidth")], 20);
-    _beatToneMixer->SetFrequency(6000 - GetOption("Beattone") - offset);
+    // Designs are cached, so switching between bandwidths only swaps the coefficients.
+    // On the low rate path, the IF follows the beattone
+    if( _ifDecimator != nullptr ) {
+        _internalIf = GetOption("Beattone") + offset;
+        _ifDecimator->SetShift(_internalIf);
+    }
+    _ifFilter->SetCoefficients(GetIfCoefficients(), BoomaBiQuadDesigner::Coefficients);
+    if( _beatToneMixer != nullptr ) {
+        _beatToneMixer->SetFrequency(_internalIf - GetOption("Beattone") - offset);
+    }
 
     if( _preselect != nullptr ) {
         _passbandGain->SetGain(GetOption("PassbandGain"));
@@ -0,0 +1,143 @@
+#include <cstring>
+
+#include "boomafanout.h"
+
+BoomaFanoutReader::BoomaFanoutReader(std::string id, HReader<int16_t>* source, int blocks, size_t blocksize):
+        HReader<int16_t>(id),
+        _source(source),
+        _blocksize(blocksize),
+        _head(0),
+        _count(0),
+        _isEnd(false),
+        _isDropping(false),
+        _dropped(0) {
+
+    for( int i = 0; i < blocks; i++ ) {
+        _blocks.push_back(new int16_t[blocksize]);
+        _lengths.push_back(0);
+    }
+}
+
+BoomaFanoutReader::~BoomaFanoutReader() {
+    for( std::vector<int16_t*>::iterator it = _blocks.begin(); it != _blocks.end(); it++ ) {
+        delete[] *it;
+    }
+}
+
+void BoomaFanoutReader::Push(int16_t* src, int length) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Make room by dropping the oldest block
+    if( _count == _blocks.size() ) {
+        if( !_isDropping ) {
+            HLog("Client %s does not keep up, dropping blocks", GetId().c_str());
+            _isDropping = true;
+        }
+        _head = (_head + 1) % _blocks.size();
+        _count--;
+        _dropped++;
+    } else if( _isDropping && _count == 0 ) {
+        HLog("Client %s has caught up after %lu dropped blocks", GetId().c_str(), _dropped);
+        _isDropping = false;
+    }
+
+    size_t position = (_head + _count) % _blocks.size();
+    memcpy((void*) _blocks[position], (void*) src, length * sizeof(int16_t));
+    _lengths[position] = length;
+    _count++;
+    _available.notify_one();
+}
+
+int BoomaFanoutReader::Read(int16_t* dest, size_t blocksize) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _available.wait(lock, [this] { return _count > 0 || _isEnd; });
+    if( _count == 0 ) {
+        return 0;
+    }
+
+    int length = _lengths[_head] < (int) blocksize ? _lengths[_head] : blocksize;
+    memcpy((void*) dest, (void*) _blocks[_head], length * sizeof(int16_t));
+    _head = (_head + 1) % _blocks.size();
+    _count--;
+    return length;
+}
+
+void BoomaFanoutReader::End() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isEnd = true;
+    _available.notify_all();
+}
+
+unsigned long BoomaFanoutReader::GetDropped() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _dropped;
+}
+
+unsigned long BoomaFanoutReader::GetQueueDepth() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _count;
+}
+
+BoomaFanout::BoomaFanout(std::string id, HReader<int16_t>* source, size_t blocksize, bool* isTerminated):
+        _id(id),
+        _source(source),
+        _blocksize(blocksize),
+        _isTerminated(isTerminated),
+        _thread(nullptr),
+        _isRunning(false) {}
+
+BoomaFanout::~BoomaFanout() {
+    Stop();
+    for( std::vector<BoomaFanoutReader*>::iterator it = _clients.begin(); it != _clients.end(); it++ ) {
+        delete *it;
+    }
+}
+
+BoomaFanoutReader* BoomaFanout::AddClient(int blocks) {
+    BoomaFanoutReader* client = new BoomaFanoutReader(_id + "_client_" + std::to_string(_clients.size()), _source, blocks, _blocksize);
+    _clients.push_back(client);
+    return client;
+}
+
+bool BoomaFanout::Start() {
+    if( _thread != nullptr ) {
+        return true;
+    }
+    HLog("Starting %s with %d clients", _id.c_str(), (int) _clients.size());
+    if( !_source->Start() ) {
+        HError("Failed to start the shared input");
+        return false;
+    }
+    _isRunning = true;
+    _thread = new std::thread(&BoomaFanout::ReaderThread, this);
+    return true;
+}
+
+bool BoomaFanout::Stop() {
+    if( _thread == nullptr ) {
+        return true;
+    }
+    _isRunning = false;
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    return _source->Stop();
+}
+
+void BoomaFanout::ReaderThread() {
+    int16_t* block = new int16_t[_blocksize];
+    while( _isRunning && !*_isTerminated ) {
+        int length = _source->Read(block, _blocksize);
+        if( length <= 0 ) {
+            HLog("End of shared input");
+            break;
+        }
+        for( std::vector<BoomaFanoutReader*>::iterator it = _clients.begin(); it != _clients.end(); it++ ) {
+            (*it)->Push(block, length);
+        }
+    }
+    for( std::vector<BoomaFanoutReader*>::iterator it = _clients.begin(); it != _clients.end(); it++ ) {
+        (*it)->End();
+    }
+    delete[] block;
+}
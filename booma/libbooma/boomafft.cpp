@@ -0,0 +1,90 @@
+#include <cmath>
+
+#include "boomafft.h"
+
+BoomaFft::BoomaFft(int size):
+        _size(size),
+        _twiddles(size),
+        _scratch(size) {
+
+    // Factorize, radix 2 first since that has the cheapest butterfly
+    int n = size;
+    while( n % 2 == 0 && n > 1 ) {
+        _factors.push_back(2);
+        n /= 2;
+    }
+    for( int p = 3; n > 1; p += 2 ) {
+        while( n % p == 0 ) {
+            _factors.push_back(p);
+            n /= p;
+        }
+    }
+    if( _factors.empty() ) {
+        _factors.push_back(1);
+    }
+
+    // Forward twiddles, inverse transforms use the conjugate
+    for( int i = 0; i < size; i++ ) {
+        double phase = -2.0 * M_PI * i / size;
+        _twiddles[i] = std::complex<float>(cos(phase), sin(phase));
+    }
+}
+
+void BoomaFft::Forward(const std::complex<float>* in, std::complex<float>* out) {
+    Transform(out, in, 1, 0, false);
+}
+
+void BoomaFft::Inverse(const std::complex<float>* in, std::complex<float>* out) {
+    Transform(out, in, 1, 0, true);
+}
+
+void BoomaFft::Transform(std::complex<float>* out, const std::complex<float>* in, int fstride, int factor, bool inverse) {
+
+    // Length of each of the p sub-transforms at this stage
+    int p = _factors[factor];
+    int m = _size / (fstride * p);
+
+    // Decimation in time: transform each of the p interleaved subsequences
+    if( m == 1 ) {
+        for( int i = 0; i < p; i++ ) {
+            out[i] = in[i * fstride];
+        }
+    } else {
+        for( int i = 0; i < p; i++ ) {
+            Transform(out + i * m, in + i * fstride, fstride * p, factor + 1, inverse);
+        }
+    }
+
+    // Combine the sub-transforms
+    if( p == 2 ) {
+        Butterfly2(out, fstride, m, inverse);
+    } else if( p > 2 ) {
+        ButterflyGeneric(out, fstride, p, m, inverse);
+    }
+}
+
+void BoomaFft::Butterfly2(std::complex<float>* out, int fstride, int m, bool inverse) {
+    for( int k = 0; k < m; k++ ) {
+        std::complex<float> t = out[k + m] * Twiddle(k * fstride, inverse);
+        out[k + m] = out[k] - t;
+        out[k] += t;
+    }
+}
+
+void BoomaFft::ButterflyGeneric(std::complex<float>* out, int fstride, int p, int m, bool inverse) {
+    for( int u = 0; u < m; u++ ) {
+        for( int q = 0; q < p; q++ ) {
+            _scratch[q] = out[u + q * m];
+        }
+        for( int q1 = 0; q1 < p; q1++ ) {
+            int k = u + q1 * m;
+            int index = 0;
+            out[k] = _scratch[0];
+            for( int q = 1; q < p; q++ ) {
+                index += fstride * k;
+                index %= _size;
+                out[k] += _scratch[q] * Twiddle(index, inverse);
+            }
+        }
+    }
+}
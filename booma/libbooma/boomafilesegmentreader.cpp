@@ -0,0 +1,87 @@
+#include <cstring>
+
+#include "boomafilesegmentreader.h"
+#include "boomainputexception.h"
+
+BoomaFileSegmentReader::BoomaFileSegmentReader(std::string id, std::string filename, long offset, long length):
+        HReader<int16_t>(id),
+        _file(nullptr),
+        _remaining(length) {
+
+    HLog("Creating file segment reader for %ld samples at offset %ld in %s", length, offset, filename.c_str());
+    _file = fopen(filename.c_str(), "rb");
+    if( _file == nullptr || fseek(_file, offset, SEEK_SET) != 0 ) {
+        HError("Unable to open %s at offset %ld", filename.c_str(), offset);
+        if( _file != nullptr ) {
+            fclose(_file);
+        }
+        throw new BoomaInputException("Unable to open input file segment");
+    }
+}
+
+BoomaFileSegmentReader::~BoomaFileSegmentReader() {
+    fclose(_file);
+}
+
+int BoomaFileSegmentReader::Read(int16_t* dest, size_t blocksize) {
+    if( _remaining <= 0 ) {
+        return 0;
+    }
+
+    // Read the next block, padding the last (partial) block with zeros
+    size_t length = _remaining < (long) blocksize ? _remaining : blocksize;
+    size_t read = fread((void*) dest, sizeof(int16_t), length, _file);
+    if( read == 0 ) {
+        HLog("Unexpected end of file with %ld samples remaining in the segment", _remaining);
+        _remaining = 0;
+        return 0;
+    }
+    if( read < blocksize ) {
+        memset((void*) &dest[read], 0, (blocksize - read) * sizeof(int16_t));
+    }
+    _remaining = read < length ? 0 : _remaining - read;
+    return blocksize;
+}
+
+bool BoomaFileSegmentReader::GetLayout(std::string filename, bool isWav, long* offset, long* length) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if( file == nullptr ) {
+        HError("Unable to open %s", filename.c_str());
+        return false;
+    }
+
+    // Pcm files contains nothing but samples
+    if( !isWav ) {
+        fseek(file, 0, SEEK_END);
+        *offset = 0;
+        *length = ftell(file) / sizeof(int16_t);
+        fclose(file);
+        return true;
+    }
+
+    // Find the 'data' chunk following the RIFF/WAVE header
+    char header[12];
+    if( fread(header, 1, 12, file) != 12 || strncmp(header, "RIFF", 4) != 0 || strncmp(&header[8], "WAVE", 4) != 0 ) {
+        HError("%s is not a wav file", filename.c_str());
+        fclose(file);
+        return false;
+    }
+    char chunk[8];
+    while( fread(chunk, 1, 8, file) == 8 ) {
+        uint32_t size = (uint8_t) chunk[4] | ((uint8_t) chunk[5] << 8) | ((uint8_t) chunk[6] << 16) | ((uint32_t) (uint8_t) chunk[7] << 24);
+        if( strncmp(chunk, "data", 4) == 0 ) {
+
+            // Recordings that was not closed properly may have a wrong data size
+            *offset = ftell(file);
+            fseek(file, 0, SEEK_END);
+            long available = ftell(file) - *offset;
+            *length = (size > 0 && size <= available ? size : available) / sizeof(int16_t);
+            fclose(file);
+            return true;
+        }
+        fseek(file, size + (size & 1), SEEK_CUR);
+    }
+    HError("No data chunk found in %s", filename.c_str());
+    fclose(file);
+    return false;
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+
+#include "boomafirdecimator.h"
+
+BoomaFirDecimator::BoomaFirDecimator(std::string id, HReader<int16_t>* reader, int factor, float* coefficients, int length, size_t blocksize, bool isIq):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _kernel(coefficients, length),
+        _factor(factor),
+        _isIq(isIq),
+        _blocksize(blocksize),
+        _input(nullptr),
+        _available(0),
+        _next(0) {
+
+    HLog("Using %s fir kernel with %d taps for decimation by %d (%s)", BoomaFirKernel::GetImplementation().c_str(), _kernel.GetLength(), factor, isIq ? "IQ" : "REAL");
+    _input = new int16_t[blocksize];
+    int samples = isIq ? blocksize / 2 : blocksize;
+    _i.assign(_kernel.GetLength() - 1 + samples, 0);
+    _q.assign(isIq ? _kernel.GetLength() - 1 + samples : 0, 0);
+}
+
+BoomaFirDecimator::~BoomaFirDecimator() {
+    delete[] _input;
+}
+
+bool BoomaFirDecimator::ReadInput() {
+    int history = _kernel.GetLength() - 1;
+
+    // Move the newest samples to the history part
+    if( _available > 0 ) {
+        std::copy(_i.begin() + _available, _i.begin() + _available + history, _i.begin());
+        if( _isIq ) {
+            std::copy(_q.begin() + _available, _q.begin() + _available + history, _q.begin());
+        }
+    }
+
+    // Read and deinterleave the next block
+    int read = _reader->Read(_input, _blocksize);
+    if( read <= 0 ) {
+        return false;
+    }
+    if( _isIq ) {
+        _available = read / 2;
+        for( int j = 0; j < _available; j++ ) {
+            _i[history + j] = _input[2 * j];
+            _q[history + j] = _input[(2 * j) + 1];
+        }
+    } else {
+        _available = read;
+        std::copy(_input, _input + read, _i.begin() + history);
+    }
+    return true;
+}
+
+int BoomaFirDecimator::Read(int16_t* dest, size_t blocksize) {
+
+    // Calculate one output sample for every 'factor' input samples, reading input as needed
+    size_t produced = 0;
+    while( produced < blocksize ) {
+        while( _next >= _available ) {
+            _next -= _available;
+            if( !ReadInput() ) {
+                return 0;
+            }
+        }
+        if( _isIq ) {
+            dest[produced++] = _kernel.Calculate(&_i[_next]);
+            dest[produced++] = _kernel.Calculate(&_q[_next]);
+        } else {
+            dest[produced++] = _kernel.Calculate(&_i[_next]);
+        }
+        _next += _factor;
+    }
+    return blocksize;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+
+#include "boomafirfilter.h"
+
+BoomaFirFilter::BoomaFirFilter(std::string id, HWriter<int16_t>* writer, float* coefficients, int length, size_t blocksize, bool isIq):
+        HFilter<int16_t>(id, writer, blocksize),
+        _kernel(coefficients, length),
+        _isIq(isIq) {
+    Init();
+}
+
+BoomaFirFilter::BoomaFirFilter(std::string id, HWriterConsumer<int16_t>* consumer, float* coefficients, int length, size_t blocksize, bool isIq):
+        HFilter<int16_t>(id, consumer, blocksize),
+        _kernel(coefficients, length),
+        _isIq(isIq) {
+    Init();
+}
+
+BoomaFirFilter::BoomaFirFilter(std::string id, HReader<int16_t>* reader, float* coefficients, int length, size_t blocksize, bool isIq):
+        HFilter<int16_t>(id, reader, blocksize),
+        _kernel(coefficients, length),
+        _isIq(isIq) {
+    Init();
+}
+
+void BoomaFirFilter::Init() {
+    HLog("Using %s fir kernel with %d taps (%s)", BoomaFirKernel::GetImplementation().c_str(), _kernel.GetLength(), _isIq ? "IQ" : "REAL");
+    _i.assign(_kernel.GetLength() - 1, 0);
+    _q.assign(_kernel.GetLength() - 1, 0);
+}
+
+void BoomaFirFilter::SetCoefficients(float* coefficients, int length) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _kernel.SetCoefficients(coefficients, length);
+
+    // Keep the newest samples if the (padded) filter length has changed
+    int history = _kernel.GetLength() - 1;
+    if( history != (int) _i.size() ) {
+        std::vector<int16_t> i(history, 0);
+        std::vector<int16_t> q(history, 0);
+        int keep = std::min(history, (int) _i.size());
+        std::copy(_i.end() - keep, _i.end(), i.end() - keep);
+        std::copy(_q.end() - keep, _q.end(), q.end() - keep);
+        _i.swap(i);
+        _q.swap(q);
+    }
+}
+
+void BoomaFirFilter::Filter(int16_t* src, int16_t* dest, size_t blocksize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    int history = _kernel.GetLength() - 1;
+
+    // Realvalued samples
+    if( !_isIq ) {
+        _i.resize(history + blocksize);
+        std::copy(src, src + blocksize, _i.begin() + history);
+        for( size_t j = 0; j < blocksize; j++ ) {
+            dest[j] = _kernel.Calculate(&_i[j]);
+        }
+        std::copy(_i.end() - history, _i.end(), _i.begin());
+        _i.resize(history);
+        return;
+    }
+
+    // IQ samples
+    size_t n = blocksize / 2;
+    _i.resize(history + n);
+    _q.resize(history + n);
+    for( size_t j = 0; j < n; j++ ) {
+        _i[history + j] = src[2 * j];
+        _q[history + j] = src[(2 * j) + 1];
+    }
+    for( size_t j = 0; j < n; j++ ) {
+        dest[2 * j] = _kernel.Calculate(&_i[j]);
+        dest[(2 * j) + 1] = _kernel.Calculate(&_q[j]);
+    }
+    std::copy(_i.end() - history, _i.end(), _i.begin());
+    std::copy(_q.end() - history, _q.end(), _q.begin());
+    _i.resize(history);
+    _q.resize(history);
+}
@@ -0,0 +1,73 @@
+#include "boomafirinterpolator.h"
+#include "booma.h"
+
+BoomaFirInterpolator::BoomaFirInterpolator(std::string id, HWriterConsumer<int16_t>* previous, int factor, int cutoff, int samplerate, int channels, size_t blocksize):
+        HWriter<int16_t>(id),
+        _writer(nullptr),
+        _factor(factor),
+        _channels(channels),
+        _blocksize(blocksize) {
+
+    // Split the interpolation filter into one kernel per phase. The gain is raised by the
+    // factor to make up for the zeros that the interpolation inserts
+    int taps = (factor * FIR_TAPS_PER_PHASE) - 1;
+    HLog("Interpolating %d -> %d with %d taps", samplerate / factor, samplerate, taps);
+    float* coefficients = HLowpassKaiserBessel<int16_t>(cutoff, samplerate, taps, 96).Calculate();
+    for( int phase = 0; phase < factor; phase++ ) {
+        std::vector<float> kernel;
+        for( int tap = phase; tap < taps; tap += factor ) {
+            kernel.push_back(coefficients[tap] * factor);
+        }
+        _phases.push_back(new BoomaFirKernel(kernel.data(), kernel.size()));
+    }
+
+    _input.assign(channels, std::vector<int16_t>(_phases[0]->GetLength() - 1, 0));
+    previous->SetWriter(this);
+}
+
+BoomaFirInterpolator::~BoomaFirInterpolator() {
+    for( std::vector<BoomaFirKernel*>::iterator it = _phases.begin(); it != _phases.end(); it++ ) {
+        delete *it;
+    }
+}
+
+int BoomaFirInterpolator::Write(int16_t* src, size_t blocksize) {
+    int history = _phases[0]->GetLength() - 1;
+    size_t length = blocksize / _channels;
+
+    // Deinterleave after the history
+    for( int channel = 0; channel < _channels; channel++ ) {
+        _input[channel].resize(history + length);
+        for( size_t j = 0; j < length; j++ ) {
+            _input[channel][history + j] = src[(j * _channels) + channel];
+        }
+    }
+
+    // Calculate 'factor' output samples for each input sample, interleaved as the input
+    for( size_t j = 0; j < length; j++ ) {
+        for( int phase = 0; phase < _factor; phase++ ) {
+            for( int channel = 0; channel < _channels; channel++ ) {
+                _output.push_back(_phases[phase]->Calculate(&_input[channel][j]));
+            }
+        }
+    }
+    for( int channel = 0; channel < _channels; channel++ ) {
+        std::copy(_input[channel].end() - history, _input[channel].end(), _input[channel].begin());
+    }
+
+    // Write whole blocks
+    size_t written = 0;
+    while( _output.size() - written >= _blocksize ) {
+        WriteBlock(&_output[written], _blocksize);
+        written += _blocksize;
+    }
+    _output.erase(_output.begin(), _output.begin() + written);
+
+    return blocksize;
+}
+
+void BoomaFirInterpolator::WriteBlock(int16_t* src, size_t blocksize) {
+    if( _writer != nullptr ) {
+        _writer->Write(src, blocksize);
+    }
+}
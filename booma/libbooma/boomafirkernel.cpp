@@ -0,0 +1,131 @@
+#include <cmath>
+
+#include <hardtapi.h>
+#include "boomafirkernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BOOMA_FIR_KERNEL_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BOOMA_FIR_KERNEL_NEON
+#endif
+
+static int32_t DotProductScalar(const int16_t* samples, const int16_t* coefficients, int length) {
+    int32_t result = 0;
+    for( int i = 0; i < length; i++ ) {
+        result += (int32_t) samples[i] * (int32_t) coefficients[i];
+    }
+    return result;
+}
+
+#ifdef BOOMA_FIR_KERNEL_X86
+
+__attribute__((target("sse2")))
+static int32_t DotProductSse2(const int16_t* samples, const int16_t* coefficients, int length) {
+    __m128i sum = _mm_setzero_si128();
+    for( int i = 0; i < length; i += 16 ) {
+        __m128i a = _mm_loadu_si128((const __m128i*) &samples[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*) &coefficients[i]);
+        __m128i c = _mm_loadu_si128((const __m128i*) &samples[i + 8]);
+        __m128i d = _mm_loadu_si128((const __m128i*) &coefficients[i + 8]);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(c, d));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2")))
+static int32_t DotProductAvx2(const int16_t* samples, const int16_t* coefficients, int length) {
+    __m256i sum = _mm256_setzero_si256();
+    for( int i = 0; i < length; i += 16 ) {
+        __m256i a = _mm256_loadu_si256((const __m256i*) &samples[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*) &coefficients[i]);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, b));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+
+#endif
+
+#ifdef BOOMA_FIR_KERNEL_NEON
+
+static int32_t DotProductNeon(const int16_t* samples, const int16_t* coefficients, int length) {
+    int32x4_t sumLow = vdupq_n_s32(0);
+    int32x4_t sumHigh = vdupq_n_s32(0);
+    for( int i = 0; i < length; i += 8 ) {
+        int16x8_t a = vld1q_s16(&samples[i]);
+        int16x8_t b = vld1q_s16(&coefficients[i]);
+        sumLow = vmlal_s16(sumLow, vget_low_s16(a), vget_low_s16(b));
+        sumHigh = vmlal_s16(sumHigh, vget_high_s16(a), vget_high_s16(b));
+    }
+    int32x4_t sum = vaddq_s32(sumLow, sumHigh);
+    int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+    return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+#endif
+
+struct DotProductImplementation {
+    BoomaFirDotProduct DotProduct;
+    std::string Name;
+};
+
+static DotProductImplementation SelectDotProduct() {
+#ifdef BOOMA_FIR_KERNEL_X86
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports("avx2") ) {
+        return DotProductImplementation {DotProductAvx2, "avx2"};
+    }
+    if( __builtin_cpu_supports("sse2") ) {
+        return DotProductImplementation {DotProductSse2, "sse2"};
+    }
+#endif
+#ifdef BOOMA_FIR_KERNEL_NEON
+    return DotProductImplementation {DotProductNeon, "neon"};
+#endif
+    return DotProductImplementation {DotProductScalar, "scalar"};
+}
+
+static DotProductImplementation& GetDotProduct() {
+    static DotProductImplementation implementation = SelectDotProduct();
+    return implementation;
+}
+
+std::string BoomaFirKernel::GetImplementation() {
+    return GetDotProduct().Name;
+}
+
+BoomaFirKernel::BoomaFirKernel(float* coefficients, int length):
+        _shift(0),
+        _rounding(0),
+        _dotProduct(GetDotProduct().DotProduct) {
+
+    SetCoefficients(coefficients, length);
+}
+
+void BoomaFirKernel::SetCoefficients(float* coefficients, int length) {
+
+    // Largest shift where the sum of all (absolute) scaled coefficients fits in int16,
+    // then no input can overflow the int32 accumulator
+    double sum = 0;
+    for( int i = 0; i < length; i++ ) {
+        sum += fabs(coefficients[i]);
+    }
+    int shift = sum > 0 ? (int) floor(log2(32767.0 / sum)) : 15;
+    _shift = shift < 0 ? 0 : (shift > 30 ? 30 : shift);
+    _rounding = _shift > 0 ? (1 << (_shift - 1)) : 0;
+
+    // Reverse and pad the coefficients at the front
+    int padded = ((length + BOOMA_FIR_KERNEL_ALIGNMENT - 1) / BOOMA_FIR_KERNEL_ALIGNMENT) * BOOMA_FIR_KERNEL_ALIGNMENT;
+    _coefficients.assign(padded, 0);
+    for( int i = 0; i < length; i++ ) {
+        double value = round(coefficients[i] * (double) (1 << _shift));
+        _coefficients[padded - 1 - i] = value > 32767 ? 32767 : (value < -32768 ? -32768 : (int16_t) value);
+    }
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+
+#include "boomahalfbanddecimator.h"
+
+BoomaHalfbandDecimator::BoomaHalfbandDecimator(std::string id, HReader<int16_t>* reader, int taps, size_t blocksize, bool isIq):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _taps(taps),
+        _length((4 * taps) - 1),
+        _isIq(isIq),
+        _blocksize(blocksize),
+        _coefficients(taps),
+        _input(nullptr),
+        _available(0),
+        _next(0) {
+
+    HLog("Creating halfband decimator with %d taps (%d nonzero) (%s)", _length, (2 * taps) + 1, isIq ? "IQ" : "REAL");
+    _input = new int16_t[blocksize];
+    int samples = isIq ? blocksize / 2 : blocksize;
+    _i.assign(_length - 1 + samples, 0);
+    _q.assign(isIq ? _length - 1 + samples : 0, 0);
+
+    // Windowed sinc with cutoff at a quarter of the input samplerate. Kaiser window with beta = 8,
+    // widened by one sample on each side so that the outermost taps are not (almost) zero
+    float beta = 8;
+    float half = (float) (_length - 1) / 2;
+    std::vector<float> h(taps);
+    float sum = 0;
+    for( int k = 0; k < taps; k++ ) {
+        int t = (2 * k) + 1;
+        float r = t / (half + 1);
+        h[k] = (sin(M_PI * t / 2) / (M_PI * t)) * Bessel(beta * sqrt(1 - r * r)) / Bessel(beta);
+        sum += 2 * h[k];
+    }
+
+    // Unity gain at DC while keeping the center tap at exactly 0.5
+    float absSum = 0.5;
+    for( int k = 0; k < taps; k++ ) {
+        h[k] *= 0.5 / sum;
+        absSum += 2 * fabs(h[k]);
+    }
+
+    // Scale to fixed point with the largest shift that can not overflow the accumulator
+    _shift = std::max(0, std::min(30, (int) floor(log2(32767.0 / absSum))));
+    _rounding = _shift > 0 ? (1 << (_shift - 1)) : 0;
+    _center = round(0.5 * (1 << _shift));
+    for( int k = 0; k < taps; k++ ) {
+        _coefficients[k] = round(h[k] * (1 << _shift));
+    }
+}
+
+BoomaHalfbandDecimator::~BoomaHalfbandDecimator() {
+    delete[] _input;
+}
+
+float BoomaHalfbandDecimator::Bessel(float x) {
+
+    // Zeroth order modified Bessel function of the first kind (power series)
+    float sum = 1;
+    float term = 1;
+    for( int k = 1; k < 25; k++ ) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+int16_t BoomaHalfbandDecimator::Calculate(const int16_t* samples) {
+
+    // Fold the symmetric halves around the center, skipping all zero coefficients
+    const int16_t* center = samples + (_length / 2);
+    int32_t result = _center * center[0];
+    for( int k = 0; k < _taps; k++ ) {
+        int t = (2 * k) + 1;
+        result += _coefficients[k] * ((int32_t) center[-t] + (int32_t) center[t]);
+    }
+    result = (result + _rounding) >> _shift;
+    return result > 32767 ? 32767 : (result < -32768 ? -32768 : (int16_t) result);
+}
+
+bool BoomaHalfbandDecimator::ReadInput() {
+    int history = _length - 1;
+
+    // Move the newest samples to the history part
+    if( _available > 0 ) {
+        std::copy(_i.begin() + _available, _i.begin() + _available + history, _i.begin());
+        if( _isIq ) {
+            std::copy(_q.begin() + _available, _q.begin() + _available + history, _q.begin());
+        }
+    }
+
+    // Read and deinterleave the next block
+    int read = _reader->Read(_input, _blocksize);
+    if( read <= 0 ) {
+        return false;
+    }
+    if( _isIq ) {
+        _available = read / 2;
+        for( int j = 0; j < _available; j++ ) {
+            _i[history + j] = _input[2 * j];
+            _q[history + j] = _input[(2 * j) + 1];
+        }
+    } else {
+        _available = read;
+        std::copy(_input, _input + read, _i.begin() + history);
+    }
+    return true;
+}
+
+int BoomaHalfbandDecimator::Read(int16_t* dest, size_t blocksize) {
+
+    // Calculate one output sample for every second input sample, reading input as needed
+    size_t produced = 0;
+    while( produced < blocksize ) {
+        while( _next >= _available ) {
+            _next -= _available;
+            if( !ReadInput() ) {
+                return 0;
+            }
+        }
+        if( _isIq ) {
+            dest[produced++] = Calculate(&_i[_next]);
+            dest[produced++] = Calculate(&_q[_next]);
+        } else {
+            dest[produced++] = Calculate(&_i[_next]);
+        }
+        _next += 2;
+    }
+    return blocksize;
+}
@@ -0,0 +1,69 @@
+#include "boomaifdecimator.h"
+#include "booma.h"
+
+BoomaIfDecimator::BoomaIfDecimator(std::string id, HWriterConsumer<int16_t>* previous, int center, int samplerate, int factor):
+        HWriter<int16_t>(id),
+        _writer(nullptr),
+        _factor(factor),
+        _rate(samplerate / factor),
+        _center(center),
+        _cosine(nullptr),
+        _sine(nullptr),
+        _next(0) {
+
+    // Lowpass for +/- a quarter of the low samplerate, shifted to the IF. The gain is doubled
+    // since only one of the two sidebands of the realvalued input is kept
+    int taps = (factor * FIR_TAPS_PER_PHASE) - 1;
+    HLog("Decimating IF %d Hz, %d -> %d with %d taps", center, samplerate, _rate, taps);
+    float* coefficients = HLowpassKaiserBessel<int16_t>(_rate / 4, samplerate, taps, 96).Calculate();
+    std::vector<float> cosine(taps);
+    std::vector<float> sine(taps);
+    double omega = (2 * M_PI * center) / samplerate;
+    for( int tap = 0; tap < taps; tap++ ) {
+        cosine[tap] = 2 * coefficients[tap] * cos(omega * tap);
+        sine[tap] = 2 * coefficients[tap] * sin(omega * tap);
+    }
+    _cosine = new BoomaFirKernel(cosine.data(), taps);
+    _sine = new BoomaFirKernel(sine.data(), taps);
+
+    // The kernels leave the decimated samples rotating by +IF, move them to the low IF
+    SetShift(_rate / 4);
+
+    _input.assign(_cosine->GetLength() - 1, 0);
+    previous->SetWriter(this);
+}
+
+BoomaIfDecimator::~BoomaIfDecimator() {
+    SAFE_DELETE(_cosine);
+    SAFE_DELETE(_sine);
+}
+
+int BoomaIfDecimator::Write(int16_t* src, size_t blocksize) {
+    int history = _cosine->GetLength() - 1;
+
+    // Append the block after the history
+    _input.resize(history + blocksize);
+    std::copy(src, src + blocksize, _input.begin() + history);
+
+    // Calculate one IQ sample for every 'factor' input samples. The kernels are shifted relative
+    // to the newest sample, so the samples still has to be shifted down by the IF
+    _iq.clear();
+    for( ; _next < (int) blocksize; _next += _factor ) {
+        _iq.push_back(_cosine->Calculate(&_input[_next]));
+        _iq.push_back(_sine->Calculate(&_input[_next]));
+    }
+    _next -= blocksize;
+    std::copy(_input.end() - history, _input.end(), _input.begin());
+
+    // Shift to the low IF and keep the realvalued part
+    _oscillator.Mix(_iq.data(), _iq.size());
+    _output.resize(_iq.size() / 2);
+    for( size_t i = 0; i < _output.size(); i++ ) {
+        _output[i] = _iq[2 * i];
+    }
+
+    if( _writer != nullptr && !_output.empty() ) {
+        _writer->Write(_output.data(), _output.size());
+    }
+    return blocksize;
+}
@@ -1,12 +1,20 @@
 #include "boomainput.h"
 
-BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
+BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated, HReader<int16_t>* inputReader):
         _inputReader(nullptr),
+        _mappedReader(nullptr),
+        _ringBuffer(nullptr),
         _rfWriter(nullptr),
+        _rfCapture(nullptr),
         _rfSplitter(nullptr),
         _rfBreaker(nullptr),
         _rfBuffer(nullptr),
         _networkProcessor(nullptr),
+        _wireDecoder(nullptr),
+        _channelReconstructor(nullptr),
+        _fanout(nullptr),
+        _udpReader(nullptr),
+        _networkNullWriter(nullptr),
         _streamProcessor(nullptr),
         _decimatorGain(nullptr),
         _decimatorAgc(nullptr),
@@ -15,6 +23,8 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
         _iqDecimator(nullptr),
         _firDecimator(nullptr),
         _decimator(nullptr),
+        _channelizer(nullptr),
+        _intermediateDecimator(nullptr),
         _inputIqFirFilter(nullptr),
         _inputFirFilter(nullptr),
         _rfDelay(nullptr),
@@ -24,14 +34,17 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
         _rfFftWriter(nullptr),
         _rfSpectrum(nullptr),
         _rfFftSize(1024),
-        _rfFftGain(nullptr) {
+        _rfFftGain(nullptr),
+        _channelSplitter(nullptr),
+        _pipeline(nullptr),
+        _timing(opts->GetStageTiming()) {
 
     // If we are using an IQ device as input, then datatype should not be REAL
     if( opts->GetInputSourceType() == RTLSDR && opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ) {
         HError("Incorrect datatype. Set to read realvalued samples from IQ device");
         throw new BoomaInputException("Incorrect datatype. Set to read realvalued samples from IQ device");
     }
-    if( (opts->GetInputSourceType() == PCM_FILE || opts->GetInputSourceType() == WAV_FILE) &&
+    if( (opts->GetInputSourceType() == PCM_FILE || opts->GetInputSourceType() == WAV_FILE || opts->GetInputSourceType() == BLC_FILE) &&
         opts->GetOriginalInputSourceType() == RTLSDR &&
         opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ) {
         HError("Incorrect datatype. Set to read realvalued samples from IQ device");
@@ -45,7 +58,7 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
     }
 
     // If using a PCM file with IQ data, then always set the frequency to 0 (zero)
-    if( (opts->GetInputSourceType() == PCM_FILE || opts->GetInputSourceType() == PCM_FILE) && opts->GetInputSourceDataType() != REAL_INPUT_SOURCE_DATA_TYPE ) {
+    if( (opts->GetInputSourceType() == PCM_FILE || opts->GetInputSourceType() == BLC_FILE) && opts->GetInputSourceDataType() != REAL_INPUT_SOURCE_DATA_TYPE ) {
         HLog("Input source is a PCM file with I/Q data. Zero'ing frequency, shift and rtlsdr-adjust");
         opts->SetFrequency(0);
         opts->SetShift(0);
@@ -60,11 +73,30 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
     if( opts->GetUseRemoteHead()) {
 
         HLog("Creating input reader for remote head");
-        HReader<int16_t>* reader = SetInputReader(opts);
+        HReader<int16_t>* reader = SetInputReader(opts, inputReader);
+
+        HLog("Setting input ring buffer");
+        reader = SetRingBuffer(opts, reader);
 
         HLog("Setting decimation for high rate input");
         reader = SetDecimation(opts, reader);
 
+        // Several heads shares the input, each with its own queue, channel and network processor
+        if( opts->GetRemoteClients() > 1 ) {
+            HLog("Sharing the input between %d remote heads", opts->GetRemoteClients());
+            _fanout = new BoomaFanout("input_fanout", reader, BLOCKSIZE, isTerminated);
+            for( int client = 0; client < opts->GetRemoteClients(); client++ ) {
+                int dataPort = opts->GetRemoteDataPort() + (2 * client);
+                int commandPort = opts->GetRemoteCommandPort() + (2 * client);
+                HReader<int16_t>* clientReader = SetRemoteStream(opts, _fanout->AddClient(FANOUT_QUEUE_BLOCKS), "_" + std::to_string(client), dataPort, false);
+                HLog("Initializing network processor for remote head %d with dataport %d and commandport %d", client, dataPort, commandPort);
+                _clientProcessors.push_back(new HNetworkProcessor<int16_t>(std::string("input_network_processor_") + std::to_string(client), dataPort, commandPort, clientReader, BLOCKSIZE, isTerminated));
+            }
+            return;
+        }
+
+        reader = SetRemoteStream(opts, reader, "", opts->GetRemoteDataPort(), true);
+
         HLog("Initializing network processor with selected input device");
         _networkProcessor = new HNetworkProcessor<int16_t>("input_network_processor", opts->GetRemoteDataPort(), opts->GetRemoteCommandPort(), reader, BLOCKSIZE, isTerminated);
         return;
@@ -74,10 +106,24 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
     if( opts->GetIsRemoteHead() ) {
         HLog("Initializing network processor with remote input at %s:%d", opts->GetRemoteServer().c_str(), opts->GetRemoteDataPort());
         _networkProcessor = new HNetworkProcessor<int16_t>(opts->GetRemoteServer().c_str(), opts->GetRemoteDataPort(), opts->GetRemoteCommandPort(), BLOCKSIZE, isTerminated);
+
+        // With UDP transport, the samples are read from datagrams and the network processor only handles commands
+        if( opts->GetUdpTransport() ) {
+            HLog("Initializing UDP transport from remote input at %s:%d", opts->GetRemoteServer().c_str(), opts->GetRemoteDataPort());
+            // An extracted channel is sent at the channel width, and reconstructed after the reader
+            int channels = opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1;
+            int rate = opts->GetChannelExtraction() > 0 ? opts->GetChannelExtraction() : opts->GetOutputSampleRate();
+            _udpReader = new BoomaUdpReader("input_udp_reader", opts->GetRemoteServer(), opts->GetRemoteDataPort(), opts->GetJitterBufferPackets(), opts->GetUdpRepeat(), rate * channels);
+            _streamProcessor = new HStreamProcessor<int16_t>("input_stream_processor", _udpReader, BLOCKSIZE, isTerminated);
+            _networkNullWriter = new HNullWriter<int16_t>("input_network_null_writer", _networkProcessor->Consumer());
+        }
     }
     else {
         HLog("Creating input reader for local hardware device");
-        HReader<int16_t>* reader = SetInputReader(opts);
+        HReader<int16_t>* reader = SetInputReader(opts, inputReader);
+
+        HLog("Setting input ring buffer");
+        reader = SetRingBuffer(opts, reader);
 
         HLog("Setting decimation for high rate input");
         reader = SetDecimation(opts, reader);
@@ -93,40 +139,86 @@ BoomaInput::BoomaInput(ConfigOptions* opts, bool* isTerminated):
 
     // Setup a splitter to split off rf dump and spectrum calculation
     HLog("Setting up input RF splitter and RF optional output dump");
-    _rfSplitter = new HSplitter<int16_t>("input_rf_splitter", (_networkProcessor != nullptr ? (HProcessor<int16_t>*) _networkProcessor : (HProcessor<int16_t>*) _streamProcessor)->Consumer());
-    _rfDelay = new HDelay<int16_t>("input_rf_delay", _rfSplitter->Consumer(), BLOCKSIZE, opts->GetOutputSampleRate(), 10);
-    _rfBreaker = new HBreaker<int16_t>("input_rf_breaker", _rfDelay->Consumer(), !opts->GetDumpRf(), BLOCKSIZE);
+    HWriterConsumer<int16_t>* input = (_streamProcessor != nullptr ? (HProcessor<int16_t>*) _streamProcessor : (HProcessor<int16_t>*) _networkProcessor)->Consumer();
+    if( _networkProcessor != nullptr && _udpReader == nullptr ) {
+        HLog("Setting wire decoder");
+        _wireDecoder = new BoomaWireDecoder("input_wire_decoder", input, BLOCKSIZE, opts->GetWireFormat() != NO_WIRE);
+        input = _wireDecoder->Consumer();
+    }
+    if( _networkProcessor != nullptr && opts->GetChannelExtraction() > 0 ) {
+        HLog("Setting channel reconstruction");
+        _channelReconstructor = new BoomaChannelReconstructor("input_channel_reconstructor", input, opts->GetChannelExtraction(), opts->GetOutputSampleRate(), BLOCKSIZE);
+        _channelReconstructor->SetShift(GetChannelPosition(opts));
+        input = _timing.Probe("input_channel_reconstructor", _channelReconstructor->Consumer());
+    }
+    _rfSplitter = new HSplitter<int16_t>("input_rf_splitter", input);
+    HWriterConsumer<int16_t>* rfDump = _timing.Probe("input_rf_dump", _rfSplitter->Consumer());
+    if( !opts->GetBatchMode() ) {
+        _rfDelay = new HDelay<int16_t>("input_rf_delay", rfDump, BLOCKSIZE, opts->GetOutputSampleRate(), 10);
+        rfDump = _rfDelay->Consumer();
+    }
+    _rfBreaker = new HBreaker<int16_t>("input_rf_breaker", rfDump, !opts->GetDumpRf(), BLOCKSIZE);
     _rfBuffer = new HBufferedWriter<int16_t>("input_rf_buffer", _rfBreaker->Consumer(), BLOCKSIZE, opts->GetReservedBuffers(), opts->GetEnableBuffers());
     std::string dumpfile = "INPUT_" + (opts->GetDumpFileSuffix() == "" ? std::to_string(std::time(nullptr)) : opts->GetDumpFileSuffix());
-    if( opts->GetDumpRfFileFormat() == WAV ) {
+    if( opts->GetDumpSegmented() && opts->GetDumpRfFileFormat() != BLC ) {
+        _rfWriter = new BoomaSegmentedWriter("input_rf_segmented_writer", dumpfile, opts->GetDumpRfFileFormat() == WAV, opts->GetOutputSampleRate(), opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1,
+                                             opts->GetDumpSegmentMinutes() * 60, (off_t) opts->GetDumpSegmentSize() * 1024 * 1024, (off_t) opts->GetDumpSegmentLimit() * 1024 * 1024, _rfBuffer->Consumer(), opts->GetBatchMode());
+    } else if( opts->GetAsyncDump() && opts->GetDumpRfFileFormat() != BLC ) {
+        bool isWav = opts->GetDumpRfFileFormat() == WAV;
+        _rfWriter = new BoomaAsyncFileWriter("input_rf_async_writer", dumpfile + (isWav ? ".wav" : ".pcm"), isWav, opts->GetOutputSampleRate(), _rfBuffer->Consumer(), opts->GetBatchMode());
+    } else if( opts->GetDumpRfFileFormat() == WAV ) {
         _rfWriter = new HWavWriter<int16_t>("input_rf_wav_writer", (dumpfile + ".wav").c_str(), H_SAMPLE_FORMAT_INT_16, 1, opts->GetOutputSampleRate(), _rfBuffer->Consumer(), true);
+    } else if( opts->GetDumpRfFileFormat() == BLC ) {
+        _rfWriter = new BoomaCompressedWriter("input_rf_blc_writer", dumpfile + ".blc", opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1, opts->GetOutputSampleRate(), _rfBuffer->Consumer());
     } else {
         _rfWriter = new HFileWriter<int16_t>("input_rf_pcm_writer", (dumpfile + ".pcm").c_str(), _rfBuffer->Consumer(), true);
     }
 
+    // Keep the last seconds of rf in memory
+    if( opts->GetCaptureSeconds() > 0 && !opts->GetBatchMode() ) {
+        HLog("Setting up the rf capture buffer");
+        _rfCapture = new BoomaCaptureBuffer("input_rf_capture", "INPUT_CAPTURE", opts->GetCaptureSeconds(), opts->GetOutputSampleRate(),
+                                            opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1, _timing.Probe("input_rf_capture", _rfSplitter->Consumer()));
+    }
+
     // Add RF spectrum calculation
     _rfFftWindow = new HRectangularWindow<int16_t>();
-    _rfFftGain = new HGain<int16_t>("input_rf_spectrum_gain", _rfSplitter->Consumer(), 1, BLOCKSIZE);
+    _rfFftGain = new HGain<int16_t>("input_rf_spectrum_gain", _timing.Probe("input_rf_spectrum", _rfSplitter->Consumer()), 1, BLOCKSIZE);
     _rfFft = new HFftOutput<int16_t>("input_rf_spectrum_output", _rfFftSize, RFFFT_AVERAGING_COUNT, RFFFT_SKIP, _rfFftGain->Consumer(), _rfFftWindow, opts->GetInputSourceDataType() != REAL_INPUT_SOURCE_DATA_TYPE);
     _rfFftWriter = HCustomWriter<HFftResults>::Create<BoomaInput>("input_rf_spectrum_writer", this, &BoomaInput::RfFftCallback, _rfFft->Consumer());
 
     // Add preamp
     HLog("Setting up the preamp");
-    HWriterConsumer<int16_t>* preamp = SetPreamp(opts, _rfSplitter->Consumer());
+    HWriterConsumer<int16_t>* preamp = SetPreamp(opts, _timing.Probe("input_preamp", _rfSplitter->Consumer()));
 
     // Add optional zero-shift
     HLog("Setting optional zero shift");
     HWriterConsumer<int16_t>* shift = SetShift(opts, preamp);
 
+    // Split off the (shifted) stream, before the input filter, to additional receiver channels and the skimmer
+    if( !opts->GetReceiverChannels().empty() || opts->GetSkimmer() ) {
+        HLog("Setting up splitter for %d additional receiver channels", opts->GetReceiverChannels().size());
+        _channelSplitter = new HSplitter<int16_t>("input_channel_splitter", _timing.Probe("input_channels", shift));
+        shift = _channelSplitter->Consumer();
+    }
+
     // Add inputfilter
     HLog("Setting 1.st. IF (input) filter");
     _lastConsumer = SetInputFilter(opts, shift);
+
+    // Optionally run the receiver on a separate thread
+    if( opts->GetPipelineDepth() > 0 ) {
+        HLog("Setting up input pipeline buffer");
+        _pipeline = new BoomaPipelineBuffer("input_pipeline", _lastConsumer, opts->GetPipelineDepth(), BLOCKSIZE, opts->GetPipelineCpu(0));
+        _lastConsumer = _pipeline->Consumer();
+    }
 }
 
 BoomaInput::~BoomaInput() {
 
     SAFE_DELETE(_streamProcessor);
     SAFE_DELETE(_networkProcessor);
+    SAFE_DELETE(_pipeline);
 
     SAFE_DELETE(_decimatorGain);
     SAFE_DELETE(_decimatorAgc);
@@ -135,11 +227,36 @@ BoomaInput::~BoomaInput() {
     SAFE_DELETE(_iqDecimator);
     SAFE_DELETE(_firDecimator);
     SAFE_DELETE(_decimator);
+    SAFE_DELETE(_channelizer);
+    SAFE_DELETE(_intermediateDecimator);
+    for( std::vector<BoomaHalfbandDecimator*>::iterator it = _halfbandDecimators.begin(); it != _halfbandDecimators.end(); it++ ) {
+        delete *it;
+    }
     SAFE_DELETE(_inputIqFirFilter);
     SAFE_DELETE(_inputFirFilter);
+    SAFE_DELETE(_channelSplitter);
 
+    for( std::vector<HNetworkProcessor<int16_t>*>::iterator it = _clientProcessors.begin(); it != _clientProcessors.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaWireEncoder*>::iterator it = _wireEncoders.begin(); it != _wireEncoders.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaChannelExtractor*>::iterator it = _channelExtractors.begin(); it != _channelExtractors.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaUdpSender*>::iterator it = _udpSenders.begin(); it != _udpSenders.end(); it++ ) {
+        delete *it;
+    }
+    SAFE_DELETE(_fanout);
+    SAFE_DELETE(_udpReader);
+    SAFE_DELETE(_networkNullWriter);
+    SAFE_DELETE(_wireDecoder);
+    SAFE_DELETE(_channelReconstructor);
+    SAFE_DELETE(_ringBuffer);
     SAFE_DELETE(_inputReader);
     SAFE_DELETE(_rfWriter);
+    SAFE_DELETE(_rfCapture);
     SAFE_DELETE(_rfSplitter);
     SAFE_DELETE(_rfBreaker);
     SAFE_DELETE(_rfBuffer);
@@ -152,7 +269,14 @@ BoomaInput::~BoomaInput() {
     SAFE_DELETE(_rfSpectrum);
 }
 
-HReader<int16_t>* BoomaInput::SetInputReader(ConfigOptions* opts) {
+HReader<int16_t>* BoomaInput::SetInputReader(ConfigOptions* opts, HReader<int16_t>* inputReader) {
+
+    // Use a given reader, fx. a segment of a file in batch mode
+    if( inputReader != nullptr ) {
+        HLog("Using supplied input reader");
+        _inputReader = inputReader;
+        return _timing.Probe("input_reader", _inputReader);
+    }
 
     // Select input reader
     try {
@@ -164,17 +288,39 @@ HReader<int16_t>* BoomaInput::SetInputReader(ConfigOptions* opts) {
                 break;
             case SIGNAL_GENERATOR:
                 HLog("Initializing signal generator at frequency %d", opts->GetSignalGeneratorFrequency());
+                if( opts->GetInputSourceDataType() != REAL_INPUT_SOURCE_DATA_TYPE ) {
+                    _inputReader = new BoomaIqGenerator("input_signal_generator_reader", opts->GetInputSampleRate(),
+                                                        opts->GetSignalGeneratorFrequency(), 200);
+                    break;
+                }
                 _inputReader = new HSineGenerator<int16_t>("input_signal_generator_reader", opts->GetInputSampleRate(),
                                                            opts->GetSignalGeneratorFrequency(), 200);
                 break;
             case PCM_FILE:
+                if( opts->GetMemoryMappedInput() ) {
+                    HLog("Initializing memory mapped pcm file reader for input file %s", opts->GetPcmFile().c_str());
+                    _mappedReader = new BoomaMappedFileReader("input_pcm_mapped_reader", opts->GetPcmFile(), false);
+                    _inputReader = _mappedReader;
+                    break;
+                }
                 HLog("Initializing pcm file reader for input file %s", opts->GetPcmFile().c_str());
                 _inputReader = new HFileReader<int16_t>("input_pcm_reader", opts->GetPcmFile());
                 break;
             case WAV_FILE:
+                if( opts->GetMemoryMappedInput() ) {
+                    HLog("Initializing memory mapped wav file reader for input file %s", opts->GetWavFile().c_str());
+                    _mappedReader = new BoomaMappedFileReader("input_wav_mapped_reader", opts->GetWavFile(), true);
+                    _inputReader = _mappedReader;
+                    break;
+                }
                 HLog("Initializing wav file reader for input file %s", opts->GetWavFile().c_str());
                 _inputReader = new HWavReader<int16_t>("input_wav_reader", opts->GetWavFile().c_str());
                 break;
+            case BLC_FILE:
+                HLog("Initializing compressed file reader for input file %s", opts->GetBlcFile().c_str());
+                _inputReader = new BoomaCompressedReader("input_blc_reader", opts->GetBlcFile(),
+                                                         opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1, opts->GetInputSampleRate());
+                break;
             case SILENCE:
                 HLog("Initializing nullreader");
                 _inputReader = new HNullReader<int16_t>("input_null_reader");
@@ -230,7 +376,12 @@ HReader<int16_t>* BoomaInput::SetInputReader(ConfigOptions* opts) {
         HError("Caught unexpected exception while trying to initialize input reader");
         throw new BoomaInputException("Unexpected exception while initializing input reader");
     }
-    return _inputReader;
+
+    // Optional start position
+    if( _mappedReader != nullptr && opts->GetInputSeek() > 0 ) {
+        Seek(opts, opts->GetInputSeek());
+    }
+    return _timing.Probe("input_reader", _inputReader);
 }
 
 bool BoomaInput::SetDumpRf(bool enabled) {
@@ -238,15 +389,136 @@ bool BoomaInput::SetDumpRf(bool enabled) {
     return !_rfBreaker->GetOff();
 }
 
+bool BoomaInput::CaptureRf(int seconds) {
+    return _rfCapture != nullptr && _rfCapture->Capture(seconds);
+}
+
+void BoomaInput::StopCaptureRf() {
+    if( _rfCapture != nullptr ) {
+        _rfCapture->StopCapture();
+    }
+}
+
+bool BoomaInput::IsCapturingRf() {
+    return _rfCapture != nullptr && _rfCapture->IsCapturing();
+}
+
+HReader<int16_t>* BoomaInput::SetRingBuffer(ConfigOptions* opts, HReader<int16_t>* previous) {
+
+    // Ring buffer disabled
+    if( opts->GetInputRingBufferBlocks() <= 0 ) {
+        HLog("Input ring buffer disabled");
+        return previous;
+    }
+
+    // Live sources must keep reading, even if that means dropping blocks. Everything else waits
+    bool isLive = opts->GetInputSourceType() == RTLSDR || opts->GetInputSourceType() == AUDIO_DEVICE;
+    _ringBuffer = new BoomaRingBufferReader("input_ring_buffer", previous, opts->GetInputRingBufferBlocks(), BLOCKSIZE, isLive);
+    return _timing.Probe("input_ring_buffer", _ringBuffer);
+}
+
+unsigned long BoomaInput::GetInputOverflows() {
+    return _ringBuffer != nullptr ? _ringBuffer->GetOverflows() : 0;
+}
+
+unsigned long BoomaInput::GetInputUnderruns() {
+    return _ringBuffer != nullptr ? _ringBuffer->GetUnderruns() : 0;
+}
+
+bool BoomaInput::Seek(ConfigOptions* opts, double seconds) {
+    if( _mappedReader == nullptr ) {
+        HLog("Input is not memory mapped, can not seek");
+        return false;
+    }
+
+    // Position at a whole IQ pair for IQ data
+    int channels = opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ? 1 : 2;
+    long position = (long) (seconds * opts->GetInputSampleRate()) * channels;
+    return _mappedReader->Seek(position);
+}
+
+double BoomaInput::GetPosition(ConfigOptions* opts) {
+    if( _mappedReader == nullptr ) {
+        return 0;
+    }
+    int channels = opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ? 1 : 2;
+    return (double) _mappedReader->GetPosition() / ((double) opts->GetInputSampleRate() * channels);
+}
+
 void BoomaInput::Run(int blocks) {
-    if( blocks > 0 ) {
+
+    // The pipeline worker runs while the input is running, and drains its queue when it stops
+    if( _pipeline != nullptr ) {
+        _pipeline->StartWorker();
+    }
+    if( _fanout != nullptr ) {
+        RunClients(blocks);
+    } else if( _udpReader != nullptr ) {
+        RunUdp(blocks);
+    } else if( blocks > 0 ) {
         (_networkProcessor != NULL ? (HProcessor<int16_t>*) _networkProcessor : (HProcessor<int16_t>*) _streamProcessor)->Run(blocks);
     } else {
         (_networkProcessor != NULL ? (HProcessor<int16_t>*) _networkProcessor : (HProcessor<int16_t>*) _streamProcessor)->Run();
     }
+    if( _pipeline != nullptr ) {
+        _pipeline->StopWorker();
+    }
+}
+
+void BoomaInput::RunClients(int blocks) {
+
+    // Each head is served by its own network processor, the shared input is read by the fan-out
+    if( !_fanout->Start() ) {
+        return;
+    }
+    std::vector<std::thread> threads;
+    for( std::vector<HNetworkProcessor<int16_t>*>::iterator it = _clientProcessors.begin(); it != _clientProcessors.end(); it++ ) {
+        HNetworkProcessor<int16_t>* processor = *it;
+        threads.push_back(std::thread( [processor, blocks]() {
+            if( blocks > 0 ) {
+                processor->Run(blocks);
+            } else {
+                processor->Run();
+            }
+        } ));
+    }
+    for( std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); it++ ) {
+        (*it).join();
+    }
+    _fanout->Stop();
+
+    for( int client = 0; client < _fanout->GetClients(); client++ ) {
+        HLog("Remote head %d: %lu blocks dropped", client, _fanout->GetClient(client)->GetDropped());
+    }
+}
+
+void BoomaInput::RunUdp(int blocks) {
+
+    // The network processor keeps the command connection, the samples are processed from the datagrams
+    std::thread commands( [this]() {
+        _networkProcessor->Run();
+    } );
+    if( blocks > 0 ) {
+        _streamProcessor->Run(blocks);
+    } else {
+        _streamProcessor->Run();
+    }
+    _networkProcessor->Halt();
+    commands.join();
 }
 
 void BoomaInput::Halt() {
+    if( _udpReader != nullptr ) {
+        _streamProcessor->Halt();
+        _networkProcessor->Halt();
+        return;
+    }
+    if( _fanout != nullptr ) {
+        for( std::vector<HNetworkProcessor<int16_t>*>::iterator it = _clientProcessors.begin(); it != _clientProcessors.end(); it++ ) {
+            (*it)->Halt();
+        }
+        return;
+    }
     (_networkProcessor != NULL ? (HProcessor<int16_t>*) _networkProcessor : (HProcessor<int16_t>*) _streamProcessor)->Halt();
 }
 
@@ -298,8 +570,24 @@ bool BoomaInput::SetFrequency(ConfigOptions* opts, int frequency) {
         return true;
     }
 
+    // A shared device is tuned by the remote heads
+    if( _fanout != nullptr ) {
+        HLog("Input is shared between remote heads, not propagating a set-frequency command");
+        return true;
+    }
+
     // Device handling
     if( opts->GetInputSourceType() == RTLSDR || opts->GetOriginalInputSourceType() == RTLSDR ) {
+
+        // The remote input server moves the extracted channel, and only retunes if needed
+        if( _channelReconstructor != nullptr ) {
+            int position = GetChannelPosition(opts);
+            HLog("Setting extracted channel center frequency = %d", _hardwareFrequency + position);
+            _channelReconstructor->SetShift(position);
+            _networkProcessor->Command(H_COMMAND_CLASS::TUNER, H_COMMAND_OPCODE::SET_FREQUENCY, _hardwareFrequency + position);
+            return true;
+        }
+
         HLog("Setting RTL-SDR center frequency = %d", _hardwareFrequency);
         (_networkProcessor != NULL ? (HProcessor<int16_t>*) _networkProcessor : (HProcessor<int16_t>*) _streamProcessor)
                 ->Command(H_COMMAND_CLASS::TUNER, H_COMMAND_OPCODE::SET_FREQUENCY, _hardwareFrequency);
@@ -309,6 +597,40 @@ bool BoomaInput::SetFrequency(ConfigOptions* opts, int frequency) {
     }
 }
 
+HReader<int16_t>* BoomaInput::SetRemoteStream(ConfigOptions* opts, HReader<int16_t>* previous, std::string suffix, int dataPort, bool isRetuneAllowed) {
+    HReader<int16_t>* reader = previous;
+
+    if( opts->GetChannelExtraction() > 0 ) {
+        HLog("Setting channel extraction");
+        BoomaChannelExtractor* extractor = new BoomaChannelExtractor("input_channel_extractor" + suffix, reader, opts->GetOutputSampleRate(), opts->GetChannelExtraction(), opts->GetDecimatorCutoff(), _hardwareFrequency, opts->GetRtlsdrOffset(), BLOCKSIZE, isRetuneAllowed);
+        _channelExtractors.push_back(extractor);
+        reader = _timing.Probe("input_channel_extractor" + suffix, extractor);
+    }
+
+    // Datagrams carries their own wire frames
+    if( opts->GetUdpTransport() ) {
+        HLog("Setting UDP sender");
+        BoomaUdpSender* sender = new BoomaUdpSender("input_udp_sender" + suffix, reader, dataPort, opts->GetWireFormat() == NO_WIRE ? RAW_WIRE : opts->GetWireFormat(), opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1, BLOCKSIZE);
+        _udpSenders.push_back(sender);
+        return sender;
+    }
+
+    // Raw samples passes through the encoder, which then only meters the stream
+    HLog("Setting wire encoder");
+    BoomaWireEncoder* encoder = new BoomaWireEncoder("input_wire_encoder" + suffix, reader, opts->GetWireFormat(), opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ? 2 : 1, BLOCKSIZE);
+    _wireEncoders.push_back(encoder);
+    return encoder;
+}
+
+int BoomaInput::GetChannelPosition(ConfigOptions* opts) {
+
+    // An extracted channel is centered on the signal, which the rest of the chain expects to find at the rtl-sdr offset
+    if( opts->GetOriginalInputSourceType() != RTLSDR ) {
+        return 0;
+    }
+    return opts->GetRtlsdrOffset() + (opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor());
+}
+
 bool BoomaInput::GetDecimationRate(int inputRate, int outputRate, int* first, int* second) {
 
     // Run through all possible factors for the current blocksize
@@ -372,6 +694,38 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
         throw new BoomaInputException("no integer divisor exists to decimate the input samplerate to the output samplerate");
     }
 
+    // Decimators require a tiny bit of gain to overcome the loss in the FIR filters
+    HReader<int16_t>* gain = SetDecimatorGain(opts, previous);
+
+    // Polyphase channelizer, decimating all channels in the input spectrum in one pass.
+    // Only when running locally, a remote head has no use for the additional channels
+    bool isIq = opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE || opts->GetInputSourceDataType() == I_INPUT_SOURCE_DATA_TYPE || opts->GetInputSourceDataType() == Q_INPUT_SOURCE_DATA_TYPE;
+    if( opts->GetPolyphaseChannelizer() && isIq && !opts->GetUseRemoteHead() ) {
+        HLog("Creating polyphase channelizer with %d channels = %d -> %d", opts->GetInputSampleRate() / opts->GetOutputSampleRate(), opts->GetInputSampleRate(), opts->GetOutputSampleRate());
+        _channelizer = new BoomaChannelizer(
+            "input_channelizer",
+            gain,
+            opts->GetInputSampleRate() / opts->GetOutputSampleRate(),
+            opts->GetInputSampleRate(),
+            opts->GetDecimatorCutoff(),
+            CHANNELIZER_TAPS_PER_PHASE,
+            BLOCKSIZE);
+        return _timing.Probe("input_channelizer", _channelizer);
+    } else if( opts->GetPolyphaseChannelizer() ) {
+        HLog("Polyphase channelizer is only used with local IQ input, using regular decimation");
+    }
+
+    // Halfband decimator cascade followed by a short FIR decimator, if the decimation factor allows it
+    if( opts->GetDecimationPlan() == HALFBAND_DECIMATION ) {
+        int stages;
+        int intermediateFactor;
+        int finalFactor;
+        if( GetHalfbandDecimationPlan(opts->GetInputSampleRate(), opts->GetOutputSampleRate(), &stages, &intermediateFactor, &finalFactor) ) {
+            return SetHalfbandDecimation(opts, gain, isIq, stages, intermediateFactor, finalFactor);
+        }
+        HError("No halfband decimation plan from %d to %d, using regular decimation", opts->GetInputSampleRate(), opts->GetOutputSampleRate());
+    }
+
     // Get decimation factors
     int firstFactor;
     int secondFactor;
@@ -380,23 +734,14 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
         throw new BoomaInputException("No possible decimation factors to go from the input samplerate to the output samplerate");
     }
 
-    // Decimators require a tiny bit of gain to overcome the loss in the FIR filters
-    if( opts->GetDecimatorGain() > 0 ) {
-        HLog("Using fixed gain=%d before decimator", opts->GetDecimatorGain());
-        _decimatorGain = new HGain<int16_t>("input_decimator_gain_fixed", previous, opts->GetDecimatorGain(), BLOCKSIZE);
-    } else {
-        HLog("Using agc at level=%d before decimator", opts->GetDecimatorAgcLevel());
-        _decimatorAgc = new HAgc<int16_t>("input_decimator_gain_agc", previous, opts->GetDecimatorAgcLevel(), 50, BLOCKSIZE, 6, true);
-    }
-
     // Decimation for IQ signals
-    if(opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE || opts->GetInputSourceDataType() == I_INPUT_SOURCE_DATA_TYPE || opts->GetInputSourceDataType() == Q_INPUT_SOURCE_DATA_TYPE ) {
+    if( isIq ) {
 
         // First decimation stage - a FIR decimator dropping the samplerate while filtering out-ouf-band frequencies
         HLog("Creating FIR decimator with factor %d = %d -> %d with FIR filter size %d", firstFactor, opts->GetInputSampleRate(), opts->GetInputSampleRate() / firstFactor, opts->GetFirFilterSize());
-        _iqFirDecimator = new HIqFirDecimator<int16_t>(
+        _iqFirDecimator = new BoomaFirDecimator(
             "input_first_decimator_iq_fir",
-            (_decimatorGain != nullptr ? _decimatorGain : _decimatorAgc)->Reader(),
+            gain,
             firstFactor,
             HLowpassKaiserBessel<int16_t>(opts->GetDecimatorCutoff(), opts->GetInputSampleRate(), opts->GetFirFilterSize(),120).Calculate(),
             opts->GetFirFilterSize(),
@@ -408,13 +753,13 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
             HLog("Creating decimator with factor %d = %d -> %d", secondFactor, opts->GetInputSampleRate() / firstFactor, opts->GetOutputSampleRate());
             _iqDecimator = new HIqDecimator<int16_t>(
                     "input_second_decimator_iq",
-                    _iqFirDecimator->Reader(),
+                    _timing.Probe("input_first_decimator", _iqFirDecimator),
                     secondFactor,
                     BLOCKSIZE,
                     true);
-            return _iqDecimator->Reader();
+            return _timing.Probe("input_second_decimator", _iqDecimator->Reader());
         } else {
-            return _iqFirDecimator->Reader();
+            return _timing.Probe("input_first_decimator", _iqFirDecimator);
         }
     }
 
@@ -423,9 +768,9 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
 
         // First decimation stage - a FIR decimator dropping the samplerate while filtering out-ouf-band frequencies
         HLog("Creating FIR decimator with factor %d = %d -> %d and FIR filter size %d", firstFactor, opts->GetInputSampleRate(), opts->GetInputSampleRate() / firstFactor, opts->GetFirFilterSize());
-        _firDecimator = new HFirDecimator<int16_t>(
+        _firDecimator = new BoomaFirDecimator(
                 "input_first_decimator_fir",
-                (_decimatorGain != nullptr ? _decimatorGain : _decimatorAgc)->Reader(),
+                gain,
                 firstFactor,
                 HLowpassKaiserBessel<int16_t>(opts->GetDecimatorCutoff(), opts->GetInputSampleRate(), opts->GetFirFilterSize(),96).Calculate(),
                 opts->GetFirFilterSize(),
@@ -434,10 +779,10 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
         // Second decimation stage, if needed - a regular decimator dropping the samplerate to the output samplerate
         if (secondFactor > 1) {
             HLog("Creating decimator with factor %d = %d -> %d", secondFactor, opts->GetInputSampleRate() / firstFactor, opts->GetOutputSampleRate());
-            _decimator = new HDecimator<int16_t>("input_second_decimator", _firDecimator->Reader(), 3, BLOCKSIZE);
-            return _decimator->Reader();
+            _decimator = new HDecimator<int16_t>("input_second_decimator", _timing.Probe("input_first_decimator", _firDecimator), secondFactor, BLOCKSIZE);
+            return _timing.Probe("input_second_decimator", _decimator->Reader());
         } else {
-            return _firDecimator->Reader();
+            return _timing.Probe("input_first_decimator", _firDecimator);
         }
     }
 
@@ -447,6 +792,120 @@ HReader<int16_t>* BoomaInput::SetDecimation(ConfigOptions* opts, HReader<int16_t
     }
 }
 
+bool BoomaInput::GetHalfbandDecimationPlan(int inputRate, int outputRate, int* stages, int* intermediateFactor, int* finalFactor) {
+
+    // Decimate by 2 for as long as possible, the remainder is handled by the final FIR decimator
+    int factor = inputRate / outputRate;
+    *stages = 0;
+    while( factor % 2 == 0 ) {
+        factor /= 2;
+        (*stages)++;
+    }
+
+    // The final decimator does the actual band limiting, so it must always decimate. If the
+    // factor is a power of two, then the last halfband stage is replaced by the FIR decimator
+    if( factor == 1 ) {
+        factor = 2;
+        (*stages)--;
+    }
+    if( *stages < 1 ) {
+        HLog("Decimation factor %d has no factor 2 for a halfband stage", inputRate / outputRate);
+        return false;
+    }
+
+    // A remainder too large for a short FIR decimator is split over two FIR decimators,
+    // (2.4M -> 48K = 2 x 5 x 5), the largest factor runs last at the lowest rate
+    *intermediateFactor = 1;
+    *finalFactor = factor;
+    if( factor > DECIMATION_MAX_FINAL_FACTOR ) {
+        for( int last = DECIMATION_MAX_FINAL_FACTOR; last > 1; last-- ) {
+            if( factor % last == 0 && factor / last <= DECIMATION_MAX_FINAL_FACTOR ) {
+                *intermediateFactor = factor / last;
+                *finalFactor = last;
+                break;
+            }
+        }
+        if( *intermediateFactor == 1 ) {
+            HLog("Remaining decimation factor %d can not be split into two factors of at most %d", factor, DECIMATION_MAX_FINAL_FACTOR);
+            return false;
+        }
+    }
+    HLog("Setting halfband decimation to %d stages, intermediate factor %d and final factor %d", *stages, *intermediateFactor, *finalFactor);
+    return true;
+}
+
+HReader<int16_t>* BoomaInput::SetHalfbandDecimation(ConfigOptions* opts, HReader<int16_t>* previous, bool isIq, int stages, int intermediateFactor, int finalFactor) {
+
+    // Halfband stages, each dropping the samplerate by 2
+    int rate = opts->GetInputSampleRate();
+    HReader<int16_t>* reader = previous;
+    float multiplications = 0;
+    for( int stage = 0; stage < stages; stage++ ) {
+        HLog("Creating halfband decimator stage %d = %d -> %d", stage + 1, rate, rate / 2);
+        BoomaHalfbandDecimator* halfband = new BoomaHalfbandDecimator(
+            "input_halfband_decimator_" + std::to_string(stage + 1),
+            reader,
+            HALFBAND_DECIMATOR_TAPS,
+            BLOCKSIZE,
+            isIq);
+        _halfbandDecimators.push_back(halfband);
+        multiplications += (float) (HALFBAND_DECIMATOR_TAPS + 1) / (1 << (stage + 1));
+        reader = _timing.Probe("input_halfband_decimator_" + std::to_string(stage + 1), halfband);
+        rate /= 2;
+    }
+
+    // Intermediate FIR decimator, if needed. It only has to keep aliases out of the output
+    // passband, so it uses the same filter as the final decimator
+    if( intermediateFactor > 1 ) {
+        HLog("Creating intermediate FIR decimator with factor %d = %d -> %d with FIR filter size %d", intermediateFactor, rate, rate / intermediateFactor, opts->GetFirFilterSize());
+        _intermediateDecimator = new BoomaFirDecimator(
+            isIq ? "input_intermediate_decimator_iq_fir" : "input_intermediate_decimator_fir",
+            reader,
+            intermediateFactor,
+            HLowpassKaiserBessel<int16_t>(opts->GetDecimatorCutoff(), rate, opts->GetFirFilterSize(), isIq ? 120 : 96).Calculate(),
+            opts->GetFirFilterSize(),
+            BLOCKSIZE,
+            isIq);
+        multiplications += (float) opts->GetFirFilterSize() / ((1 << stages) * intermediateFactor);
+        reader = _timing.Probe("input_intermediate_decimator", _intermediateDecimator);
+        rate /= intermediateFactor;
+    }
+
+    // Final FIR decimator, removing anything outside the output passband
+    HLog("Creating final FIR decimator with factor %d = %d -> %d with FIR filter size %d", finalFactor, rate, rate / finalFactor, opts->GetFirFilterSize());
+    BoomaFirDecimator* decimator = new BoomaFirDecimator(
+        isIq ? "input_final_decimator_iq_fir" : "input_final_decimator_fir",
+        reader,
+        finalFactor,
+        HLowpassKaiserBessel<int16_t>(opts->GetDecimatorCutoff(), rate, opts->GetFirFilterSize(), isIq ? 120 : 96).Calculate(),
+        opts->GetFirFilterSize(),
+        BLOCKSIZE,
+        isIq);
+    if( isIq ) {
+        _iqFirDecimator = decimator;
+    } else {
+        _firDecimator = decimator;
+    }
+    multiplications += (float) opts->GetFirFilterSize() / ((1 << stages) * intermediateFactor * finalFactor);
+
+    HLog("Decimation plan: %d halfband stages + FIR decimation by %d and %d = %d -> %d, %.1f multiplications per input sample (single FIR: %.1f)",
+         stages, intermediateFactor, finalFactor, opts->GetInputSampleRate(), rate / finalFactor, multiplications,
+         (float) opts->GetFirFilterSize() / (opts->GetInputSampleRate() / opts->GetOutputSampleRate()));
+    return _timing.Probe("input_final_decimator", decimator);
+}
+
+HReader<int16_t>* BoomaInput::SetDecimatorGain(ConfigOptions* opts, HReader<int16_t>* previous) {
+    if( opts->GetDecimatorGain() > 0 ) {
+        HLog("Using fixed gain=%d before decimator", opts->GetDecimatorGain());
+        _decimatorGain = new HGain<int16_t>("input_decimator_gain_fixed", previous, opts->GetDecimatorGain(), BLOCKSIZE);
+        return _timing.Probe("input_decimator_gain", _decimatorGain->Reader());
+    } else {
+        HLog("Using agc at level=%d before decimator", opts->GetDecimatorAgcLevel());
+        _decimatorAgc = new HAgc<int16_t>("input_decimator_gain_agc", previous, opts->GetDecimatorAgcLevel(), 50, BLOCKSIZE, 6, true);
+        return _timing.Probe("input_decimator_gain", _decimatorAgc->Reader());
+    }
+}
+
 HWriterConsumer<int16_t>* BoomaInput::SetInputFilter(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
 
     // Ignore shift for some input types
@@ -462,15 +921,15 @@ HWriterConsumer<int16_t>* BoomaInput::SetInputFilter(ConfigOptions* opts, HWrite
     if( opts->GetOriginalInputSourceType() == RTLSDR ) {
 
         // Add extra filter the removes (mostly) anything outside the FIR cutoff frequency
-        _inputIqFirFilter = new HIqFirFilter<int16_t>("input_iq_fir", previous, opts->GetInputFilterWidth() == 0
+        _inputIqFirFilter = new BoomaFirFilter("input_iq_fir", _timing.Probe("input_filter", previous), opts->GetInputFilterWidth() == 0
                 ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
                 : HLowpassKaiserBessel<int16_t>(opts->GetInputFilterWidth(), opts->GetOutputSampleRate(), 51, 50).Calculate(),
-                51, BLOCKSIZE);
+                51, BLOCKSIZE, true);
         return _inputIqFirFilter->Consumer();
     } else {
 
         // Add extra filter the removes (mostly) anything outside the current frequency passband frequency
-        _inputFirFilter = new HFirFilter<int16_t>("input_fir", previous,
+        _inputFirFilter = new BoomaFirFilter("input_fir", _timing.Probe("input_filter", previous),
             opts->GetInputFilterWidth() == 0
                 ? HLowpassKaiserBessel<int16_t>(opts->GetOutputSampleRate() / 2, opts->GetOutputSampleRate(), 51, 50).Calculate()
                 : HBandpassKaiserBessel<int16_t>(_ifFrequency - (opts->GetInputFilterWidth() / 2), _ifFrequency + (opts->GetInputFilterWidth() / 2), opts->GetOutputSampleRate(), 51, 50).Calculate(),
@@ -523,7 +982,7 @@ HWriterConsumer<int16_t>* BoomaInput::SetShift(ConfigOptions* opts, HWriterConsu
         // physical frequency that we want to capture. This avoids the LO injections that can be found many places
         // in the spectrum - a small prize for having such a powerful sdr at this low pricepoint.!
         HLog("Setting up IF multiplier for RTL-SDR device (shift %d)", 0 - opts->GetRtlsdrOffset() - (opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor()));
-        _ifMultiplier = new HIqMultiplier<int16_t>("input_if_multiplier", previous, opts->GetOutputSampleRate(), 0 - opts->GetRtlsdrOffset() - opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor(), 10, BLOCKSIZE);
+        _ifMultiplier = new HIqMultiplier<int16_t>("input_if_multiplier", _timing.Probe("input_shift", previous), opts->GetOutputSampleRate(), 0 - opts->GetRtlsdrOffset() - opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor(), 10, BLOCKSIZE);
 
         return _ifMultiplier->Consumer();
     }
@@ -582,3 +1041,87 @@ int BoomaInput::GetRfSpectrum(double* spectrum) {
 int BoomaInput::GetRfFftSize() {
     return _rfFftSize;
 }
+
+HWriterConsumer<int16_t>* BoomaInput::GetChannelWriterConsumer(int bin) {
+
+    // Channels inside the main passband are split off after the shift
+    if( bin == 0 ) {
+        return _channelSplitter != nullptr ? _channelSplitter->Consumer() : nullptr;
+    }
+
+    // Other channels are taken directly from the channelizer
+    return _channelizer != nullptr ? _channelizer->GetChannel(bin) : nullptr;
+}
+
+int BoomaInput::GetChannelizerBin(ConfigOptions* opts, long int frequency) {
+
+    // Without a channelizer, everything is received from the main passband
+    if( _channelizer == nullptr ) {
+        return 0;
+    }
+
+    // Position of the frequency in the unshifted input spectrum
+    int position = (frequency - _virtualFrequency) + opts->GetRtlsdrOffset() + (opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor());
+
+    // Nearest channel, with negative frequencies in the upper half of the bins
+    int k = (int) round((float) position / (float) opts->GetOutputSampleRate());
+    if( k == 0 || k > (_channelizer->GetChannels() - 1) / 2 || k < -(_channelizer->GetChannels() / 2) ) {
+        return 0;
+    }
+    return k > 0 ? k : _channelizer->GetChannels() + k;
+}
+
+int BoomaInput::GetChannelOffset(ConfigOptions* opts, long int frequency, int bin) {
+
+    // Distance from the main frequency, which is at 0 after the shift
+    if( bin == 0 ) {
+        return frequency - _virtualFrequency;
+    }
+
+    // Distance from the center of the channelizer bin
+    int position = (frequency - _virtualFrequency) + opts->GetRtlsdrOffset() + (opts->GetRtlsdrCorrection() * opts->GetRtlsdrCorrectionFactor());
+    int k = bin <= (_channelizer->GetChannels() - 1) / 2 ? bin : bin - _channelizer->GetChannels();
+    return position - (k * opts->GetOutputSampleRate());
+}
+
+void BoomaInput::GetDumpStatistics(std::vector<BoomaAsyncWriterStatistics>* statistics) {
+    BoomaAsyncWriter* writer = dynamic_cast<BoomaAsyncWriter*>(_rfWriter);
+    if( writer != nullptr ) {
+        BoomaAsyncWriterStatistics rf;
+        writer->GetStatistics(&rf);
+        statistics->push_back(rf);
+    }
+}
+
+void BoomaInput::GetRemoteStatistics(std::vector<BoomaRemoteStatistics>* statistics) {
+
+    // Remote head, queue depth in samples (TCP) or datagrams (UDP)
+    BoomaRemoteStatistics head;
+    head.Name = "head";
+    if( _udpReader != nullptr ) {
+        _udpReader->GetStatistics(&head);
+        statistics->push_back(head);
+    } else if( _wireDecoder != nullptr ) {
+        _wireDecoder->GetStatistics(&head);
+        statistics->push_back(head);
+    }
+
+    // Remote input server, one stream per head. Queue depth in blocks waiting for the head
+    size_t streams = _udpSenders.size() > 0 ? _udpSenders.size() : _wireEncoders.size();
+    for( size_t i = 0; i < streams; i++ ) {
+        BoomaRemoteStatistics server;
+        server.Name = "server_" + std::to_string(i);
+        if( _udpSenders.size() > 0 ) {
+            _udpSenders.at(i)->GetStatistics(&server);
+        } else {
+            _wireEncoders.at(i)->GetStatistics(&server);
+        }
+        server.QueueDepth = 0;
+        server.Dropped = GetInputOverflows();
+        if( _fanout != nullptr ) {
+            server.QueueDepth = _fanout->GetClient(i)->GetQueueDepth();
+            server.Dropped += _fanout->GetClient(i)->GetDropped();
+        }
+        statistics->push_back(server);
+    }
+}
@@ -0,0 +1,20 @@
+#include "boomaiqgenerator.h"
+
+BoomaIqGenerator::BoomaIqGenerator(std::string id, int samplerate, int frequency, int amplitude):
+        HReader<int16_t>(id),
+        _amplitude(amplitude) {
+
+    HLog("Generating IQ samples at %d Hz", frequency);
+    _oscillator.SetFrequency(frequency, samplerate);
+}
+
+int BoomaIqGenerator::Read(int16_t* dest, size_t blocksize) {
+
+    // Rotate a constant phasor
+    for( size_t i = 0; i + 1 < blocksize; i += 2 ) {
+        dest[i] = _amplitude;
+        dest[i + 1] = 0;
+    }
+    _oscillator.Mix(dest, blocksize);
+    return blocksize;
+}
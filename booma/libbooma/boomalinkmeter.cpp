@@ -0,0 +1,77 @@
+#include "boomalinkmeter.h"
+
+BoomaLinkMeter::BoomaLinkMeter():
+        _windowStart(std::chrono::steady_clock::now()),
+        _bytes(0),
+        _delaySum(0),
+        _delayMax(0),
+        _delayMin(0),
+        _delays(0),
+        _bytesPerSecond(0),
+        _latency(0),
+        _maxLatency(0),
+        _jitter(0),
+        _drift(0),
+        _previousMin(0),
+        _hasTimestamps(false) {}
+
+uint64_t BoomaLinkMeter::Now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void BoomaLinkMeter::Roll() {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - _windowStart).count();
+    if( seconds < 1 ) {
+        return;
+    }
+
+    _bytesPerSecond = _bytes / seconds;
+    if( _delays > 0 ) {
+        _latency = _delaySum / _delays;
+        _maxLatency = _delayMax;
+        _jitter = _latency - _delayMin;
+
+        // Drift of the smallest delay, smoothed since the smallest delay is noisy
+        if( _hasTimestamps ) {
+            double ppm = ((_delayMin - _previousMin) / 1000) / seconds * 1000000;
+            _drift = (0.9 * _drift) + (0.1 * ppm);
+        }
+        _previousMin = _delayMin;
+        _hasTimestamps = true;
+    }
+
+    _windowStart = now;
+    _bytes = 0;
+    _delaySum = 0;
+    _delayMax = 0;
+    _delayMin = 0;
+    _delays = 0;
+}
+
+void BoomaLinkMeter::AddBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Roll();
+    _bytes += bytes;
+}
+
+void BoomaLinkMeter::AddTimestamp(uint64_t timestamp) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Roll();
+    double delay = ((double) ((int64_t) (Now() - timestamp))) / 1000;
+    _delaySum += delay;
+    _delayMax = _delays == 0 || delay > _delayMax ? delay : _delayMax;
+    _delayMin = _delays == 0 || delay < _delayMin ? delay : _delayMin;
+    _delays++;
+}
+
+void BoomaLinkMeter::GetStatistics(BoomaRemoteStatistics* statistics) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Roll();
+    statistics->BytesPerSecond = _bytesPerSecond;
+    statistics->Latency = _latency;
+    statistics->MaxLatency = _maxLatency;
+    statistics->Jitter = _jitter;
+    statistics->ClockDrift = _drift;
+    statistics->HasTimestamps = _hasTimestamps;
+}
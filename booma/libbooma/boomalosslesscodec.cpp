@@ -0,0 +1,295 @@
+#include <cstring>
+#include <cstdlib>
+
+#include <hardtapi.h>
+
+#include "boomalosslesscodec.h"
+#include "boomalittleendian.h"
+#include "boomainputexception.h"
+
+// Residuals with a rice quotient of this size or more are stored with a fixed number of bits
+#define RICE_ESCAPE 32
+#define RICE_ESCAPE_BITS 20
+#define RICE_MAX_PARAMETER 20
+
+// Order value for channels stored without compression
+#define RAW_ORDER 255
+
+/** Write bits, most significant bit first */
+class BoomaBitWriter {
+
+    private:
+
+        std::vector<uint8_t>* _out;
+        uint64_t _accumulator;
+        int _bits;
+
+    public:
+
+        BoomaBitWriter(std::vector<uint8_t>* out):
+            _out(out),
+            _accumulator(0),
+            _bits(0) {}
+
+        void Write(uint32_t value, int bits) {
+            _accumulator = (_accumulator << bits) | (value & ((1ULL << bits) - 1));
+            _bits += bits;
+            while( _bits >= 8 ) {
+                _bits -= 8;
+                _out->push_back((_accumulator >> _bits) & 0xff);
+            }
+        }
+
+        void Flush() {
+            if( _bits > 0 ) {
+                _out->push_back((_accumulator << (8 - _bits)) & 0xff);
+                _bits = 0;
+            }
+        }
+};
+
+/** Read bits, most significant bit first */
+class BoomaBitReader {
+
+    private:
+
+        const uint8_t* _data;
+        size_t _size;
+        size_t _position;
+        bool _isOverrun;
+
+    public:
+
+        BoomaBitReader(const uint8_t* data, size_t size):
+            _data(data),
+            _size(size * 8),
+            _position(0),
+            _isOverrun(false) {}
+
+        int Bit() {
+            if( _position >= _size ) {
+                _isOverrun = true;
+                return 1;
+            }
+            int bit = (_data[_position >> 3] >> (7 - (_position & 7))) & 1;
+            _position++;
+            return bit;
+        }
+
+        uint32_t Read(int bits) {
+            uint32_t value = 0;
+            for( int i = 0; i < bits; i++ ) {
+                value = (value << 1) | Bit();
+            }
+            return value;
+        }
+
+        void Align() {
+            _position = (_position + 7) & ~((size_t) 7);
+        }
+
+        bool IsOverrun() {
+            return _isOverrun;
+        }
+};
+
+bool BoomaLosslessCodec::WriteFileHeader(FILE* file, int channels, int samplerate) {
+    uint8_t header[FileHeaderSize] = { 'B', 'L', 'C', '1', (uint8_t) channels, 0, 0, 0 };
+    WriteLittleEndian(&header[8], samplerate, 4);
+    return fwrite(header, 1, FileHeaderSize, file) == FileHeaderSize;
+}
+
+bool BoomaLosslessCodec::ReadFileHeader(FILE* file, int* channels, int* samplerate) {
+    uint8_t header[FileHeaderSize];
+    if( fread(header, 1, FileHeaderSize, file) != FileHeaderSize || memcmp(header, "BLC1", 4) != 0 || header[4] == 0 ) {
+        return false;
+    }
+    *channels = header[4];
+    *samplerate = ReadLittleEndian(&header[8], 4);
+    return true;
+}
+
+void BoomaLosslessCodec::Encode(const int16_t* samples, int length, int channels, std::vector<uint8_t>* frame) {
+
+    int n = length / channels;
+    std::vector<uint8_t> payload;
+    std::vector<int32_t> x(n);
+    std::vector<uint32_t> residuals(n);
+    for( int channel = 0; channel < channels; channel++ ) {
+        for( int i = 0; i < n; i++ ) {
+            x[i] = samples[(i * channels) + channel];
+        }
+
+        // Select the predictor with the smallest residuals
+        int64_t sums[4] = { 0, 0, 0, 0 };
+        for( int i = 3; i < n; i++ ) {
+            int32_t e0 = x[i];
+            int32_t e1 = e0 - x[i - 1];
+            int32_t e2 = e1 - (x[i - 1] - x[i - 2]);
+            int32_t e3 = e2 - (x[i - 1] - (2 * x[i - 2]) + x[i - 3]);
+            sums[0] += abs(e0);
+            sums[1] += abs(e1);
+            sums[2] += abs(e2);
+            sums[3] += abs(e3);
+        }
+        int order = 0;
+        for( int i = 1; i < 4 && n > 3; i++ ) {
+            order = sums[i] < sums[order] ? i : order;
+        }
+
+        // Zig-zag encoded residuals
+        for( int i = order; i < n; i++ ) {
+            int32_t prediction = order == 0 ? 0
+                    : order == 1 ? x[i - 1]
+                    : order == 2 ? (2 * x[i - 1]) - x[i - 2]
+                    : (3 * x[i - 1]) - (3 * x[i - 2]) + x[i - 3];
+            int32_t residual = x[i] - prediction;
+            residuals[i] = ((uint32_t) residual << 1) ^ (uint32_t) (residual >> 31);
+        }
+
+        // Select the rice parameter giving the fewest bits
+        int parameter = 0;
+        uint64_t best = UINT64_MAX;
+        for( int k = 0; k <= RICE_MAX_PARAMETER; k++ ) {
+            uint64_t bits = (uint64_t) (n - order) * (k + 1);
+            for( int i = order; i < n; i++ ) {
+                bits += residuals[i] >> k;
+            }
+            if( bits < best ) {
+                best = bits;
+                parameter = k;
+            }
+        }
+
+        // Encode the channel
+        size_t start = payload.size();
+        BoomaBitWriter writer(&payload);
+        writer.Write(order, 8);
+        writer.Write(parameter, 8);
+        for( int i = 0; i < order; i++ ) {
+            writer.Write((uint16_t) x[i], 16);
+        }
+        for( int i = order; i < n; i++ ) {
+            uint32_t quotient = residuals[i] >> parameter;
+            if( quotient < RICE_ESCAPE ) {
+                writer.Write(1, quotient + 1);
+                writer.Write(residuals[i], parameter);
+            } else {
+                writer.Write(0, RICE_ESCAPE);
+                writer.Write(residuals[i], RICE_ESCAPE_BITS);
+            }
+        }
+        writer.Flush();
+
+        // Store the channel raw if it did not compress
+        if( payload.size() - start > 2 + (n * sizeof(int16_t)) ) {
+            payload.resize(start);
+            BoomaBitWriter raw(&payload);
+            raw.Write(RAW_ORDER, 8);
+            raw.Write(0, 8);
+            for( int i = 0; i < n; i++ ) {
+                raw.Write((uint16_t) x[i], 16);
+            }
+        }
+    }
+
+    // Frame header and payload
+    uint8_t header[FrameHeaderSize] = { 'B', 'L', 'C', 'F' };
+    WriteLittleEndian(&header[4], length, 2);
+    WriteLittleEndian(&header[6], payload.size(), 4);
+    frame->assign(header, header + FrameHeaderSize);
+    frame->insert(frame->end(), payload.begin(), payload.end());
+}
+
+bool BoomaLosslessCodec::Decode(FILE* file, int channels, std::vector<int16_t>* samples) {
+
+    // Frame header
+    std::vector<uint8_t> frame(FrameHeaderSize);
+    if( fread(frame.data(), 1, FrameHeaderSize, file) != FrameHeaderSize ) {
+        return false;
+    }
+    if( memcmp(frame.data(), "BLCF", 4) != 0 ) {
+        HError("Corrupt frame in BLC file");
+        return false;
+    }
+    // Check the sizes before allocating, a corrupt header could ask for gigabytes
+    int length = ReadLittleEndian(&frame[4], 2);
+    size_t size = ReadLittleEndian(&frame[6], 4);
+    if( length > MaxFrameSamples || size > GetMaxPayloadSize(length, channels) ) {
+        HError("Corrupt frame in BLC file, %d samples in %lu bytes", length, (unsigned long) size);
+        throw new BoomaInputException("Corrupt frame in BLC file");
+    }
+    frame.resize(FrameHeaderSize + size);
+    if( fread(&frame[FrameHeaderSize], 1, size, file) != size ) {
+        HLog("Truncated frame at the end of BLC file");
+        return false;
+    }
+
+    return DecodeFrame(frame.data(), frame.size(), channels, samples);
+}
+
+bool BoomaLosslessCodec::DecodeFrame(const uint8_t* frame, size_t frameSize, int channels, std::vector<int16_t>* samples) {
+
+    // Frame header
+    if( frameSize < FrameHeaderSize || memcmp(frame, "BLCF", 4) != 0 ) {
+        HError("Corrupt BLC frame");
+        return false;
+    }
+    int length = ReadLittleEndian(&frame[4], 2);
+    size_t size = ReadLittleEndian(&frame[6], 4);
+    if( frameSize < FrameHeaderSize + size ) {
+        HError("Truncated BLC frame");
+        return false;
+    }
+    if( size > GetMaxPayloadSize(length, channels) ) {
+        HError("Corrupt BLC frame");
+        return false;
+    }
+    const uint8_t* payload = &frame[FrameHeaderSize];
+
+    // Decode each channel
+    int n = length / channels;
+    size_t base = samples->size();
+    samples->resize(base + (n * channels));
+    std::vector<int32_t> x(n);
+    BoomaBitReader reader(payload, size);
+    for( int channel = 0; channel < channels; channel++ ) {
+        int order = reader.Read(8);
+        int parameter = reader.Read(8);
+        if( order == RAW_ORDER ) {
+            for( int i = 0; i < n; i++ ) {
+                x[i] = (int16_t) reader.Read(16);
+            }
+        } else {
+            for( int i = 0; i < order && i < n; i++ ) {
+                x[i] = (int16_t) reader.Read(16);
+            }
+            for( int i = order; i < n; i++ ) {
+                uint32_t quotient = 0;
+                while( quotient < RICE_ESCAPE && reader.Bit() == 0 ) {
+                    quotient++;
+                }
+                uint32_t value = quotient == RICE_ESCAPE
+                        ? reader.Read(RICE_ESCAPE_BITS)
+                        : (quotient << parameter) | reader.Read(parameter);
+                int32_t residual = (int32_t) (value >> 1) ^ -((int32_t) (value & 1));
+                int32_t prediction = order == 0 ? 0
+                        : order == 1 ? x[i - 1]
+                        : order == 2 ? (2 * x[i - 1]) - x[i - 2]
+                        : (3 * x[i - 1]) - (3 * x[i - 2]) + x[i - 3];
+                x[i] = prediction + residual;
+            }
+        }
+        reader.Align();
+
+        for( int i = 0; i < n; i++ ) {
+            (*samples)[base + (i * channels) + channel] = x[i];
+        }
+    }
+
+    if( reader.IsOverrun() ) {
+        HError("Corrupt BLC frame");
+        return false;
+    }
+    return true;
+}
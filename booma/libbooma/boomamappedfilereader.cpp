@@ -0,0 +1,118 @@
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "boomamappedfilereader.h"
+#include "boomafilesegmentreader.h"
+#include "boomainputexception.h"
+
+// Release pages that has been read for every 16MB
+#define MAPPED_RELEASE_SIZE (16 * 1024 * 1024)
+
+BoomaMappedFileReader::BoomaMappedFileReader(std::string id, std::string filename, bool isWav, long first, long length):
+        HReader<int16_t>(id),
+        _fd(-1),
+        _map(MAP_FAILED),
+        _mapSize(0),
+        _dataOffset(0),
+        _samples(nullptr),
+        _length(0),
+        _position(0),
+        _released(0) {
+
+    // Find the samples in the file
+    long offset;
+    long available;
+    if( !BoomaFileSegmentReader::GetLayout(filename, isWav, &offset, &available) ) {
+        throw new BoomaInputException("Unable to read the layout of the input file");
+    }
+    first = first < available ? first : available;
+    _length = length >= 0 && first + length <= available ? length : available - first;
+    _dataOffset = offset + (first * sizeof(int16_t));
+
+    // Map the file
+    struct stat stats;
+    _fd = open(filename.c_str(), O_RDONLY);
+    if( _fd == -1 || fstat(_fd, &stats) == -1 ) {
+        HError("Unable to open %s", filename.c_str());
+        if( _fd != -1 ) {
+            close(_fd);
+        }
+        throw new BoomaInputException("Unable to open input file");
+    }
+    _mapSize = stats.st_size;
+    if( _mapSize > 0 ) {
+        _map = mmap(nullptr, _mapSize, PROT_READ, MAP_SHARED, _fd, 0);
+        if( _map == MAP_FAILED ) {
+            HError("Unable to map %s into memory", filename.c_str());
+            close(_fd);
+            throw new BoomaInputException("Unable to map input file into memory");
+        }
+        madvise(_map, _mapSize, MADV_SEQUENTIAL);
+        _samples = (const int16_t*) ((char*) _map + _dataOffset);
+    }
+    HLog("Mapped %ld samples from %s (first sample %ld)", _length, filename.c_str(), first);
+}
+
+BoomaMappedFileReader::~BoomaMappedFileReader() {
+    if( _map != MAP_FAILED ) {
+        munmap(_map, _mapSize);
+    }
+    close(_fd);
+}
+
+int BoomaMappedFileReader::Read(int16_t* dest, size_t blocksize) {
+    long position = _position;
+    if( position >= _length ) {
+        return 0;
+    }
+
+    // Copy the next block directly from the mapping, padding the last (partial) block with zeros
+    size_t length = _length - position < (long) blocksize ? _length - position : blocksize;
+    memcpy((void*) dest, (void*) &_samples[position], length * sizeof(int16_t));
+    if( length < blocksize ) {
+        memset((void*) &dest[length], 0, (blocksize - length) * sizeof(int16_t));
+    }
+
+    // Advance, unless we have been repositioned while reading
+    _position.compare_exchange_strong(position, position + length);
+    Release(position + length);
+    return blocksize;
+}
+
+void BoomaMappedFileReader::Release(long position) {
+
+    // Release whole pages behind the read position
+    size_t released = _released;
+    size_t end = _dataOffset + (position * sizeof(int16_t));
+    if( end < released + MAPPED_RELEASE_SIZE ) {
+        return;
+    }
+    size_t page = sysconf(_SC_PAGESIZE);
+    end = (end / page) * page;
+    madvise((char*) _map + released, end - released, MADV_DONTNEED);
+    _released = end;
+}
+
+const int16_t* BoomaMappedFileReader::GetWindow(long position, size_t length) {
+    if( position < 0 || position + (long) length > _length ) {
+        return nullptr;
+    }
+    return &_samples[position];
+}
+
+bool BoomaMappedFileReader::Seek(long position) {
+    if( position < 0 || position > _length ) {
+        HError("Seek position %ld is outside the input file (%ld samples)", position, _length);
+        return false;
+    }
+    HLog("Seeking to sample %ld", position);
+    _position = position;
+
+    // Restart readahead and page release from the new position
+    size_t page = sysconf(_SC_PAGESIZE);
+    _released = ((_dataOffset + (position * sizeof(int16_t))) / page) * page;
+    return true;
+}
@@ -1,29 +1,36 @@
 #include "boomaoutput.h"
 
-BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver):
+BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver, std::string outputFilename, std::string dumpPrefix):
         _outputVolume(nullptr),
         _outputFilter(nullptr),
         _soundcardMultiplexer(nullptr),
         _soundcardWriter(nullptr),
         _nullWriter(nullptr),
         _audioWriter(nullptr),
+        _audioCapture(nullptr),
         _pcmWriter(nullptr),
         _wavWriter(nullptr),
         _audioSplitter(nullptr),
         _audioBreaker(nullptr),
         _audioBuffer(nullptr),
+        _audioDelay(nullptr),
         _frequencyAlignmentGenerator(nullptr),
         _frequencyAlignmentMixer(nullptr),
         _ifSplitter(nullptr),
         _signalLevel(nullptr),
         _signalLevelWriter(nullptr),
+        _signalTrigger(nullptr),
+        _triggerAudio(opts->GetTriggerAudio()),
+        _triggerRfCapture(nullptr),
+        _signalLevelSeconds((double) (SIGNALLEVEL_AVERAGING_COUNT * BLOCKSIZE) / opts->GetOutputSampleRate()),
         _outputFilterWidth(receiver->GetOutputFilterWidth()),
         _audioFft(nullptr),
         _audioFftWindow(nullptr),
         _audioFftWriter(nullptr),
         _audioSpectrum(nullptr),
         _audioFftSize(256),
-        _audioFftGain(nullptr) {
+        _audioFftGain(nullptr),
+        _timing(opts->GetStageTiming()) {
 
     // AF fft spectrum output
     _audioSpectrumSize = _audioFftSize / 2;
@@ -31,35 +38,60 @@ BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver):
     memset((void*) _audioSpectrum, 0, sizeof(double) * _audioSpectrumSize);
 
     // Final output filter to remove high frequencies
-    _outputFilter = new HFirFilter<int16_t>("output_high_frequence_fir", receiver->GetLastWriterConsumer(), HLowpassKaiserBessel<int16_t>(_outputFilterWidth, opts->GetOutputSampleRate(), 15, 90).Calculate(), 15, BLOCKSIZE);
+    _outputFilter = new HFirFilter<int16_t>("output_high_frequence_fir", _timing.Probe("output_filter", receiver->GetLastWriterConsumer()), HLowpassKaiserBessel<int16_t>(_outputFilterWidth, opts->GetOutputSampleRate(), 15, 90).Calculate(), 15, BLOCKSIZE);
 
     // Setup a splitter to split off audio dump
     HLog("Setting up output audio splitter");
     _audioSplitter = new HSplitter<int16_t>("output_audio_splitter", _outputFilter->Consumer());
-    _audioDelay = new HDelay<int16_t>("output_audio_delay", _audioSplitter->Consumer(), BLOCKSIZE, opts->GetOutputSampleRate(), 10);
-    _audioBreaker = new HBreaker<int16_t>("output_audio_breaker", _audioDelay->Consumer(), !opts->GetDumpAudio(), BLOCKSIZE);
+    HWriterConsumer<int16_t>* audioDump = _timing.Probe("output_audio_dump", _audioSplitter->Consumer());
+    if( !opts->GetBatchMode() ) {
+        _audioDelay = new HDelay<int16_t>("output_audio_delay", audioDump, BLOCKSIZE, opts->GetOutputSampleRate(), 10);
+        audioDump = _audioDelay->Consumer();
+    }
+    _audioBreaker = new HBreaker<int16_t>("output_audio_breaker", audioDump, !opts->GetDumpAudio(), BLOCKSIZE);
     _audioBuffer = new HBufferedWriter<int16_t>("output_audio_buffer", _audioBreaker->Consumer(), BLOCKSIZE, opts->GetReservedBuffers(), opts->GetEnableBuffers());
-    std::string dumpfile = "OUTPUT_" + (opts->GetDumpFileSuffix() == "" ? std::to_string(std::time(nullptr)) : opts->GetDumpFileSuffix());
-    if( opts->GetDumpAudioFileFormat() == WAV ) {
+    std::string dumpfile = dumpPrefix + "_" + (opts->GetDumpFileSuffix() == "" ? std::to_string(std::time(nullptr)) : opts->GetDumpFileSuffix());
+    if( opts->GetDumpSegmented() && opts->GetDumpAudioFileFormat() != BLC ) {
+        _audioWriter = new BoomaSegmentedWriter("output_audio_segmented_writer", dumpfile, opts->GetDumpAudioFileFormat() == WAV, opts->GetOutputSampleRate(), 1,
+                                                opts->GetDumpSegmentMinutes() * 60, (off_t) opts->GetDumpSegmentSize() * 1024 * 1024, (off_t) opts->GetDumpSegmentLimit() * 1024 * 1024, _audioBuffer->Consumer(), opts->GetBatchMode());
+    } else if( opts->GetAsyncDump() && opts->GetDumpAudioFileFormat() != BLC ) {
+        bool isWav = opts->GetDumpAudioFileFormat() == WAV;
+        _audioWriter = new BoomaAsyncFileWriter("output_audio_async_writer", dumpfile + (isWav ? ".wav" : ".pcm"), isWav, opts->GetOutputSampleRate(), _audioBuffer->Consumer(), opts->GetBatchMode());
+    } else if( opts->GetDumpAudioFileFormat() == WAV ) {
         _audioWriter = new HWavWriter<int16_t>("output_audio_wav_writer", (dumpfile + ".wav").c_str(), H_SAMPLE_FORMAT_INT_16, 1, opts->GetOutputSampleRate(), _audioBuffer->Consumer(), true);
+    } else if( opts->GetDumpAudioFileFormat() == BLC ) {
+        _audioWriter = new BoomaCompressedWriter("output_audio_blc_writer", dumpfile + ".blc", 1, opts->GetOutputSampleRate(), _audioBuffer->Consumer());
     } else {
         _audioWriter = new HFileWriter<int16_t>("output_audio_pcm_writer", (dumpfile + ".pcm").c_str(), _audioBuffer->Consumer(), true);
     }
 
+    // Keep the last seconds of audio in memory
+    if( opts->GetCaptureSeconds() > 0 && !opts->GetBatchMode() ) {
+        HLog("Setting up the audio capture buffer");
+        _audioCapture = new BoomaCaptureBuffer("output_audio_capture", dumpPrefix + "_CAPTURE", opts->GetCaptureSeconds(), opts->GetOutputSampleRate(), 1,
+                                               _timing.Probe("output_audio_capture", _audioSplitter->Consumer()));
+    }
+
+    // Start and stop captures when the signal level crosses the trigger level
+    if( opts->GetTriggerLevel() > 0 && _audioCapture != nullptr ) {
+        HLog("Enabling recordings triggered at signal level S%d", opts->GetTriggerLevel());
+        _signalTrigger = new BoomaSignalTrigger(opts->GetTriggerLevel(), opts->GetTriggerHold(), opts->GetTriggerRelease());
+    }
+
     // Add signallevel measurement just before the volume
     HLog("Setting up signallevel measurement");
-    _signalLevel = new HSignalLevelOutput<int16_t>("output_signal_level_splitter", _audioSplitter->Consumer(), SIGNALLEVEL_AVERAGING_COUNT, 54, 16);
+    _signalLevel = new HSignalLevelOutput<int16_t>("output_signal_level_splitter", _timing.Probe("output_signal_level", _audioSplitter->Consumer()), SIGNALLEVEL_AVERAGING_COUNT, 54, 16);
     _signalLevelWriter = HCustomWriter<HSignalLevelResult>::Create<BoomaOutput>("output_signal_level_writer", this, &BoomaOutput::SignalLevelCallback, _signalLevel->Consumer());
 
     // Add audio spectrum calculation
-    _audioFftGain = new HAgc<int16_t>("output_spectrum_gain", _audioSplitter->Consumer(), opts->GetAfFftAgcLevel(), 3,  BLOCKSIZE);
+    _audioFftGain = new HAgc<int16_t>("output_spectrum_gain", _timing.Probe("output_spectrum", _audioSplitter->Consumer()), opts->GetAfFftAgcLevel(), 3,  BLOCKSIZE);
     _audioFftWindow = new HHammingWindow<int16_t>();
     _audioFft = new HFftOutput<int16_t>("output_spectrum_fft_output", _audioFftSize, AUDIOFFT_AVERAGING_COUNT, AUDIOFFT_SKIP, _audioFftGain->Consumer(), _audioFftWindow, opts->GetOutputSampleRate(), 4, opts->GetOutputSampleRate() / 16);
     _audioFftWriter = HCustomWriter<HFftResults>::Create<BoomaOutput>("output_spectrum_writer", this, &BoomaOutput::AudioFftCallback, _audioFft->Consumer());
 
     // Add volume control
     HLog("Output volume");
-    _outputVolume = new HGain<int16_t>("output_volume_control", _audioSplitter->Consumer(), opts->GetVolume(), BLOCKSIZE);
+    _outputVolume = new HGain<int16_t>("output_volume_control", _timing.Probe("output_volume", _audioSplitter->Consumer()), opts->GetVolume(), BLOCKSIZE);
 
     // Enable frequency alignment ?
     if( opts->GetFrequencyAlign() ) {
@@ -68,16 +100,17 @@ BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver):
         _frequencyAlignmentMixer = new HLinearMixer<int16_t>("output_frequency_alignment_mixer", _frequencyAlignmentGenerator->Reader(), _outputVolume->Consumer(), BLOCKSIZE);
     }
 
-    // Select output device
-    if( opts->GetOutputFilename() != "" ) {
-        HLog("Writing output audio to %s", opts->GetOutputFilename().c_str());
-        if( IsWav(opts->GetOutputFilename()) ) {
+    // Select output device. An explicit output filename overrides the configured output
+    std::string filename = outputFilename != "" ? outputFilename : opts->GetOutputFilename();
+    if( filename != "" ) {
+        HLog("Writing output audio to %s", filename.c_str());
+        if( IsWav(filename) ) {
             HLog("Creating output wav file");
-            _wavWriter = new HWavWriter<int16_t>("output_audio_wav_writer", opts->GetOutputFilename().c_str(), H_SAMPLE_FORMAT_INT_16, 1, opts->GetOutputSampleRate(), GetOutputVolumeConsumer());
+            _wavWriter = new HWavWriter<int16_t>("output_audio_wav_writer", filename.c_str(), H_SAMPLE_FORMAT_INT_16, 1, opts->GetOutputSampleRate(), _timing.Probe("output_writer", GetOutputVolumeConsumer()));
             _pcmWriter = nullptr;
         } else {
             HLog("Creating output pcm file");
-            _pcmWriter = new HFileWriter<int16_t>("output_audio_pcm_writer", opts->GetOutputFilename().c_str(), GetOutputVolumeConsumer());
+            _pcmWriter = new HFileWriter<int16_t>("output_audio_pcm_writer", filename.c_str(), _timing.Probe("output_writer", GetOutputVolumeConsumer()));
             _wavWriter = nullptr;
         }
         _soundcardWriter = nullptr;
@@ -85,7 +118,7 @@ BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver):
     }
     else if( opts->GetOutputAudioDevice() == -1 ) {
         HLog("Writing output audio to /dev/null device");
-        _nullWriter = new HNullWriter<int16_t>("output_null_writer", GetOutputVolumeConsumer());
+        _nullWriter = new HNullWriter<int16_t>("output_null_writer", _timing.Probe("output_writer", GetOutputVolumeConsumer()));
         _soundcardWriter = nullptr;
         _pcmWriter = nullptr;
         _wavWriter = nullptr;
@@ -94,7 +127,7 @@ BoomaOutput::BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver):
     {
         HLog("Initializing multiplexer for 2-channel mono output");
         std::vector<HWriterConsumer<int16_t>*> consumers;
-        consumers.push_back(GetOutputVolumeConsumer());
+        consumers.push_back(_timing.Probe("output_writer", GetOutputVolumeConsumer()));
         _soundcardMultiplexer = new HMux<int16_t>("output_multiplexer", consumers, BLOCKSIZE, true);
 
         HLog("Initializing audio output device %d", opts->GetOutputAudioDevice());
@@ -115,9 +148,12 @@ BoomaOutput::~BoomaOutput() {
     SAFE_DELETE(_pcmWriter);
     SAFE_DELETE(_wavWriter);
     SAFE_DELETE(_audioWriter);
+    SAFE_DELETE(_audioCapture);
+    SAFE_DELETE(_signalTrigger);
     SAFE_DELETE(_audioSplitter);
     SAFE_DELETE(_audioBreaker);
     SAFE_DELETE(_audioBuffer);
+    SAFE_DELETE(_audioDelay);
     SAFE_DELETE(_frequencyAlignmentGenerator);
     SAFE_DELETE(_frequencyAlignmentMixer);
     SAFE_DELETE(_ifSplitter);
@@ -135,6 +171,20 @@ bool BoomaOutput::SetDumpAudio(bool enabled) {
     return !_audioBreaker->GetOff();
 }
 
+bool BoomaOutput::CaptureAudio(int seconds) {
+    return _audioCapture != nullptr && _audioCapture->Capture(seconds);
+}
+
+void BoomaOutput::StopCaptureAudio() {
+    if( _audioCapture != nullptr ) {
+        _audioCapture->StopCapture();
+    }
+}
+
+bool BoomaOutput::IsCapturingAudio() {
+    return _audioCapture != nullptr && _audioCapture->IsCapturing();
+}
+
 int BoomaOutput::SetVolume(int volume) {
     if( volume > 100 || volume < 0 ) {
         return false;
@@ -167,6 +217,30 @@ int BoomaOutput::SignalLevelCallback(HSignalLevelResult* result, size_t length)
 
     // Store the signal sum, scaled
     _signalSum = (int) (result->Sum / BLOCKSIZE);
+
+    // Triggered recording. Captures run until stopped, the pre-trigger buffer holds the leading edge
+    if( _signalTrigger != nullptr ) {
+        switch( _signalTrigger->Update(_signalStrength, _signalLevelSeconds) ) {
+            case BoomaSignalTrigger::START:
+                HLog("Signal level S%d triggered a recording", _signalStrength);
+                if( _triggerAudio ) {
+                    _audioCapture->Capture(-1);
+                }
+                if( _triggerRfCapture != nullptr ) {
+                    _triggerRfCapture->Capture(-1);
+                }
+                break;
+            case BoomaSignalTrigger::STOP:
+                HLog("Signal level has been below the trigger level for the release time, stopping the recording");
+                _audioCapture->StopCapture();
+                if( _triggerRfCapture != nullptr ) {
+                    _triggerRfCapture->StopCapture();
+                }
+                break;
+            default:
+                break;
+        }
+    }
     return length;
 }
 
@@ -197,3 +271,12 @@ int BoomaOutput::GetAudioSpectrum(double* spectrum) {
     memcpy((void*) spectrum, _audioSpectrum, sizeof(double) * _audioSpectrumSize);
     return _audioSpectrumSize;
 }
+
+void BoomaOutput::GetDumpStatistics(std::vector<BoomaAsyncWriterStatistics>* statistics) {
+    BoomaAsyncWriter* writer = dynamic_cast<BoomaAsyncWriter*>(_audioWriter);
+    if( writer != nullptr ) {
+        BoomaAsyncWriterStatistics audio;
+        writer->GetStatistics(&audio);
+        statistics->push_back(audio);
+    }
+}
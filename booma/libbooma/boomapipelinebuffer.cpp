@@ -0,0 +1,179 @@
+#include <cstring>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "boomapipelinebuffer.h"
+
+BoomaPipelineBuffer::BoomaPipelineBuffer(std::string id, HWriterConsumer<int16_t>* previous, int depth, size_t blocksize, int cpu):
+        HWriter<int16_t>(id),
+        _writer(nullptr),
+        _name(id),
+        _depth(depth),
+        _blocksize(blocksize),
+        _cpu(cpu),
+        _queue(depth, nullptr),
+        _lengths(depth, 0),
+        _enqueued(depth),
+        _head(0),
+        _count(0),
+        _thread(nullptr),
+        _isRunning(false),
+        _highWater(0),
+        _blocks(0),
+        _fullWaits(0),
+        _totalLatency(0),
+        _maxLatency(0) {
+
+    HLog("Creating pipeline buffer '%s' with depth %d (cpu %d)", id.c_str(), depth, cpu);
+    for( int i = 0; i < depth; i++ ) {
+        _queue[i] = new int16_t[blocksize];
+    }
+    previous->SetWriter(this);
+}
+
+BoomaPipelineBuffer::~BoomaPipelineBuffer() {
+    StopWorker();
+    for( int i = 0; i < _depth; i++ ) {
+        delete[] _queue[i];
+    }
+}
+
+bool BoomaPipelineBuffer::Start() {
+    StartWorker();
+    return _writer != nullptr ? _writer->Start() : true;
+}
+
+bool BoomaPipelineBuffer::Stop() {
+    StopWorker();
+    return _writer != nullptr ? _writer->Stop() : true;
+}
+
+void BoomaPipelineBuffer::StartWorker() {
+    std::lock_guard<std::mutex> workerLock(_workerMutex);
+    if( _thread == nullptr ) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isRunning = true;
+        }
+        _thread = new std::thread(&BoomaPipelineBuffer::WorkerThread, this);
+    }
+}
+
+void BoomaPipelineBuffer::StopWorker() {
+    std::lock_guard<std::mutex> workerLock(_workerMutex);
+    if( _thread != nullptr ) {
+
+        // The worker drains the queue before it stops, a writer waiting for a free block
+        // is released when it has been drained
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isRunning = false;
+        }
+        _notEmpty.notify_all();
+        _notFull.notify_all();
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+}
+
+void BoomaPipelineBuffer::SetAffinity() {
+    if( _cpu < 0 ) {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(_cpu, &cpus);
+    if( pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) != 0 ) {
+        HError("Failed to set affinity for pipeline buffer '%s' to cpu %d", _name.c_str(), _cpu);
+    }
+#else
+    HLog("Cpu affinity is not supported on this platform");
+#endif
+}
+
+int BoomaPipelineBuffer::Write(int16_t* src, size_t blocksize) {
+
+    if( blocksize != _blocksize ) {
+        HError("Pipeline buffer write with blocksize %d, expected %d", blocksize, _blocksize);
+        return 0;
+    }
+
+    // Wait for a free block, nothing is queued when the worker is not running
+    std::unique_lock<std::mutex> lock(_mutex);
+    if( _isRunning && _count == _depth ) {
+        _fullWaits++;
+        _notFull.wait(lock, [this] { return _count < _depth || !_isRunning; });
+    }
+    if( !_isRunning ) {
+        return 0;
+    }
+
+    // Copy into the queue
+    int slot = (_head + _count) % _depth;
+    memcpy((void*) _queue[slot], (void*) src, blocksize * sizeof(int16_t));
+    _lengths[slot] = blocksize;
+    _enqueued[slot] = std::chrono::steady_clock::now();
+    _count++;
+    _highWater = _count > _highWater ? _count : _highWater;
+    lock.unlock();
+    _notEmpty.notify_one();
+
+    return blocksize;
+}
+
+void BoomaPipelineBuffer::WorkerThread() {
+    SetAffinity();
+    HLog("Pipeline buffer '%s' worker thread started", _name.c_str());
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while( true ) {
+        _notEmpty.wait(lock, [this] { return _count > 0 || !_isRunning; });
+        if( _count == 0 ) {
+            break;
+        }
+
+        // Keep the block in the queue while it is being written, so that it is not overwritten
+        int slot = _head;
+        double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _enqueued[slot]).count();
+        _blocks++;
+        _totalLatency += latency;
+        _maxLatency = latency > _maxLatency ? latency : _maxLatency;
+        lock.unlock();
+
+        if( _writer != nullptr ) {
+            _writer->Write(_queue[slot], _lengths[slot]);
+        }
+
+        lock.lock();
+        _head = (_head + 1) % _depth;
+        _count--;
+        _notFull.notify_one();
+    }
+    HLog("Pipeline buffer '%s' worker thread stopped", _name.c_str());
+}
+
+BoomaPipelineStatistics BoomaPipelineBuffer::GetStatistics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    BoomaPipelineStatistics statistics;
+    statistics.Name = _name;
+    statistics.Depth = _depth;
+    statistics.HighWater = _highWater;
+    statistics.Blocks = _blocks;
+    statistics.FullWaits = _fullWaits;
+    statistics.AverageLatency = _blocks > 0 ? _totalLatency / _blocks : 0;
+    statistics.MaxLatency = _maxLatency;
+    return statistics;
+}
+
+void BoomaPipelineBuffer::ResetStatistics() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _highWater = _count;
+    _blocks = 0;
+    _fullWaits = 0;
+    _totalLatency = 0;
+    _maxLatency = 0;
+}
@@ -30,9 +30,12 @@ bool BoomaReceiver::SetOption(ConfigOptions* opts, std::string name, int value){
                     }
                     opts->SetReceiverOptionsFor(GetName(), optionsMap);
 
-                    // Report the change to the receiver implementation
+                    // Report the change to the receiver implementation and the decoder
                     if( _hasBuilded ) {
                         OptionChanged(opts, name, value);
+                        if( _attachedDecoder != nullptr ) {
+                            _attachedDecoder->SetReceiverOption(name, value);
+                        }
                     }
 
                     // Receiver option set
@@ -99,6 +102,18 @@ int BoomaReceiver::SetRfGain(int gain) {
 
 void BoomaReceiver::Build(ConfigOptions* opts, BoomaInput* input, BoomaDecoder* decoder) {
 
+    // Check that the initial frequency is supported
+    if( !IsFrequencySupported(opts, opts->GetFrequency()) ) {
+        HLog("Configured frequency %ld is not valid for this receiver. Using default frequency %ld", opts->GetFrequency(), GetDefaultFrequency(opts));
+        opts->SetFrequency(GetDefaultFrequency(opts));
+    }
+
+    // Build the receiver on the input stream
+    Build(opts, input->GetLastWriterConsumer(), decoder);
+}
+
+void BoomaReceiver::Build(ConfigOptions* opts, HWriterConsumer<int16_t>* previous, BoomaDecoder* decoder) {
+
     // Can we build a receiver for the given input data type ?
     if( !IsDataTypeSupported(opts->GetInputSourceDataType()) ) {
         HError("Attempt to build receiver for unsupported input data type");
@@ -117,15 +132,9 @@ void BoomaReceiver::Build(ConfigOptions* opts, BoomaInput* input, BoomaDecoder*
         SetOption(opts, (*it).first, (*it).second);
     }
 
-    // Check that the initial frequency is supported
-    if( !IsFrequencySupported(opts, opts->GetFrequency()) ) {
-        HLog("Configured frequency %ld is not valid for this receiver. Using default frequency %ld", opts->GetFrequency(), GetDefaultFrequency(opts));
-        opts->SetFrequency(GetDefaultFrequency(opts));
-    }
-
     // Add receiver gain/agc
     _gainValue = opts->GetRfGain();
-    _rfAgc = new HAgc<int16_t>("receiver_agc", input->GetLastWriterConsumer(), GetRfAgcLevel(opts), 10, BLOCKSIZE, 6, false);
+    _rfAgc = new HAgc<int16_t>("receiver_agc", _timing.Probe("receiver_agc", previous), GetRfAgcLevel(opts), 10, BLOCKSIZE, 6, false);
     if( opts->GetRfGain() != 0 ) {
         if( opts->GetRfGainEnabled() ) {
             float g =
@@ -137,18 +146,32 @@ void BoomaReceiver::Build(ConfigOptions* opts, BoomaInput* input, BoomaDecoder*
     }
 
     // Add preprocessing part of the receiver
-    _preProcess = PreProcess(opts, _rfAgc);
+    _preProcess = PreProcess(opts, _timing.Probe("receiver_preprocess", _rfAgc->Consumer()));
 
     // Add the receiver chain
-    _receive = Receive(opts, _preProcess);
+    _receive = Receive(opts, _timing.Probe("receiver_receive", _preProcess));
 
     // Add postprocessing part of the receiver
-    _postProcess = PostProcess(opts, _receive);
+    _postProcess = PostProcess(opts, _timing.Probe("receiver_postprocess", _receive));
 
     // Add a splitter so that we can push fully processed samples through an optional decoder
-    _decoder = new HSplitter<int16_t>("receiver_decoder_splitter", _postProcess->Consumer());
+    _decoder = new HSplitter<int16_t>("receiver_decoder_splitter", _timing.Probe("receiver_decoder", _postProcess->Consumer()));
     if( decoder != NULL ) {
         _decoder->SetWriter(decoder->Writer());
+
+        // The decoder may depend on receiver options, give it the current values
+        _attachedDecoder = decoder;
+        for( std::vector<Option>::iterator it = _options.begin(); it != _options.end(); it++ ) {
+            decoder->SetReceiverOption((*it).Name, (*it).CurrentValue);
+        }
+    }
+
+    // Optionally run the output on a separate thread
+    if( opts->GetPipelineDepth() > 0 ) {
+        _pipeline = new BoomaPipelineBuffer("receiver_pipeline", _decoder->Consumer(), opts->GetPipelineDepth(), BLOCKSIZE, opts->GetPipelineCpu(1));
+
+        // Started before any block can reach it, and stopped when the receiver is deleted
+        _pipeline->StartWorker();
     }
 
     // Receiver has been build and all components is initialized (or so they should be!)
@@ -0,0 +1,190 @@
+#include <cstring>
+
+#include "boomaringbufferreader.h"
+
+BoomaRingBufferReader::BoomaRingBufferReader(std::string id, HReader<int16_t>* reader, int blocks, size_t blocksize, bool dropOnOverflow):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _blocksize(blocksize),
+        _blocks(blocks),
+        _dropOnOverflow(dropOnOverflow),
+        _ring(blocks, nullptr),
+        _lengths(blocks, 0),
+        _head(0),
+        _tail(0),
+        _overflowBlock(nullptr),
+        _waiters(0),
+        _isFlushRequested(false),
+        _thread(nullptr),
+        _isRunning(false),
+        _isEndOfInput(false),
+        _overflows(0),
+        _underruns(0) {
+
+    HLog("Creating input ring buffer with %d blocks (%s when full)", blocks, dropOnOverflow ? "drop" : "wait");
+    for( int i = 0; i < blocks; i++ ) {
+        _ring[i] = new int16_t[blocksize];
+    }
+    _overflowBlock = new int16_t[blocksize];
+}
+
+BoomaRingBufferReader::~BoomaRingBufferReader() {
+    Stop();
+    for( int i = 0; i < _blocks; i++ ) {
+        delete[] _ring[i];
+    }
+    delete[] _overflowBlock;
+}
+
+bool BoomaRingBufferReader::Start() {
+    if( _thread != nullptr ) {
+        return true;
+    }
+    if( !_reader->Start() ) {
+        HError("Failed to start the input reader");
+        return false;
+    }
+    _isRunning = true;
+    _isEndOfInput = false;
+    _thread = new std::thread(&BoomaRingBufferReader::ReaderThread, this);
+    return true;
+}
+
+bool BoomaRingBufferReader::Stop() {
+    if( _thread == nullptr ) {
+        return true;
+    }
+    _isRunning = false;
+    Notify();
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    if( _overflows > 0 || _underruns > 0 ) {
+        HLog("Input ring buffer stopped with %lu overflows and %lu underruns", (unsigned long) _overflows, (unsigned long) _underruns);
+    }
+    return _reader->Stop();
+}
+
+void BoomaRingBufferReader::ReaderThread() {
+    HLog("Input ring buffer reader thread started");
+    while( _isRunning ) {
+
+        // Ring full ?
+        unsigned long head = _head.load(std::memory_order_relaxed);
+        if( head - _tail.load(std::memory_order_acquire) >= (unsigned long) _blocks ) {
+
+            // Live input can not be paused, so read and drop the block
+            if( _dropOnOverflow ) {
+                if( _reader->Read(_overflowBlock, _blocksize) <= 0 ) {
+                    break;
+                }
+                _overflows++;
+                continue;
+            }
+
+            // Wait for the processing thread to catch up
+            _waiters++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(_waitMutex);
+                _changed.wait(lock, [this, head]() {
+                    return !_isRunning || head - _tail.load(std::memory_order_acquire) < (unsigned long) _blocks;
+                });
+            }
+            _waiters--;
+            continue;
+        }
+
+        // Read directly into the next free block, then publish it
+        int slot = head % _blocks;
+        int read = _reader->Read(_ring[slot], _blocksize);
+        if( read <= 0 ) {
+            break;
+        }
+        _lengths[slot] = read;
+        _head.store(head + 1, std::memory_order_release);
+        Notify();
+    }
+    _isEndOfInput = true;
+    Notify();
+    HLog("Input ring buffer reader thread stopped");
+}
+
+int BoomaRingBufferReader::Read(int16_t* dest, size_t blocksize) {
+
+    if( blocksize != _blocksize ) {
+        HError("Ring buffer read with blocksize %d, expected %d", blocksize, _blocksize);
+        return 0;
+    }
+
+    // The processing chain may not call Start() on its reader
+    if( _thread == nullptr && !Start() ) {
+        return 0;
+    }
+
+    // Drop blocks read before a retune
+    unsigned long tail = _tail.load(std::memory_order_relaxed);
+    if( _isFlushRequested.exchange(false) ) {
+        tail = _head.load(std::memory_order_acquire);
+        _tail.store(tail, std::memory_order_release);
+        Notify();
+    }
+
+    // Wait for a block, unless the input has ended and the ring has been drained
+    if( _head.load(std::memory_order_acquire) == tail ) {
+        if( tail > 0 ) {
+            _underruns++;
+        }
+        _waiters++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(_waitMutex);
+            _changed.wait(lock, [this, tail]() {
+                return _head.load(std::memory_order_acquire) != tail || _isEndOfInput;
+            });
+        }
+        _waiters--;
+        if( _head.load(std::memory_order_acquire) == tail ) {
+            return 0;
+        }
+    }
+
+    // Copy the oldest block and release it to the reader thread
+    int slot = tail % _blocks;
+    int read = _lengths[slot];
+    memcpy((void*) dest, (void*) _ring[slot], read * sizeof(int16_t));
+    _tail.store(tail + 1, std::memory_order_release);
+    if( !_dropOnOverflow ) {
+        Notify();
+    }
+    return read;
+}
+
+void BoomaRingBufferReader::Notify() {
+
+    // Only wake when the other side waits. The fences on both sides makes sure that either the
+    // waiter sees the change, or the change sees the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if( _waiters.load(std::memory_order_relaxed) == 0 ) {
+        return;
+    }
+
+    // Taking the lock orders the notification after the check of a thread about to wait
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+    }
+    _changed.notify_all();
+}
+
+bool BoomaRingBufferReader::Command(HCommand* command) {
+    if( !_reader->Command(command) ) {
+        return false;
+    }
+
+    // Blocks in the ring are from the old frequency
+    if( command->Class == H_COMMAND_CLASS::TUNER && command->Opcode == H_COMMAND_OPCODE::SET_FREQUENCY ) {
+        HLog("Flushing the input ring buffer after a retune");
+        _isFlushRequested = true;
+    }
+    return true;
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+
+#include "boomarttydecoder.h"
+#include "booma.h"
+
+// Framing states before the start bit, following states are the number of the next bit
+#define RTTY_WAIT_MARK -2
+#define RTTY_WAIT_START -1
+
+BoomaRttyDecoder::BoomaRttyDecoder(std::string id, int samplerate, std::function<void(std::string)> callback):
+        BoomaDecoder(id),
+        _callback(callback),
+        _rate(samplerate),
+        _shift(170),
+        _baudrate(4545),
+        _isReversed(false) {
+
+    Configure();
+}
+
+void BoomaRttyDecoder::Configure() {
+
+    // Mark above space, as they are given by the receiver
+    float mark = RTTY_TONE_CENTER + (_shift / 2.0f);
+    float space = RTTY_TONE_CENTER - (_shift / 2.0f);
+    _markStep = std::polar(1.0f, (float) ((-2 * M_PI * mark) / _rate));
+    _spaceStep = std::polar(1.0f, (float) ((-2 * M_PI * space) / _rate));
+    _markPhase = 1;
+    _spacePhase = 1;
+    _markSum = 0;
+    _spaceSum = 0;
+
+    // Whole samples per chip, and the resulting (fractional) chips per bit
+    _chipLength = std::max(1, (int) round((_rate * 100.0) / (_baudrate * RTTY_CHIPS_PER_BIT)));
+    _chipSamples = 0;
+    _bitLength = (_rate * 100.0f) / (_baudrate * _chipLength);
+    _markChips.assign(std::max(1, (int) round(_bitLength)), 0);
+    _spaceChips.assign(_markChips.size(), 0);
+    _chip = 0;
+
+    _markLevel = 0;
+    _markFloor = 0;
+    _spaceLevel = 0;
+    _spaceFloor = 0;
+
+    _bit = RTTY_WAIT_MARK;
+    _next = 0;
+    _code = 0;
+    _quality = 0;
+    _isFigures = false;
+
+    HLog("Decoding RTTY at samplerate %d, shift %d, %d.%02d baud, %d samples per chip and %f chips per bit",
+         _rate, _shift, _baudrate / 100, _baudrate % 100, _chipLength, _bitLength);
+}
+
+void BoomaRttyDecoder::Decode(int16_t* src, int blocksize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for( int i = 0; i < blocksize; i++ ) {
+        _markSum += _markPhase * (float) src[i];
+        _spaceSum += _spacePhase * (float) src[i];
+        _markPhase *= _markStep;
+        _spacePhase *= _spaceStep;
+        if( ++_chipSamples == _chipLength ) {
+            Chip();
+        }
+    }
+}
+
+void BoomaRttyDecoder::Chip() {
+
+    // Keep the oscillators at unit amplitude
+    _markPhase /= std::abs(_markPhase);
+    _spacePhase /= std::abs(_spacePhase);
+
+    // Matched filter, the sum of the chips in the last bit
+    _markChips[_chip] = _markSum;
+    _spaceChips[_chip] = _spaceSum;
+    _chip = _chip + 1 < (int) _markChips.size() ? _chip + 1 : 0;
+    _markSum = 0;
+    _spaceSum = 0;
+    _chipSamples = 0;
+    std::complex<float> mark = 0;
+    std::complex<float> space = 0;
+    for( size_t i = 0; i < _markChips.size(); i++ ) {
+        mark += _markChips[i];
+        space += _spaceChips[i];
+    }
+
+    Frame(Slice(std::abs(mark), std::abs(space)));
+}
+
+void BoomaRttyDecoder::Track(float value, float* level, float* floor) {
+
+    // Levels follow the tone up fast and decays over several bits, the floor does the
+    // opposite. Without a previous value, both starts at the first input
+    float decay = _bitLength * RTTY_ATC_BITS;
+    if( *level == 0 && *floor == 0 ) {
+        *level = value;
+        *floor = value;
+    }
+    *level += (value - *level) / (value > *level ? 4 : decay);
+    *floor += (value - *floor) / (value < *floor ? 4 : decay);
+}
+
+float BoomaRttyDecoder::Slice(float mark, float space) {
+    Track(mark, &_markLevel, &_markFloor);
+    Track(space, &_spaceLevel, &_spaceFloor);
+
+    // Compare the tones above their noise floors, and correct the threshold for the difference in
+    // level. A faded tone still decides against the floor of the other tone. Positive is mark
+    float m = std::min(std::max(mark, _markFloor), _markLevel) - _markFloor;
+    float s = std::min(std::max(space, _spaceFloor), _spaceLevel) - _spaceFloor;
+    float decision = m - s - (((_markLevel - _markFloor) - (_spaceLevel - _spaceFloor)) / 2);
+    return _isReversed ? -decision : decision;
+}
+
+void BoomaRttyDecoder::Frame(float decision) {
+    bool isMark = decision > 0;
+
+    // Wait for the line to idle at mark, then for the edge of the start bit. The matched
+    // filter crosses zero when half of the start bit is inside the filter, so the bits
+    // are sampled, fully inside the filter, a half, one and a half, ... bits later
+    if( _bit == RTTY_WAIT_MARK ) {
+        _bit = isMark ? RTTY_WAIT_START : RTTY_WAIT_MARK;
+        return;
+    }
+    if( _bit == RTTY_WAIT_START ) {
+        if( !isMark ) {
+            _bit = 0;
+            _next = _bitLength / 2;
+            _code = 0;
+            _quality = 0;
+        }
+        return;
+    }
+    if( --_next > 0 ) {
+        return;
+    }
+    _next += _bitLength;
+
+    // The soft decision relative to the span of the tones is close to 1 for a clear signal,
+    // and much lower for noise
+    float span = ((_markLevel - _markFloor) + (_spaceLevel - _spaceFloor)) / 2;
+    _quality += span > 0 ? std::abs(decision) / span : 0;
+
+    // Start bit, data bits (least significant first) and the stop bit. A start bit that is
+    // gone was noise. The character is dropped on a missing stop bit (a framing error) or
+    // when the bits, on average, were not clear enough (squelch)
+    if( _bit == 0 ) {
+        _bit = isMark ? RTTY_WAIT_START : 1;
+    } else if( _bit <= 5 ) {
+        _code |= (isMark ? 1 : 0) << (_bit - 1);
+        _bit++;
+    } else {
+        if( isMark && (_quality * 100) / 7 > RTTY_SQUELCH ) {
+            Character(_code);
+        }
+        _bit = isMark ? RTTY_WAIT_START : RTTY_WAIT_MARK;
+    }
+}
+
+void BoomaRttyDecoder::Character(int code) {
+
+    // ITA2 with the US figures. Zero is a non printing character
+    static const char letters[32] = {
+        0, 'E', '\n', 'A', ' ', 'S', 'I', 'U', '\r', 'D', 'R', 'J', 'N', 'F', 'C', 'K',
+        'T', 'Z', 'L', 'W', 'H', 'Y', 'P', 'Q', 'O', 'B', 'G', 0, 'M', 'X', 'V', 0
+    };
+    static const char figures[32] = {
+        0, '3', '\n', '-', ' ', 0, '8', '7', '\r', '$', '4', '\'', ',', '!', ':', '(',
+        '5', '"', ')', '2', '#', '6', '0', '1', '9', '?', '&', 0, '.', '/', ';', 0
+    };
+
+    // Shifts, a space also returns to letters (unshift on space)
+    if( code == 0x1F ) {
+        _isFigures = false;
+        return;
+    }
+    if( code == 0x1B ) {
+        _isFigures = true;
+        return;
+    }
+    char c = _isFigures ? figures[code] : letters[code];
+    if( c == ' ' ) {
+        _isFigures = false;
+    }
+
+    // Lines are shown as spaces
+    if( c == 0 || c == '\r' ) {
+        return;
+    }
+    if( _callback ) {
+        _callback(std::string(1, c == '\n' ? ' ' : c));
+    }
+}
+
+void BoomaRttyDecoder::SetReceiverOption(std::string name, int value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if( name == "Shift" ) {
+        _shift = value;
+    } else if( name == "Baudrate" ) {
+        _baudrate = value;
+    } else if( name == "Reverse" ) {
+        _isReversed = value == 1;
+    } else {
+        return;
+    }
+    Configure();
+}
+
+int BoomaRttyDecoder::GetWpm() {
+    return (_baudrate * 8) / (100 * 6);
+}
@@ -0,0 +1,236 @@
+#include "boomarttyreceiver.h"
+
+BoomaRttyReceiver::BoomaRttyReceiver(ConfigOptions* opts, int initialFrequency):
+        BoomaReceiver(opts, initialFrequency),
+        _humfilter(nullptr),
+        _iq2IConverter(nullptr),
+        _iqMultiplier(nullptr),
+        _preselect(nullptr),
+        _passbandGain(nullptr),
+        _ifMixer(nullptr),
+        _ifFilter(nullptr),
+        _toneMixer(nullptr),
+        _postSelect(nullptr) {
+
+        std::vector<OptionValue> shiftValues {
+            OptionValue {"170", "Shift 170Hz (amateur)", 170},
+            OptionValue {"200", "Shift 200Hz", 200},
+            OptionValue {"425", "Shift 425Hz", 425},
+            OptionValue {"450", "Shift 450Hz (weather)", 450},
+            OptionValue {"850", "Shift 850Hz", 850}};
+        std::vector<OptionValue> baudrateValues {
+            OptionValue {"45.45", "45.45 baud (60 wpm)", 4545},
+            OptionValue {"50", "50 baud (66 wpm)", 5000},
+            OptionValue {"75", "75 baud (100 wpm)", 7500},
+            OptionValue {"100", "100 baud (133 wpm)", 10000}};
+        std::vector<OptionValue> reverseValues {
+            OptionValue {"Normal", "Mark above space", 0},
+            OptionValue {"Reverse", "Mark below space", 1}};
+        std::vector<OptionValue> passbandGainValues {
+                OptionValue {"0", "Passband gain factor 1", 1},
+                OptionValue {"1", "Passband gain factor 10", 10},
+                OptionValue {"2", "Passband gain factor 20", 20},
+                OptionValue {"3", "Passband gain factor 30", 30},
+                OptionValue {"4", "Passband gain factor 40", 40},
+                OptionValue {"5", "Passband gain factor 50", 50},
+                OptionValue {"6", "Passband gain factor 60", 60}};
+        std::vector<OptionValue> iqPassbandGainValues {
+                OptionValue {"0", "Passband gain factor 0.5", 0},
+                OptionValue {"1", "Passband gain factor 1", 1},
+                OptionValue {"2", "Passband gain factor 2", 2},
+                OptionValue {"3", "Passband gain factor 3", 3},
+                OptionValue {"4", "Passband gain factor 4", 4},
+                OptionValue {"5", "Passband gain factor 5", 5},
+                OptionValue {"6", "Passband gain factor 6", 6},
+                OptionValue {"7", "Passband gain factor 7", 7},
+                OptionValue {"8", "Passband gain factor 8", 8},
+                OptionValue {"9", "Passband gain factor 9", 9},
+                OptionValue {"10", "Passband gain factor 10", 10},};
+
+        Option shiftOption {
+            "Shift",
+            "Distance from mark down to space",
+            shiftValues,
+            170
+        };
+        Option baudrateOption {
+            "Baudrate",
+            "Baudrate",
+            baudrateValues,
+            4545
+        };
+        Option reverseOption {
+            "Reverse",
+            "Swap mark and space",
+            reverseValues,
+            0
+        };
+        Option passbandGainOption {
+                "PassbandGain",
+                "Gain factor after preselect",
+                passbandGainValues,
+                20
+        };
+        Option iqPassbandGainOption {
+                "IQPassbandGain",
+                "Gain factor after iq-to-real conversion",
+                iqPassbandGainValues,
+                4
+        };
+
+        // Register options
+        RegisterOption(shiftOption);
+        RegisterOption(baudrateOption);
+        RegisterOption(reverseOption);
+        RegisterOption(passbandGainOption);
+        RegisterOption(iqPassbandGainOption);
+    }
+
+HWriterConsumer<int16_t>* BoomaRttyReceiver::PreProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
+    HLog("Creating RTTY receiver preprocessing chain");
+
+    // Realvalued input, most likely from an audio device
+    if(opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ) {
+
+        // Add a combfilter to kill (more) 50 hz harmonics
+        HLog("- Humfilter");
+        _humfilter = new HHumFilter<int16_t>("rtty_receiver_pre_process_hum", previous, opts->GetOutputSampleRate(), 50, 1000, BLOCKSIZE);
+
+        // Bandpass filter, centered between mark and space, before mixing
+        HLog("- Preselect");
+        _preselect = new HBiQuadFilter<HBandpassBiQuad<int16_t>, int16_t>("rtty_receiver_pre_process_preselect", _humfilter->Consumer(), GetFrequency() - (GetOption("Shift") / 2), opts->GetOutputSampleRate(), 1.0f, 1, BLOCKSIZE);
+
+        // Gain after preselect filtering
+        _passbandGain = new HGain<int16_t>("rtty_receiver_pre_process_gain", _preselect->Consumer(), GetOption("PassbandGain"), BLOCKSIZE);
+
+        // Mix down so that mark is at the IF frequency
+        HLog("- IF Mixer");
+        _ifMixer = new HMultiplier<int16_t>("rtty_receiver_pre_process_if_mixer", _passbandGain->Consumer(), opts->GetOutputSampleRate(), GetFrequency() - GetIfFrequency(opts), 10, BLOCKSIZE);
+
+        // Return signal at IF
+        return _ifMixer->Consumer();
+    }
+
+    // IQ input is centered with the tuned frequency (mark) at 0, move it up to the IF
+    // and convert to realvalued samples, as in the CW receiver
+    if( opts->GetInputSourceDataType() == IQ_INPUT_SOURCE_DATA_TYPE ||
+            opts->GetInputSourceDataType() == I_INPUT_SOURCE_DATA_TYPE ||
+            opts->GetInputSourceDataType() == Q_INPUT_SOURCE_DATA_TYPE) {
+
+        // Move the center frequency up to the IF frequency
+        _iqMultiplier = new HIqMultiplier<int16_t>("rtty_receiver_iq_multiplier", previous, opts->GetOutputSampleRate(), GetIfFrequency(opts), 10, BLOCKSIZE);
+
+        // Get the I branch ==> convert to realvalued samples
+        _iq2IConverter = new HIq2IConverter<int16_t>("rtty_receiver_iq_2_i_converter", _iqMultiplier->Consumer(), BLOCKSIZE);
+
+        // Gain after converting to realvalued samples
+        _passbandGain = new HGain<int16_t>("rtty_receiver_iq_to_real_value_converter", _iq2IConverter->Consumer(), GetOption("IQPassbandGain") > 0 ? GetOption("IQPassbandGain") : 0.5, BLOCKSIZE);
+
+        // Return signal at IF
+        return _passbandGain->Consumer();
+    }
+
+    // Unhandled data type - that should not happen!
+    throw new BoomaReceiverException("Unhandled data type");
+}
+
+HWriterConsumer<int16_t>* BoomaRttyReceiver::Receive(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
+    HLog("Creating RTTY receiver receiving chain");
+
+    // The widest shift must fit between the tone center and the IF
+    if( opts->GetOutputSampleRate() < RTTY_MIN_RATE ) {
+        HError("Output samplerate %d is too low for the RTTY receiver, must be at least %d", opts->GetOutputSampleRate(), RTTY_MIN_RATE);
+        throw new BoomaReceiverException("Output samplerate too low for the RTTY receiver");
+    }
+
+    // IF filter covering mark and space
+    HLog("- IF filter");
+    _ifFilter = new HCascadedBiQuadFilter<int16_t>("rtty_receiver_receive_biquad", previous, GetIfCoefficients(opts), BoomaBiQuadDesigner::Coefficients, BLOCKSIZE);
+
+    // Mix down to the output tones
+    HLog("- Tone mixer");
+    _toneMixer = new HMultiplier<int16_t>("rtty_receiver_receive_tone_mixer", _ifFilter->Consumer(), opts->GetOutputSampleRate(), GetToneMixerFrequency(opts), 10, BLOCKSIZE);
+
+    // Remove the mixing products above the tones
+    HLog("- Output filter");
+    _postSelect = new HCascadedBiQuadFilter<int16_t>("rtty_receiver_receive_output_filter", _toneMixer->Consumer(), GetOutputCoefficients(opts), BoomaBiQuadDesigner::Coefficients, BLOCKSIZE);
+
+    // End of receiver
+    return _postSelect->Consumer();
+}
+
+HWriterConsumer<int16_t>* BoomaRttyReceiver::PostProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous) {
+    HLog("Creating RTTY receiver postprocessing chain");
+
+    return previous;
+}
+
+BoomaRttyReceiver::~BoomaRttyReceiver() {
+    SAFE_DELETE(_humfilter);
+    SAFE_DELETE(_preselect);
+    SAFE_DELETE(_passbandGain);
+    SAFE_DELETE(_ifMixer);
+    SAFE_DELETE(_iqMultiplier);
+    SAFE_DELETE(_iq2IConverter);
+    SAFE_DELETE(_ifFilter);
+    SAFE_DELETE(_toneMixer);
+    SAFE_DELETE(_postSelect);
+}
+
+bool BoomaRttyReceiver::SetInternalFrequency(ConfigOptions* opts, int frequency) {
+
+    // This receiver only operates from IF - samplerate/2. Or exactly on o (zero, IQ devices)
+    if( !IsFrequencySupported(opts, frequency) ) {
+        HError("Unsupported frequency %ld, must be greater than  %d and less than %d or zero", frequency, GetIfFrequency(opts), opts->GetOutputSampleRate() / 2);
+        return false;
+    }
+
+    // Set new multiplier frequency and adjust the preselect bandpass filter
+    if( _preselect != nullptr ) {
+        _preselect->SetCoefficients(frequency - (GetOption("Shift") / 2), opts->GetOutputSampleRate(), 1.0f, 1, BLOCKSIZE);
+    }
+    if( _ifMixer != nullptr ) {
+        _ifMixer->SetFrequency(frequency - GetIfFrequency(opts));
+    }
+
+    // Ready
+    return true;
+}
+
+void BoomaRttyReceiver::OptionChanged(ConfigOptions* opts, std::string name, int value) {
+    HLog("Option %s has changed to value %d", name.c_str(), value);
+
+    // Reconfigure receiver, the filters and the tone mixer follows the shift and baudrate
+    if( _preselect != nullptr ) {
+        _preselect->SetCoefficients(GetFrequency() - (GetOption("Shift") / 2), opts->GetOutputSampleRate(), 1.0f, 1, BLOCKSIZE);
+    }
+    _ifFilter->SetCoefficients(GetIfCoefficients(opts), BoomaBiQuadDesigner::Coefficients);
+    _toneMixer->SetFrequency(GetToneMixerFrequency(opts));
+    _postSelect->SetCoefficients(GetOutputCoefficients(opts), BoomaBiQuadDesigner::Coefficients);
+
+    if( _preselect != nullptr ) {
+        _passbandGain->SetGain(GetOption("PassbandGain"));
+    } else if( _iq2IConverter != nullptr ) {
+        if( GetOption("IQPassbandGain") > 0 ) {
+            _passbandGain->SetGain(GetOption("IQPassbandGain"));
+        } else {
+            _passbandGain->SetGain(0.5);
+        }
+    }
+
+    // Settings applied
+    HLog("Receiver chain reconfigured");
+}
+
+std::string BoomaRttyReceiver::GetOptionInfoString() {
+    int baudrate = GetOption("Baudrate");
+    std::string info = "shift:" + std::to_string(GetOption("Shift")) + "Hz " + std::to_string(baudrate / 100);
+    if( baudrate % 100 != 0 ) {
+        info += "." + std::to_string(baudrate % 100);
+    }
+    info += "bd";
+    if( GetOption("Reverse") == 1 ) {
+        info += " rev";
+    }
+    return info;
+}
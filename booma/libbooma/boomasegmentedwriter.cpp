@@ -0,0 +1,152 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "boomasegmentedwriter.h"
+
+BoomaSegmentedWriter::BoomaSegmentedWriter(std::string id, std::string basename, bool isWav, int samplerate, int channels, long segmentSeconds, off_t segmentBytes, off_t totalBytes, HWriterConsumer<int16_t>* previous, bool isBlocking, int buffers):
+        BoomaAsyncWriter(id, previous, buffers, isBlocking),
+        _basename(basename),
+        _isWav(isWav),
+        _samplerate(samplerate),
+        _channels(channels),
+        _segmentSamples(0),
+        _totalBytes(totalBytes),
+        _fd(-1),
+        _segmentWritten(0),
+        _segmentDropped(0),
+        _synced(0),
+        _sequence(0),
+        _segmentsSize(0),
+        _written(0) {
+
+    // Use the smallest of the two segment limits, both counted in int16 values
+    long bySize = segmentBytes > 0 ? (segmentBytes - (isWav ? WavHeaderSize : 0)) / sizeof(int16_t) : 0;
+    long byTime = segmentSeconds * samplerate * channels;
+    _segmentSamples = bySize > 0 && (byTime <= 0 || bySize < byTime) ? bySize : byTime;
+
+    HLog("Creating segmented writer for %s with %ld samples per segment and %ld bytes in total", basename.c_str(), _segmentSamples, (long) totalBytes);
+}
+
+BoomaSegmentedWriter::~BoomaSegmentedWriter() {
+    Stop();
+}
+
+void BoomaSegmentedWriter::WriteBuffer(int16_t* samples, size_t length) {
+    size_t done = 0;
+    while( done < length ) {
+        if( _fd == -1 && !OpenSegment() ) {
+            _written += length - done;
+            return;
+        }
+
+        // Write up to the end of the current segment
+        size_t count = length - done;
+        if( _segmentSamples > 0 && (long) count > _segmentSamples - _segmentWritten ) {
+            count = _segmentSamples - _segmentWritten;
+        }
+        if( !WriteFully(_fd, &samples[done], count * sizeof(int16_t)) ) {
+            HError("Failed to write to segment %s", _segment.Filename.c_str());
+        }
+        _segmentWritten += count;
+        _segment.Size += count * sizeof(int16_t);
+        _written += count;
+        done += count;
+        StartWriteback(_fd, &_synced, _segment.Size);
+
+        if( _segmentSamples > 0 && _segmentWritten >= _segmentSamples ) {
+            CloseSegment();
+        }
+    }
+}
+
+void BoomaSegmentedWriter::Close() {
+    CloseSegment();
+}
+
+bool BoomaSegmentedWriter::OpenSegment() {
+
+    // Name the segment by the time of its first sample
+    time_t first = GetStarted() + (_written / ((unsigned long) _samplerate * _channels));
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", localtime(&first));
+    _segment.Filename = _basename + "_" + timestamp + "_" + std::to_string(_sequence++) + (_isWav ? ".wav" : ".pcm");
+    _segment.Size = 0;
+    _segmentWritten = 0;
+    _synced = 0;
+
+    _fd = open(_segment.Filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if( _fd == -1 ) {
+        HError("Unable to create segment %s", _segment.Filename.c_str());
+        return false;
+    }
+    HLog("Writing segment %s", _segment.Filename.c_str());
+    SetSegment(_segment.Filename);
+    _segmentDropped = GetDroppedSamples();
+
+    // Reserve room for the complete segment, so that the file is not fragmented
+    if( _segmentSamples > 0 ) {
+        posix_fallocate(_fd, 0, (_isWav ? WavHeaderSize : 0) + (_segmentSamples * sizeof(int16_t)));
+    }
+
+    // The wav header is rewritten with the final size when the segment is closed
+    if( _isWav ) {
+        uint8_t header[WavHeaderSize];
+        CreateWavHeader(header, _samplerate, 0);
+        if( write(_fd, header, WavHeaderSize) != WavHeaderSize ) {
+            HError("Failed to write wav header to segment %s", _segment.Filename.c_str());
+        }
+        _segment.Size = WavHeaderSize;
+    }
+
+    // Make room for the new segment
+    DeleteSegments();
+    return true;
+}
+
+void BoomaSegmentedWriter::CloseSegment() {
+    if( _fd == -1 ) {
+        return;
+    }
+
+    // Release unused preallocated space and complete the wav header
+    if( ftruncate(_fd, _segment.Size) != 0 ) {
+        HError("Unable to truncate segment %s", _segment.Filename.c_str());
+    }
+    if( _isWav ) {
+        uint8_t header[WavHeaderSize];
+        CreateWavHeader(header, _samplerate, _segmentWritten);
+        if( pwrite(_fd, header, WavHeaderSize, 0) != WavHeaderSize ) {
+            HError("Failed to update wav header in segment %s", _segment.Filename.c_str());
+        }
+    }
+    close(_fd);
+    _fd = -1;
+    unsigned long dropped = GetDroppedSamples() - _segmentDropped;
+    if( dropped > 0 ) {
+        HError("Closed segment %s with %ld bytes, %lu samples were dropped while it was written", _segment.Filename.c_str(), (long) _segment.Size, dropped);
+    } else {
+        HLog("Closed segment %s with %ld bytes", _segment.Filename.c_str(), (long) _segment.Size);
+    }
+    SetSegment("");
+
+    _segments.push_back(_segment);
+    _segmentsSize += _segment.Size;
+    DeleteSegments();
+}
+
+void BoomaSegmentedWriter::DeleteSegments() {
+    if( _totalBytes <= 0 ) {
+        return;
+    }
+
+    // Count the current segment with its full size, since it has been preallocated
+    off_t current = _fd == -1 ? 0 : (_isWav ? WavHeaderSize : 0) + (_segmentSamples * sizeof(int16_t));
+    while( !_segments.empty() && _segmentsSize + current > _totalBytes ) {
+        HLog("Deleting segment %s", _segments.front().Filename.c_str());
+        if( unlink(_segments.front().Filename.c_str()) != 0 ) {
+            HError("Unable to delete segment %s", _segments.front().Filename.c_str());
+        }
+        _segmentsSize -= _segments.front().Size;
+        _segments.pop_front();
+    }
+}
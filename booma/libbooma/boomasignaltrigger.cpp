@@ -0,0 +1,23 @@
+#include "boomasignaltrigger.h"
+
+BoomaSignalTrigger::Event BoomaSignalTrigger::Update(int level, double seconds) {
+
+    // Time spent continuously above or below the threshold
+    if( level >= _threshold ) {
+        _above += seconds;
+        _below = 0;
+    } else {
+        _below += seconds;
+        _above = 0;
+    }
+
+    if( !_isTriggered && _above >= _hold ) {
+        _isTriggered = true;
+        return START;
+    }
+    if( _isTriggered && _below >= _release ) {
+        _isTriggered = false;
+        return STOP;
+    }
+    return NONE;
+}
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cmath>
+#include <regex>
+
+#include "boomaskimmer.h"
+#include "booma.h"
+
+BoomaSkimmer::BoomaSkimmer(std::string id, HWriterConsumer<int16_t>* previous, int samplerate, bool isIq):
+        HWriter<int16_t>(id),
+        _rate(samplerate),
+        _isIq(isIq),
+        _size(samplerate / SKIMMER_BIN_WIDTH),
+        _bins(isIq ? _size : _size / 2),
+        _hop((samplerate * CW_DECODER_TICK_MS) / 1000),
+        _fft(nullptr),
+        _position(0),
+        _next(0),
+        _frames(0) {
+
+    HLog("Skimming %s input at samplerate %d with %d bins of %d Hz", isIq ? "IQ" : "realvalued", samplerate, _bins, samplerate / _size);
+    _fft = new BoomaFft(_size);
+    _window.resize(_size);
+    for( int i = 0; i < _size; i++ ) {
+        _window[i] = 0.5f - (0.5f * cos((2 * M_PI * i) / _size));
+    }
+    _history.assign(_size, 0);
+    _frame.resize(_size);
+    _spectrum.resize(_size);
+    _power.assign(_bins, 0);
+    _peak.assign(_bins, 0);
+    _owner.assign(_bins, -1);
+
+    // All decoders are created up front, each reporting to its own slot
+    _slots.resize(SKIMMER_CHANNELS);
+    for( int i = SKIMMER_CHANNELS - 1; i >= 0; i-- ) {
+        _slots[i].Decoder = new BoomaCwDecoder(id + "_decoder_" + std::to_string(i), samplerate, [this, i](std::string text) {
+            AddText(i, text);
+        });
+        _free.push_back(i);
+    }
+
+    previous->SetWriter(this);
+}
+
+BoomaSkimmer::~BoomaSkimmer() {
+    for( std::vector<Slot>::iterator it = _slots.begin(); it != _slots.end(); it++ ) {
+        SAFE_DELETE((*it).Decoder);
+    }
+    SAFE_DELETE(_fft);
+}
+
+int BoomaSkimmer::Write(int16_t* src, size_t blocksize) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if( _isIq ) {
+        for( size_t i = 0; i < blocksize; i += 2 ) {
+            Add(std::complex<float>(src[i], src[i + 1]));
+        }
+    } else {
+        for( size_t i = 0; i < blocksize; i++ ) {
+            Add(std::complex<float>(src[i], 0));
+        }
+    }
+    return blocksize;
+}
+
+void BoomaSkimmer::Add(std::complex<float> sample) {
+    _history[_position] = sample;
+    _position = _position + 1 < _size ? _position + 1 : 0;
+    if( ++_next == _hop ) {
+        _next = 0;
+        Analyze();
+    }
+}
+
+void BoomaSkimmer::Analyze() {
+
+    // Windowed frame, oldest sample first
+    int first = _size - _position;
+    for( int i = 0; i < first; i++ ) {
+        _frame[i] = _history[_position + i] * _window[i];
+    }
+    for( int i = first; i < _size; i++ ) {
+        _frame[i] = _history[i - first] * _window[i];
+    }
+    _fft->Forward(_frame.data(), _spectrum.data());
+
+    // Bin powers, IQ bins ordered from the lowest (negative) frequency
+    int shift = _isIq ? _size / 2 : 0;
+    for( int bin = 0; bin < _bins; bin++ ) {
+        _power[bin] = std::norm(_spectrum[(bin + shift) % _size]);
+        _peak[bin] = std::max(_peak[bin], _power[bin]);
+    }
+
+    // Give each decoder the level of its bin, or a neighbour if the signal is between two bins
+    for( std::vector<Slot>::iterator it = _slots.begin(); it != _slots.end(); it++ ) {
+        if( (*it).IsActive ) {
+            int bin = (*it).Bin;
+            (*it).Decoder->Tick(sqrt(std::max(_power[bin], std::max(_power[bin - 1], _power[bin + 1]))));
+        }
+    }
+
+    if( ++_frames == SKIMMER_DETECT_TICKS ) {
+        Detect();
+        _frames = 0;
+        std::fill(_peak.begin(), _peak.end(), 0);
+    }
+}
+
+void BoomaSkimmer::Detect() {
+
+    // Noise floor, assuming that most bins has no signal
+    _sorted = _peak;
+    std::nth_element(_sorted.begin(), _sorted.begin() + (_bins / 2), _sorted.end());
+    float noise = _sorted[_bins / 2];
+
+    // Follow drifting signals (only while keyed, gaps would make the decoder wander off with
+    // the noise) and release idle decoders. A signal that has drifted onto the bins of another
+    // decoder is released
+    std::fill(_owner.begin(), _owner.end(), -1);
+    for( int i = 0; i < SKIMMER_CHANNELS; i++ ) {
+        Slot* slot = &_slots[i];
+        if( !slot->IsActive ) {
+            continue;
+        }
+        if( slot->Decoder->GetIdleMilliseconds() > SKIMMER_IDLE_SECONDS * 1000 ) {
+            Release(i);
+            continue;
+        }
+        int strongest = _peak[slot->Bin - 1] > _peak[slot->Bin + 1] ? slot->Bin - 1 : slot->Bin + 1;
+        if( strongest >= 2 && strongest < _bins - 2 && _peak[strongest] > _peak[slot->Bin] && _peak[strongest] > noise * SKIMMER_THRESHOLD ) {
+            slot->Bin = strongest;
+        }
+        if( _owner[slot->Bin] != -1 ) {
+            Release(i);
+            continue;
+        }
+        for( int bin = slot->Bin - 2; bin <= slot->Bin + 2; bin++ ) {
+            _owner[bin] = i;
+        }
+    }
+
+    // New signals, strongest first
+    std::vector<int> candidates;
+    for( int bin = 2; bin < _bins - 2; bin++ ) {
+        if( _peak[bin] > noise * SKIMMER_THRESHOLD && _peak[bin] >= _peak[bin - 1] && _peak[bin] > _peak[bin + 1] && _owner[bin] == -1 ) {
+            candidates.push_back(bin);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](int a, int b) { return _peak[a] > _peak[b]; });
+    for( std::vector<int>::iterator it = candidates.begin(); it != candidates.end() && !_free.empty(); it++ ) {
+        if( _owner[*it] != -1 ) {
+            continue;
+        }
+        int i = _free.back();
+        _free.pop_back();
+        _slots[i].Bin = *it;
+        _slots[i].IsActive = true;
+
+        // The peak is the largest of many frames, the noise in a single frame is lower
+        _slots[i].Decoder->Reset(sqrt(noise) / 2);
+        for( int bin = *it - 2; bin <= *it + 2; bin++ ) {
+            _owner[bin] = i;
+        }
+        HLog("Skimmer found a signal at offset %d Hz", GetOffset(*it));
+    }
+}
+
+void BoomaSkimmer::Release(int slot) {
+    _slots[slot].IsActive = false;
+    _slots[slot].Text = "";
+    _slots[slot].Word = "";
+    _slots[slot].Callsign = "";
+    _free.push_back(slot);
+}
+
+void BoomaSkimmer::AddText(int slot, std::string text) {
+    Slot* s = &_slots[slot];
+    s->Text += text;
+    if( s->Text.size() > SKIMMER_TEXT_LENGTH ) {
+        s->Text.erase(0, s->Text.size() - SKIMMER_TEXT_LENGTH);
+    }
+
+    // Keep the last word that looks like a callsign
+    if( text != " " ) {
+        s->Word += text;
+        return;
+    }
+    if( IsCallsign(s->Word) ) {
+        s->Callsign = s->Word;
+    }
+    s->Word = "";
+}
+
+int BoomaSkimmer::GetOffset(int bin) {
+    return ((bin - (_isIq ? _size / 2 : 0)) * _rate) / _size;
+}
+
+bool BoomaSkimmer::IsCallsign(std::string word) {
+
+    // One or two characters of prefix (not two digits), a digit and a suffix of letters,
+    // optionally with a portable indicator
+    static const std::regex callsign("^([A-Z0-9]+/)?([A-Z]{1,2}|[0-9][A-Z]|[A-Z][0-9])[0-9][A-Z]{1,4}(/[A-Z0-9]+)?$");
+    return std::regex_match(word, callsign);
+}
+
+void BoomaSkimmer::Reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for( int i = 0; i < SKIMMER_CHANNELS; i++ ) {
+        if( _slots[i].IsActive ) {
+            Release(i);
+        }
+    }
+    std::fill(_peak.begin(), _peak.end(), 0);
+    _frames = 0;
+}
+
+std::vector<BoomaSkimmerSpot> BoomaSkimmer::GetSpots() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<BoomaSkimmerSpot> spots;
+    for( std::vector<Slot>::iterator it = _slots.begin(); it != _slots.end(); it++ ) {
+        if( (*it).IsActive && !(*it).Text.empty() ) {
+            BoomaSkimmerSpot spot;
+            spot.Offset = GetOffset((*it).Bin);
+            spot.Frequency = 0;
+            spot.Callsign = (*it).Callsign;
+            spot.Text = (*it).Text;
+            spot.Snr = (*it).Decoder->GetSnr();
+            spot.Wpm = (*it).Decoder->GetWpm();
+            spots.push_back(spot);
+        }
+    }
+    return spots;
+}
@@ -0,0 +1,202 @@
+#include <cmath>
+
+#include "boomatiming.h"
+
+// Time spent in nested timed stages, for each active timed stage on this thread
+static thread_local std::vector<double> nestedNanoseconds;
+
+BoomaTimingHistogram::BoomaTimingHistogram():
+        _buckets(Buckets) {
+    Reset();
+}
+
+int BoomaTimingHistogram::Index(double nanoseconds) {
+    unsigned long long value = nanoseconds < 1 ? 0 : (unsigned long long) nanoseconds;
+    if( value < SubBuckets ) {
+        return value;
+    }
+
+    // Power of two plus the 4 bits following the most significant bit
+    int exponent = 63 - __builtin_clzll(value);
+    int index = ((exponent - 3) * SubBuckets) + ((value >> (exponent - 4)) & (SubBuckets - 1));
+    return index < Buckets ? index : Buckets - 1;
+}
+
+double BoomaTimingHistogram::Value(int index) {
+    if( index < SubBuckets ) {
+        return index;
+    }
+    int exponent = (index / SubBuckets) + 3;
+    return (double) (SubBuckets + (index % SubBuckets)) * pow(2, exponent - 4);
+}
+
+void BoomaTimingHistogram::Add(double nanoseconds) {
+
+    // Only the thread running the stage adds, so load and store needs no read-modify-write
+    std::atomic<unsigned long>* bucket = &_buckets[Index(nanoseconds)];
+    bucket->store(bucket->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    unsigned long count = _count.load(std::memory_order_relaxed);
+    if( count == 0 || nanoseconds < _min.load(std::memory_order_relaxed) ) {
+        _min.store(nanoseconds, std::memory_order_relaxed);
+    }
+    if( nanoseconds > _max.load(std::memory_order_relaxed) ) {
+        _max.store(nanoseconds, std::memory_order_relaxed);
+    }
+    _count.store(count + 1, std::memory_order_relaxed);
+}
+
+double BoomaTimingHistogram::GetPercentile(double percentile) {
+    unsigned long count = _count.load(std::memory_order_relaxed);
+    if( count == 0 ) {
+        return 0;
+    }
+
+    // Lower bound of the bucket holding the percentile, clamped to the exact min and max
+    double min = _min.load(std::memory_order_relaxed);
+    double max = _max.load(std::memory_order_relaxed);
+    unsigned long rank = (unsigned long) ceil((percentile / 100) * count);
+    unsigned long seen = 0;
+    for( int i = 0; i < Buckets; i++ ) {
+        unsigned long bucket = _buckets[i].load(std::memory_order_relaxed);
+        seen += bucket;
+        if( seen >= rank && bucket > 0 ) {
+            double value = Value(i);
+            return value < min ? min : (value > max ? max : value);
+        }
+    }
+    return max;
+}
+
+void BoomaTimingHistogram::Reset() {
+    for( std::vector<std::atomic<unsigned long>>::iterator it = _buckets.begin(); it != _buckets.end(); it++ ) {
+        (*it).store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _min.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+BoomaTimingCounter::BoomaTimingCounter(std::string name):
+        _name(name),
+        _samples(0),
+        _nanoseconds(0) {
+}
+
+void BoomaTimingCounter::Begin() {
+    nestedNanoseconds.push_back(0);
+    _start = std::chrono::steady_clock::now();
+}
+
+void BoomaTimingCounter::End(size_t samples) {
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - _start).count();
+
+    // Remove time spent in nested stages and add our total time to the enclosing stage
+    double nested = nestedNanoseconds.back();
+    nestedNanoseconds.pop_back();
+    if( !nestedNanoseconds.empty() ) {
+        nestedNanoseconds.back() += elapsed;
+    }
+
+    _histogram.Add(elapsed - nested);
+    _nanoseconds.store(_nanoseconds.load(std::memory_order_relaxed) + elapsed - nested, std::memory_order_relaxed);
+    _samples.store(_samples.load(std::memory_order_relaxed) + samples, std::memory_order_relaxed);
+}
+
+BoomaStageStatistics BoomaTimingCounter::GetStatistics() {
+    BoomaStageStatistics statistics;
+    statistics.Name = _name;
+    statistics.Calls = _histogram.GetCount();
+    statistics.Samples = _samples.load(std::memory_order_relaxed);
+    statistics.Nanoseconds = _nanoseconds.load(std::memory_order_relaxed);
+    statistics.NanosecondsPerSample = statistics.Samples > 0 ? statistics.Nanoseconds / statistics.Samples : 0;
+    statistics.Min = _histogram.GetMin();
+    statistics.P50 = _histogram.GetPercentile(50);
+    statistics.P99 = _histogram.GetPercentile(99);
+    statistics.Max = _histogram.GetMax();
+    return statistics;
+}
+
+void BoomaTimingCounter::Reset() {
+    _histogram.Reset();
+    _samples.store(0, std::memory_order_relaxed);
+    _nanoseconds.store(0, std::memory_order_relaxed);
+}
+
+BoomaTimingWriter::BoomaTimingWriter(std::string id, HWriterConsumer<int16_t>* previous):
+        HWriter<int16_t>(id),
+        _writer(nullptr),
+        _counter(id) {
+
+    HLog("Creating timing probe '%s'", id.c_str());
+    previous->SetWriter(this);
+}
+
+int BoomaTimingWriter::Write(int16_t* src, size_t blocksize) {
+    if( _writer == nullptr ) {
+        return blocksize;
+    }
+    _counter.Begin();
+    int written = _writer->Write(src, blocksize);
+    _counter.End(blocksize);
+    return written;
+}
+
+BoomaTimingReader::BoomaTimingReader(std::string id, HReader<int16_t>* reader):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _counter(id) {
+
+    HLog("Creating timing probe '%s'", id.c_str());
+}
+
+int BoomaTimingReader::Read(int16_t* dest, size_t blocksize) {
+    _counter.Begin();
+    int read = _reader->Read(dest, blocksize);
+    _counter.End(read > 0 ? read : 0);
+    return read;
+}
+
+BoomaTimingCollection::BoomaTimingCollection(bool enabled):
+        _isEnabled(enabled) {
+}
+
+BoomaTimingCollection::~BoomaTimingCollection() {
+    for( std::vector<BoomaTimingWriter*>::iterator it = _writers.begin(); it != _writers.end(); it++ ) {
+        delete *it;
+    }
+    for( std::vector<BoomaTimingReader*>::iterator it = _readers.begin(); it != _readers.end(); it++ ) {
+        delete *it;
+    }
+}
+
+HWriterConsumer<int16_t>* BoomaTimingCollection::Probe(std::string name, HWriterConsumer<int16_t>* previous) {
+    if( !_isEnabled ) {
+        return previous;
+    }
+    BoomaTimingWriter* writer = new BoomaTimingWriter(name, previous);
+    _writers.push_back(writer);
+    _counters.push_back(writer->GetCounter());
+    return writer->Consumer();
+}
+
+HReader<int16_t>* BoomaTimingCollection::Probe(std::string name, HReader<int16_t>* reader) {
+    if( !_isEnabled ) {
+        return reader;
+    }
+    BoomaTimingReader* timingReader = new BoomaTimingReader(name, reader);
+    _readers.push_back(timingReader);
+    _counters.push_back(timingReader->GetCounter());
+    return timingReader;
+}
+
+void BoomaTimingCollection::GetStatistics(std::vector<BoomaStageStatistics>* statistics) {
+    for( std::vector<BoomaTimingCounter*>::iterator it = _counters.begin(); it != _counters.end(); it++ ) {
+        statistics->push_back((*it)->GetStatistics());
+    }
+}
+
+void BoomaTimingCollection::Reset() {
+    for( std::vector<BoomaTimingCounter*>::iterator it = _counters.begin(); it != _counters.end(); it++ ) {
+        (*it)->Reset();
+    }
+}
@@ -0,0 +1,210 @@
+#include <chrono>
+#include <cstring>
+#include <netdb.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "boomaudpreader.h"
+#include "boomainputexception.h"
+#include "booma.h"
+
+// Seconds between announcements of the head address to the server
+#define ANNOUNCE_INTERVAL 1
+
+// A sequence number this far from the expected datagram means that the server has restarted
+#define RESYNC_DISTANCE 1000
+
+BoomaUdpReader::BoomaUdpReader(std::string id, std::string server, int port, int depth, bool isRepeat, int samplerate):
+        HReader<int16_t>(id),
+        _server(server),
+        _port(port),
+        _depth(depth),
+        _isRepeat(isRepeat),
+        _samplerate(samplerate),
+        _socket(-1),
+        _thread(nullptr),
+        _isRunning(false),
+        _next(0),
+        _isPlaying(false),
+        _received(0),
+        _lost(0),
+        _late(0) {
+
+    // Connect to the server, so that only datagrams from the server are received
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    struct addrinfo* result;
+    if( getaddrinfo(server.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 ) {
+        HError("Unable to resolve remote input server %s", server.c_str());
+        throw new BoomaInputException("Unable to resolve remote input server");
+    }
+    for( struct addrinfo* it = result; it != nullptr && _socket < 0; it = it->ai_next ) {
+        _socket = socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+        if( _socket >= 0 && connect(_socket, it->ai_addr, it->ai_addrlen) < 0 ) {
+            close(_socket);
+            _socket = -1;
+        }
+    }
+    freeaddrinfo(result);
+    if( _socket < 0 ) {
+        HError("Unable to create UDP socket for %s:%d", server.c_str(), port);
+        throw new BoomaInputException("Unable to create UDP socket for the remote input server");
+    }
+
+    // Wake up regularly to announce the head address
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 200000;
+    setsockopt(_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    HLog("Receiving UDP datagrams from %s:%d with a jitter buffer of %d datagrams", server.c_str(), port, depth);
+}
+
+BoomaUdpReader::~BoomaUdpReader() {
+    Stop();
+    close(_socket);
+    HLog("Received %lu UDP datagrams, %lu lost and %lu late", _received, _lost, _late);
+}
+
+bool BoomaUdpReader::Start() {
+    if( _thread != nullptr ) {
+        return true;
+    }
+    _isRunning = true;
+    _thread = new std::thread(&BoomaUdpReader::ReceiverThread, this);
+    return true;
+}
+
+bool BoomaUdpReader::Stop() {
+    if( _thread == nullptr ) {
+        return true;
+    }
+    _isRunning = false;
+    _arrived.notify_all();
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    return true;
+}
+
+void BoomaUdpReader::ReceiverThread() {
+    std::vector<uint8_t> datagram(65536);
+    std::chrono::steady_clock::time_point announced;
+    bool isAnnounced = false;
+
+    while( _isRunning ) {
+
+        // Tell the server where to send the samples
+        if( !isAnnounced || std::chrono::steady_clock::now() - announced >= std::chrono::seconds(ANNOUNCE_INTERVAL) ) {
+            if( send(_socket, "BUH1", 4, 0) < 0 ) {
+                HError("Failed to announce the remote head to %s:%d", _server.c_str(), _port);
+            }
+            announced = std::chrono::steady_clock::now();
+            isAnnounced = true;
+        }
+
+        ssize_t length = recv(_socket, datagram.data(), datagram.size(), 0);
+        if( length <= 0 ) {
+            continue;
+        }
+
+        size_t used;
+        WireFormatType format;
+        uint32_t sequence;
+        uint64_t timestamp;
+        std::vector<int16_t> samples;
+        if( BoomaWireFormat::Decode(datagram.data(), length, &used, &format, &sequence, &timestamp, &samples) != BoomaWireFormat::DECODED ) {
+            HError("Received a damaged UDP datagram");
+            continue;
+        }
+        _meter.AddBytes(length);
+        _meter.AddTimestamp(timestamp);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _received++;
+        int32_t distance = (int32_t) (sequence - _next);
+        if( _isPlaying && distance < 0 && distance > -RESYNC_DISTANCE ) {
+            _late++;
+            continue;
+        }
+        _packets[sequence] = samples;
+
+        // Keep no more than the jitter buffer, dropping the oldest datagrams while not playing
+        // or when the reader has fallen behind
+        while( (int) _packets.size() > _depth ) {
+            _packets.erase(_packets.begin());
+            if( _isPlaying ) {
+                _lost++;
+            }
+        }
+        _arrived.notify_one();
+    }
+}
+
+int BoomaUdpReader::Read(int16_t* dest, size_t blocksize) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while( _pending.size() < blocksize ) {
+
+        // Fill the jitter buffer before playing
+        if( !_isPlaying ) {
+            if( !_arrived.wait_for(lock, std::chrono::seconds(UDP_FIRST_DATAGRAM_SECONDS), [this] { return (int) _packets.size() >= _depth || !_isRunning; }) ) {
+                HError("No UDP datagrams received in %d seconds, is the server started with '-udp' ?", UDP_FIRST_DATAGRAM_SECONDS);
+                return 0;
+            }
+            if( !_isRunning ) {
+                return 0;
+            }
+            _next = _packets.begin()->first;
+            _isPlaying = true;
+        }
+
+        // Wait for the next datagram, until the buffer is full of later datagrams or has been
+        // dry for as long as it takes to play a full buffer
+        double seconds = _previous.empty() ? 0.1 : (_depth * _previous.size()) / _samplerate;
+        _arrived.wait_for(lock, std::chrono::microseconds((long) (seconds * 1000000)), [this] {
+            return _packets.count(_next) > 0 || (int) _packets.size() >= _depth || !_isRunning;
+        });
+        if( !_isRunning ) {
+            return 0;
+        }
+
+        // Restart after a server restart
+        if( !_packets.empty() && _packets.count(_next) == 0 ) {
+            int32_t distance = (int32_t) (_packets.begin()->first - _next);
+            if( distance >= RESYNC_DISTANCE || distance < 0 ) {
+                HLog("UDP sequence jumped from %u to %u, resynchronizing", _next, _packets.begin()->first);
+                _next = _packets.begin()->first;
+            }
+        }
+
+        // Play or conceal the datagram
+        std::map<uint32_t, std::vector<int16_t>>::iterator it = _packets.find(_next);
+        if( it != _packets.end() ) {
+            _previous = it->second;
+            _packets.erase(it);
+            _pending.insert(_pending.end(), _previous.begin(), _previous.end());
+        } else if( !_previous.empty() ) {
+            _lost++;
+            if( _isRepeat ) {
+                _pending.insert(_pending.end(), _previous.begin(), _previous.end());
+            } else {
+                _pending.insert(_pending.end(), _previous.size(), 0);
+            }
+        }
+        _next++;
+    }
+
+    memcpy((void*) dest, (void*) _pending.data(), blocksize * sizeof(int16_t));
+    _pending.erase(_pending.begin(), _pending.begin() + blocksize);
+    return blocksize;
+}
+
+void BoomaUdpReader::GetStatistics(BoomaRemoteStatistics* statistics) {
+    _meter.GetStatistics(statistics);
+    std::lock_guard<std::mutex> lock(_mutex);
+    statistics->QueueDepth = _packets.size();
+    statistics->Dropped = _lost;
+}
@@ -0,0 +1,156 @@
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "boomaudpsender.h"
+#include "boomainputexception.h"
+#include "booma.h"
+
+BoomaUdpSender::BoomaUdpSender(std::string id, HReader<int16_t>* reader, int port, WireFormatType format, int channels, size_t blocksize):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _format(format),
+        _channels(channels),
+        _blocksize(blocksize),
+        _block(nullptr),
+        _socket(-1),
+        _headLength(0),
+        _sequence(0),
+        _failed(0),
+        _thread(nullptr),
+        _isRunning(false),
+        _isHeartbeatDue(false),
+        _isEndOfInput(false),
+        _endOfInput(0) {
+
+    _socket = socket(AF_INET6, SOCK_DGRAM, 0);
+    if( _socket < 0 ) {
+        HError("Unable to create UDP socket");
+        throw new BoomaInputException("Unable to create UDP socket");
+    }
+    int no = 0;
+    setsockopt(_socket, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no));
+    struct sockaddr_in6 address;
+    memset(&address, 0, sizeof(address));
+    address.sin6_family = AF_INET6;
+    address.sin6_addr = in6addr_any;
+    address.sin6_port = htons(port);
+    if( bind(_socket, (struct sockaddr*) &address, sizeof(address)) < 0 ) {
+        close(_socket);
+        HError("Unable to bind UDP port %d", port);
+        throw new BoomaInputException("Unable to bind UDP port");
+    }
+
+    HLog("Sending %s samples as UDP datagrams from port %d", BoomaWireFormat::GetName(format), port);
+    _block = new int16_t[blocksize];
+}
+
+BoomaUdpSender::~BoomaUdpSender() {
+    Stop();
+    close(_socket);
+    delete[] _block;
+}
+
+void BoomaUdpSender::ReceiveAnnouncements() {
+    uint8_t buffer[16];
+    struct sockaddr_storage from;
+    socklen_t length = sizeof(from);
+    ssize_t received;
+    while( (received = recvfrom(_socket, buffer, sizeof(buffer), MSG_DONTWAIT, (struct sockaddr*) &from, &length)) >= 0 ) {
+        if( received == 4 && memcmp(buffer, "BUH1", 4) == 0 ) {
+            if( _headLength != length || memcmp(&_head, &from, length) != 0 ) {
+                HLog("Remote head announced a new UDP address");
+            }
+            memcpy(&_head, &from, length);
+            _headLength = length;
+        }
+        length = sizeof(from);
+    }
+}
+
+bool BoomaUdpSender::Start() {
+    if( !_reader->Start() ) {
+        return false;
+    }
+    if( _thread == nullptr ) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isHeartbeatDue = false;
+            _isEndOfInput = false;
+        }
+        _isRunning = true;
+        _thread = new std::thread(&BoomaUdpSender::SenderThread, this);
+    }
+    return true;
+}
+
+bool BoomaUdpSender::Stop() {
+    if( _thread != nullptr ) {
+        _isRunning = false;
+        _heartbeat.notify_all();
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+    }
+    return _reader->Stop();
+}
+
+void BoomaUdpSender::SenderThread() {
+    HLog("UDP sender thread started");
+
+    int blocks = 0;
+    while( _isRunning ) {
+        int length = _reader->Read(_block, _blocksize);
+        if( length <= 0 ) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isEndOfInput = true;
+            _endOfInput = length;
+            _heartbeat.notify_all();
+            break;
+        }
+
+        // Split the block into datagrams of whole samples (or IQ pairs)
+        ReceiveAnnouncements();
+        if( _headLength > 0 ) {
+            int packet = UDP_PACKET_SAMPLES - (UDP_PACKET_SAMPLES % _channels);
+            for( int position = 0; position < length; position += packet ) {
+                int samples = position + packet <= length ? packet : length - position;
+                _frame.clear();
+                BoomaWireFormat::Encode(&_block[position], samples - (samples % _channels), _channels, _format, _sequence++, BoomaLinkMeter::Now(), &_frame);
+                if( sendto(_socket, _frame.data(), _frame.size(), 0, (struct sockaddr*) &_head, _headLength) < 0 ) {
+                    if( _failed++ == 0 ) {
+                        HError("Failed to send UDP datagram to the remote head");
+                    }
+                } else {
+                    _meter.AddBytes(_frame.size());
+                }
+            }
+        }
+
+        // Let the data connection carry a keepalive
+        if( ++blocks == UDP_HEARTBEAT_BLOCKS ) {
+            blocks = 0;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _isHeartbeatDue = true;
+            _heartbeat.notify_all();
+        }
+    }
+    HLog("UDP sender thread stopped");
+}
+
+int BoomaUdpSender::Read(int16_t* dest, size_t blocksize) {
+
+    // Wait for the sender thread, but send a keepalive even if the input has stalled. If the
+    // data connection falls behind, the missed keepalives are not sent later
+    std::unique_lock<std::mutex> lock(_mutex);
+    _heartbeat.wait_for(lock, std::chrono::seconds(UDP_KEEPALIVE_SECONDS), [this] {
+        return _isHeartbeatDue || _isEndOfInput || !_isRunning;
+    });
+    if( _isEndOfInput ) {
+        return _endOfInput;
+    }
+    _isHeartbeatDue = false;
+
+    memset((void*) dest, 0, blocksize * sizeof(int16_t));
+    return blocksize;
+}
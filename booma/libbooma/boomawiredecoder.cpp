@@ -0,0 +1,101 @@
+#include "boomawiredecoder.h"
+#include "boomainputexception.h"
+
+BoomaWireDecoder::BoomaWireDecoder(std::string id, HWriterConsumer<int16_t>* previous, size_t blocksize, bool isFramed):
+        HWriter<int16_t>(id),
+        _writer(nullptr),
+        _blocksize(blocksize),
+        _isFramed(isFramed),
+        _isChecked(false),
+        _format(NO_WIRE),
+        _expected(0),
+        _frames(0),
+        _lost(0),
+        _corrupt(0),
+        _queued(0) {
+
+    previous->SetWriter(this);
+}
+
+BoomaWireDecoder::~BoomaWireDecoder() {
+    if( _isFramed ) {
+        HLog("Received %lu wire frames, %lu lost and %lu corrupt", _frames, _lost.load(), _corrupt.load());
+    }
+}
+
+int BoomaWireDecoder::Write(int16_t* src, size_t blocksize) {
+    const uint8_t* bytes = (const uint8_t*) src;
+
+    // The stream starts with a frame header if, and only if, the server sends wire frames
+    if( !_isChecked ) {
+        bool isHeader = BoomaWireFormat::IsHeader(bytes, blocksize * sizeof(int16_t));
+        if( _isFramed && !isHeader ) {
+            HError("The remote input server is not sending wire frames, remove '-wf' from the head or add it to the server");
+            throw new BoomaInputException("The remote input server is not sending wire frames");
+        }
+        if( !_isFramed && isHeader ) {
+            HError("The remote input server is sending wire frames, add '-wf' to the head");
+            throw new BoomaInputException("The remote input server is sending wire frames");
+        }
+        _isChecked = true;
+    }
+
+    // Raw samples are passed on as they are
+    if( !_isFramed ) {
+        _meter.AddBytes(blocksize * sizeof(int16_t));
+        return _writer != nullptr ? _writer->Write(src, blocksize) : blocksize;
+    }
+    _received.insert(_received.end(), bytes, bytes + (blocksize * sizeof(int16_t)));
+    _meter.AddBytes(blocksize * sizeof(int16_t));
+
+    // Decode all complete frames
+    size_t position = 0;
+    for( ;; ) {
+        size_t used;
+        WireFormatType format;
+        uint32_t sequence;
+        uint64_t timestamp;
+        BoomaWireFormat::Result result = BoomaWireFormat::Decode(_received.data() + position, _received.size() - position, &used, &format, &sequence, &timestamp, &_samples);
+        position += used;
+        if( result == BoomaWireFormat::INCOMPLETE ) {
+            break;
+        }
+        if( result == BoomaWireFormat::CORRUPT ) {
+            HError("Skipped corrupt wire frame");
+            _corrupt++;
+            continue;
+        }
+
+        if( format != _format ) {
+            HLog("Remote input is sending %s wire frames", BoomaWireFormat::GetName(format));
+            _format = format;
+        }
+        if( _frames > 0 && sequence != _expected ) {
+            HError("Lost %u wire frames before frame %u", sequence - _expected, sequence);
+            _lost += sequence - _expected;
+        }
+        _expected = sequence + 1;
+        _frames++;
+        _meter.AddTimestamp(timestamp);
+    }
+    _received.erase(_received.begin(), _received.begin() + position);
+
+    // Write the decoded samples in whole blocks
+    size_t written = 0;
+    while( _samples.size() - written >= _blocksize ) {
+        if( _writer != nullptr ) {
+            _writer->Write(&_samples[written], _blocksize);
+        }
+        written += _blocksize;
+    }
+    _samples.erase(_samples.begin(), _samples.begin() + written);
+    _queued = _samples.size();
+
+    return blocksize;
+}
+
+void BoomaWireDecoder::GetStatistics(BoomaRemoteStatistics* statistics) {
+    _meter.GetStatistics(statistics);
+    statistics->QueueDepth = _queued;
+    statistics->Dropped = _lost;
+}
@@ -0,0 +1,62 @@
+#include <cstring>
+
+#include "boomawireencoder.h"
+
+BoomaWireEncoder::BoomaWireEncoder(std::string id, HReader<int16_t>* reader, WireFormatType format, int channels, size_t blocksize):
+        HReader<int16_t>(id),
+        _reader(reader),
+        _format(format),
+        _channels(channels),
+        _blocksize(blocksize),
+        _block(nullptr),
+        _sequence(0),
+        _samplesIn(0),
+        _bytesOut(0) {
+
+    if( format != NO_WIRE ) {
+        HLog("Sending %s wire frames with %d channels", BoomaWireFormat::GetName(format), channels);
+    }
+    _block = new int16_t[blocksize];
+}
+
+BoomaWireEncoder::~BoomaWireEncoder() {
+    if( _bytesOut > 0 ) {
+        HLog("Sent %llu samples in %llu bytes (%.1f%% of raw samples)", _samplesIn, _bytesOut, (100.0 * _bytesOut) / (_samplesIn * sizeof(int16_t)));
+    }
+    delete[] _block;
+}
+
+int BoomaWireEncoder::Read(int16_t* dest, size_t blocksize) {
+    size_t size = blocksize * sizeof(int16_t);
+
+    // Raw samples
+    if( _format == NO_WIRE ) {
+        int length = _reader->Read(dest, blocksize);
+        if( length > 0 ) {
+            _meter.AddBytes(length * sizeof(int16_t));
+        }
+        return length;
+    }
+
+    // Encode blocks until the output block can be filled
+    while( _pending.size() < size ) {
+        int length = _reader->Read(_block, _blocksize);
+        if( length <= 0 ) {
+
+            // Flush the last frame, the head skips the zero padding while looking for the next frame
+            if( _pending.empty() ) {
+                return length;
+            }
+            _pending.resize(size, 0);
+            break;
+        }
+        BoomaWireFormat::Encode(_block, length - (length % _channels), _channels, _format, _sequence++, BoomaLinkMeter::Now(), &_pending);
+        _samplesIn += length;
+    }
+
+    memcpy((void*) dest, (void*) _pending.data(), size);
+    _pending.erase(_pending.begin(), _pending.begin() + size);
+    _bytesOut += size;
+    _meter.AddBytes(size);
+    return blocksize;
+}
@@ -0,0 +1,217 @@
+#include <cstring>
+
+#include <hardtapi.h>
+
+#include "boomawireformat.h"
+#include "boomalosslesscodec.h"
+#include "boomalittleendian.h"
+
+// Largest number of bytes a payload can exceed the raw samples with (BLC frame header and per channel values)
+#define MAX_OVERHEAD 64
+
+// Sample width of the reduced width formats, 16 for the full width formats
+static int GetBits(WireFormatType format) {
+    switch( format ) {
+        case PACK12_WIRE:
+        case BLC12_WIRE:
+            return 12;
+        case PACK8_WIRE:
+        case BLC8_WIRE:
+            return 8;
+        default:
+            return 16;
+    }
+}
+
+// Smallest right shift that makes all samples fit in the given width
+static int GetShift(const int16_t* samples, int length, int bits) {
+    int peak = 0;
+    for( int i = 0; i < length; i++ ) {
+        int magnitude = samples[i] < 0 ? ~samples[i] : samples[i];
+        if( magnitude > peak ) {
+            peak = magnitude;
+        }
+    }
+    int shift = 0;
+    while( (peak >> shift) >= (1 << (bits - 1)) ) {
+        shift++;
+    }
+    return shift;
+}
+
+void BoomaWireFormat::Encode(const int16_t* samples, int length, int channels, WireFormatType format, uint32_t sequence, uint64_t timestamp, std::vector<uint8_t>* frame) {
+
+    // Scale the samples to the width of the format
+    int bits = GetBits(format);
+    int shift = bits < 16 ? GetShift(samples, length, bits) : 0;
+    std::vector<int16_t> scaled;
+    if( shift > 0 ) {
+        scaled.resize(length);
+        for( int i = 0; i < length; i++ ) {
+            scaled[i] = samples[i] >> shift;
+        }
+        samples = scaled.data();
+    }
+
+    // Header, the payload size is set when the payload has been written
+    size_t start = frame->size();
+    frame->resize(start + HeaderSize);
+    uint8_t* header = &(*frame)[start];
+    header[0] = 'B';
+    header[1] = 'W';
+    header[2] = Version;
+    header[3] = format;
+    WriteLittleEndian(&header[4], sequence, 4);
+    WriteLittleEndian(&header[8], length, 2);
+    header[10] = channels;
+    header[11] = shift;
+    WriteLittleEndian(&header[16], timestamp & 0xffffffff, 4);
+    WriteLittleEndian(&header[20], timestamp >> 32, 4);
+
+    // Payload
+    switch( format ) {
+        case PACK12_WIRE:
+            for( int i = 0; i < length; i += 2 ) {
+                uint16_t a = samples[i] & 0xfff;
+                uint16_t b = i + 1 < length ? samples[i + 1] & 0xfff : 0;
+                frame->push_back(a & 0xff);
+                frame->push_back((a >> 8) | ((b & 0x0f) << 4));
+                frame->push_back(b >> 4);
+            }
+            break;
+        case PACK8_WIRE:
+            for( int i = 0; i < length; i++ ) {
+                frame->push_back(samples[i] & 0xff);
+            }
+            break;
+        case BLC_WIRE:
+        case BLC12_WIRE:
+        case BLC8_WIRE: {
+            std::vector<uint8_t> compressed;
+            BoomaLosslessCodec::Encode(samples, length, channels, &compressed);
+            frame->insert(frame->end(), compressed.begin(), compressed.end());
+            break;
+        }
+        default:
+            for( int i = 0; i < length; i++ ) {
+                frame->push_back(samples[i] & 0xff);
+                frame->push_back((samples[i] >> 8) & 0xff);
+            }
+            break;
+    }
+    WriteLittleEndian(&(*frame)[start + 12], frame->size() - start - HeaderSize, 4);
+}
+
+BoomaWireFormat::Result BoomaWireFormat::Decode(const uint8_t* data, size_t size, size_t* used, WireFormatType* format, uint32_t* sequence, uint64_t* timestamp, std::vector<int16_t>* samples) {
+
+    // Find the next plausible frame header
+    size_t position = 0;
+    const uint8_t* header;
+    for( ;; position++ ) {
+        if( position + HeaderSize > size ) {
+            *used = position;
+            return INCOMPLETE;
+        }
+        header = &data[position];
+        if( IsHeader(header, size - position) ) {
+            break;
+        }
+    }
+    if( position > 0 ) {
+        HError("Skipped %lu bytes while searching for the next wire frame", (unsigned long) position);
+    }
+
+    // Wait for the complete frame
+    size_t payloadSize = ReadLittleEndian(&header[12], 4);
+    if( position + HeaderSize + payloadSize > size ) {
+        *used = position;
+        return INCOMPLETE;
+    }
+    *used = position + HeaderSize + payloadSize;
+    *format = (WireFormatType) header[3];
+    *sequence = ReadLittleEndian(&header[4], 4);
+    *timestamp = ReadLittleEndian(&header[16], 4) | (((uint64_t) ReadLittleEndian(&header[20], 4)) << 32);
+    int length = ReadLittleEndian(&header[8], 2);
+    int channels = header[10];
+    int shift = header[11];
+    const uint8_t* payload = &header[HeaderSize];
+
+    // Payload
+    size_t base = samples->size();
+    switch( *format ) {
+        case PACK12_WIRE:
+            if( payloadSize != (size_t) ((length + 1) / 2) * 3 ) {
+                return CORRUPT;
+            }
+            samples->resize(base + length);
+            for( int i = 0; i < length; i += 2 ) {
+                const uint8_t* p = &payload[(i / 2) * 3];
+                (*samples)[base + i] = ((int16_t) ((p[0] | ((p[1] & 0x0f) << 8)) << 4)) >> 4;
+                if( i + 1 < length ) {
+                    (*samples)[base + i + 1] = ((int16_t) (((p[1] >> 4) | (p[2] << 4)) << 4)) >> 4;
+                }
+            }
+            break;
+        case PACK8_WIRE:
+            if( payloadSize != (size_t) length ) {
+                return CORRUPT;
+            }
+            samples->resize(base + length);
+            for( int i = 0; i < length; i++ ) {
+                (*samples)[base + i] = (int8_t) payload[i];
+            }
+            break;
+        case BLC_WIRE:
+        case BLC12_WIRE:
+        case BLC8_WIRE:
+            if( !BoomaLosslessCodec::DecodeFrame(payload, payloadSize, channels, samples) || samples->size() != base + length ) {
+                samples->resize(base);
+                return CORRUPT;
+            }
+            break;
+        default:
+            if( payloadSize != (size_t) length * 2 ) {
+                return CORRUPT;
+            }
+            samples->resize(base + length);
+            for( int i = 0; i < length; i++ ) {
+                (*samples)[base + i] = (int16_t) (payload[i * 2] | (payload[(i * 2) + 1] << 8));
+            }
+            break;
+    }
+
+    // Restore the scale, placing the value in the middle of the truncated range
+    if( shift > 0 ) {
+        int32_t half = 1 << (shift - 1);
+        for( size_t i = base; i < samples->size(); i++ ) {
+            (*samples)[i] = (int16_t) ((((int32_t) (*samples)[i]) << shift) + half);
+        }
+    }
+    return DECODED;
+}
+
+bool BoomaWireFormat::IsHeader(const uint8_t* data, size_t size) {
+    return size >= HeaderSize
+            && data[0] == 'B' && data[1] == 'W' && data[2] == Version && data[3] <= BLC8_WIRE
+            && data[10] >= 1 && data[10] <= 2 && data[11] < 16
+            && ReadLittleEndian(&data[12], 4) <= (ReadLittleEndian(&data[8], 2) * 2) + MAX_OVERHEAD;
+}
+
+const char* BoomaWireFormat::GetName(WireFormatType format) {
+    switch( format ) {
+        case RAW_WIRE:
+            return "RAW";
+        case BLC_WIRE:
+            return "BLC";
+        case PACK12_WIRE:
+            return "P12";
+        case PACK8_WIRE:
+            return "P8";
+        case BLC12_WIRE:
+            return "BLC12";
+        case BLC8_WIRE:
+            return "BLC8";
+        default:
+            return "NONE";
+    }
+}
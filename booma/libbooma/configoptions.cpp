@@ -1,11 +1,13 @@
 #include <stdlib.h>
 #include <iostream>
 #include <cstring>
+#include <cmath>
 #include <sys/stat.h>
 #include <dirent.h>
 
 #include "booma.h"
 #include "configoptions.h"
+#include "boomawireformat.h"
 #include "language.h"
 
 void ConfigOptions::PrintUsage(bool showSecretSettings) {
@@ -26,6 +28,7 @@ void ConfigOptions::PrintUsage(bool showSecretSettings) {
     std::cout << tr("Use RTL-SDR input source (datatype defaults to IQ)       -i RTLSDR devicenumber") << std::endl;
     std::cout << tr("Use pcm file as input                                    -i PCM filename") << std::endl;
     std::cout << tr("Use wav file as input                                    -i WAV filename") << std::endl;
+    std::cout << tr("Use compressed (BLC) file as input                       -i BLC filename") << std::endl;
     std::cout << tr("Use network input                                        -i NETWORK address dataport commandport") << std::endl;
     std::cout << tr("Set input datatype (required for NETWORK and PCM input)  -it REAl|IQ|I|Q") << std::endl;
     std::cout << tr("Set input type (required for NETWORK and PCM input)      -is AUDIO|RTLSDR") << std::endl;
@@ -34,12 +37,15 @@ void ConfigOptions::PrintUsage(bool showSecretSettings) {
     std::cout << std::endl;
 
     std::cout << tr("==[Receiver, frequency and gain]==") << std::endl;
-    std::cout << tr("Select receiver (CW default)                             -m CW|AURORAL|AM|SSB") << std::endl;
+    std::cout << tr("Select receiver (CW default)                             -m CW|AURORAL|AM|SSB|RTTY") << std::endl;
     std::cout << tr("Select frequency (default 17.2KHz)                       -f frequecy") << std::endl;
     std::cout << tr("Rf gain (default 0 = auto)                               -g gain") << std::endl;
     std::cout << tr("Set receiver option (can be repeated)                    -ro NAME=VALUE") << std::endl;
     std::cout << tr("Enable or disable RF gain (AGC) (default enabled)        -rfg 1 (enable) or -rfg 0 (disable)") << std::endl;
     std::cout << tr("Set preamp level (default off)                           -pa -1 (-12dB) or -pa 0 (off) or -pa 1 (+12dB)") << std::endl;
+    std::cout << tr("Add receiver channel on the same input (can be repeated) -mc NAME:FREQUENCY") << std::endl;
+    std::cout << tr("Decode CW in the receiver and its channels (CW mode)     -cwd") << std::endl;
+    std::cout << tr("Decode all CW signals in the input passband (skimmer)    -sk") << std::endl;
     std::cout << std::endl;
 
     std::cout << tr("==[Output, recordings]==") << std::endl;
@@ -48,9 +54,20 @@ void ConfigOptions::PrintUsage(bool showSecretSettings) {
     std::cout << tr("Output volume (default 5)                                -l volume") << std::endl;
     std::cout << tr("Dump rf input as pcm to file                             -p PCM (enable) | -p OFF (disable)") << std::endl;
     std::cout << tr("Dump rf input as wav to file (default)                   -p WAV (enable) | -p OFF (disable)") << std::endl;
+    std::cout << tr("Dump rf input as compressed (BLC) file                   -p BLC (enable) | -p OFF (disable)") << std::endl;
     std::cout << tr("Dump output audio as pcm to file                         -a PCM (enable) | -a OFF (disable)") << std::endl;
     std::cout << tr("Dump output audio as wav to file                         -a WAV (enable) | -a OFF (disable)") << std::endl;
+    std::cout << tr("Dump output audio as compressed (BLC) file               -a BLC (enable) | -a OFF (disable)") << std::endl;
     std::cout << tr("Dump file suffix. If not set, a timestamp is used        -dfs suffix") << std::endl;
+    std::cout << tr("Start a new pcm or wav dump file every n minutes         -dsm minutes") << std::endl;
+    std::cout << tr("Start a new pcm or wav dump file at this size            -dsz megabytes") << std::endl;
+    std::cout << tr("Delete the oldest dump files above this total size       -dsl megabytes") << std::endl;
+    std::cout << tr("Write pcm and wav dump files from a background thread    -aio") << std::endl;
+    std::cout << tr("Keep the last n seconds of rf and audio for capturing    -cap seconds") << std::endl;
+    std::cout << tr("Record when the signal reaches this level                -trg S-level") << std::endl;
+    std::cout << tr("Signal must stay above the level for (default 1 second)  -trh seconds") << std::endl;
+    std::cout << tr("Stop when below the level for (default 5 seconds)        -trr seconds") << std::endl;
+    std::cout << tr("Dumps started by the trigger (default AF)                -trs RF|AF|BOTH") << std::endl;
     std::cout << std::endl;
 
     std::cout << tr("==[Use with converters]==") << std::endl;
@@ -66,6 +83,12 @@ void ConfigOptions::PrintUsage(bool showSecretSettings) {
 
     std::cout << tr("==[Remote head operation]==") << std::endl;
     std::cout << tr("Server for remote input                                  -s dataport commandport") << std::endl;
+    std::cout << tr("Framed and compressed samples (server and head)          -wf OFF|RAW|BLC|P12|P8|BLC12|BLC8") << std::endl;
+    std::cout << tr("Extract channel on the server (server and head)          -sx width") << std::endl;
+    std::cout << tr("Number of heads served at once (ports +2 for each head)  -sc heads") << std::endl;
+    std::cout << tr("Samples over UDP, conceal losses (server and head)       -udp ZERO|REPEAT") << std::endl;
+    std::cout << tr("Jitter buffer size in UDP datagrams (head)               -udpj datagrams") << std::endl;
+    std::cout << tr("Print remote stream counters (booma-remote)              -rstat seconds") << std::endl;
     std::cout << std::endl;
 
     std::cout << tr("==[Options]==") << std::endl;
@@ -77,6 +100,16 @@ void ConfigOptions::PrintUsage(bool showSecretSettings) {
     std::cout << tr("==[Performance and quality (not persisted)]==") << std::endl;
     std::cout << tr("FIR filter size for decimation (default 51)              -ffs points") << std::endl;
     std::cout << tr("1.st IF filter width (default 10000)                     -ifw width") << std::endl;
+    std::cout << tr("Use polyphase channelizer for IQ input decimation        -pfb") << std::endl;
+    std::cout << tr("Input decimation plan (default FIR)                      -dp FIR|HALFBAND") << std::endl;
+    std::cout << tr("Input ring buffer size, 0 disables (default 0)           -rb blocks") << std::endl;
+    std::cout << tr("Run input, receiver and output in separate threads       -pl depth") << std::endl;
+    std::cout << tr("Pin receiver and output threads to cpus                  -pla cpu,cpu") << std::endl;
+    std::cout << tr("Measure time spent in input, receiver and output         -st") << std::endl;
+    std::cout << tr("Process file input as fast as possible (0 = all cores)   -batch segments") << std::endl;
+    std::cout << tr("Batch segment overlap for warm-up (default 2 seconds)    -bov seconds") << std::endl;
+    std::cout << tr("Memory map pcm or wav file input                         -mm") << std::endl;
+    std::cout << tr("Start reading memory mapped input at this time           -ss seconds") << std::endl;
     std::cout << std::endl;
 
     if( showSecretSettings ) {
@@ -327,7 +360,7 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
 
     // Check if we have some channels, if not then add a default set
     if( _values.at(_section)->_channels.empty() ) {
-        std::cout << "NO CHANNELS\n";
+        HLog("No channels in the stored configuration, reading persistent channels");
         _values.at(_section)->_channels = ReadPersistentChannels(CONFIGNAME, _section);
     }
 
@@ -349,6 +382,9 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             } else if( strcmp(argv[i + 1], "WAV") == 0 ) {
                 _values.at(_section)->_dumpAudio = true;
                 _values.at(_section)->_dumpAudioFileFormat = WAV;
+            } else if( strcmp(argv[i + 1], "BLC") == 0 ) {
+                _values.at(_section)->_dumpAudio = true;
+                _values.at(_section)->_dumpAudioFileFormat = BLC;
             } else {
                 _values.at(_section)->_dumpAudio = false;
             }
@@ -363,6 +399,75 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             continue;
         }
 
+        // Dump file segment duration
+        if( strcmp(argv[i], "-dsm") == 0 && i < argc - 1) {
+            _values.at(_section)->_dumpSegmentMinutes = atoi(argv[i + 1]);
+            HLog("Dump file segment duration set to %d minutes", _values.at(_section)->_dumpSegmentMinutes);
+            i++;
+            continue;
+        }
+
+        // Dump file segment size
+        if( strcmp(argv[i], "-dsz") == 0 && i < argc - 1) {
+            _values.at(_section)->_dumpSegmentSize = atoi(argv[i + 1]);
+            HLog("Dump file segment size set to %d MB", _values.at(_section)->_dumpSegmentSize);
+            i++;
+            continue;
+        }
+
+        // Total size of dump file segments
+        if( strcmp(argv[i], "-dsl") == 0 && i < argc - 1) {
+            _values.at(_section)->_dumpSegmentLimit = atoi(argv[i + 1]);
+            HLog("Dump file segments limited to %d MB", _values.at(_section)->_dumpSegmentLimit);
+            i++;
+            continue;
+        }
+
+        // Capture buffer
+        if( strcmp(argv[i], "-cap") == 0 && i < argc - 1) {
+            _values.at(_section)->_captureSeconds = atoi(argv[i + 1]);
+            HLog("Capture buffer set to %d seconds", _values.at(_section)->_captureSeconds);
+            i++;
+            continue;
+        }
+
+        // Signal triggered recording
+        if( strcmp(argv[i], "-trg") == 0 && i < argc - 1) {
+            _values.at(_section)->_triggerLevel = atoi(argv[i + 1]);
+            HLog("Recording triggered at signal level S%d", _values.at(_section)->_triggerLevel);
+            i++;
+            continue;
+        }
+        if( strcmp(argv[i], "-trh") == 0 && i < argc - 1) {
+            _values.at(_section)->_triggerHold = atof(argv[i + 1]);
+            HLog("Trigger hold time set to %f seconds", _values.at(_section)->_triggerHold);
+            i++;
+            continue;
+        }
+        if( strcmp(argv[i], "-trr") == 0 && i < argc - 1) {
+            _values.at(_section)->_triggerRelease = atof(argv[i + 1]);
+            HLog("Trigger release time set to %f seconds", _values.at(_section)->_triggerRelease);
+            i++;
+            continue;
+        }
+        if( strcmp(argv[i], "-trs") == 0 && i < argc - 1) {
+            _values.at(_section)->_triggerRf = strcmp(argv[i + 1], "RF") == 0 || strcmp(argv[i + 1], "BOTH") == 0;
+            _values.at(_section)->_triggerAudio = strcmp(argv[i + 1], "AF") == 0 || strcmp(argv[i + 1], "BOTH") == 0;
+            if( !_values.at(_section)->_triggerRf && !_values.at(_section)->_triggerAudio ) {
+                std::cout << tr("Unknown trigger source. Please use one of RF|AF|BOTH") << std::endl;
+                exit(1);
+            }
+            i++;
+            continue;
+        }
+
+        // Asynchronous dump file io
+        if( strcmp(argv[i], "-aio") == 0 ) {
+            _values.at(_section)->_asyncDump = true;
+            HLog("Asynchronous dump file writing enabled");
+            continue;
+        }
+
         // Frequency
         if( strcmp(argv[i], "-f") == 0 && i < argc - 1) {
             _values.at(_section)->_frequency = atoi(argv[i + 1]);
@@ -437,6 +542,13 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
                 _values.at(_section)->_isRemoteHead = false;
                 HLog("Input file %s", _values.at(_section)->_wavFile.c_str());
             }
+            else if( strcmp(argv[i + 1], "BLC") == 0 && i < argc - 2 ) {
+                _values.at(_section)->_inputSourceType = BLC_FILE;
+                _values.at(_section)->_blcFile = argv[i + 2];
+                _values.at(_section)->_inputSourceDataType = (_values.at(_section)->_inputSourceDataType == NO_INPUT_SOURCE_DATA_TYPE ? REAL_INPUT_SOURCE_DATA_TYPE : _values.at(_section)->_inputSourceDataType);
+                _values.at(_section)->_isRemoteHead = false;
+                HLog("Input file %s", _values.at(_section)->_blcFile.c_str());
+            }
             else if( strcmp(argv[i + 1], "SILENCE") == 0 ) {
                 _values.at(_section)->_inputSourceType = SILENCE;
                 _values.at(_section)->_inputSourceDataType = (_values.at(_section)->_inputSourceDataType == NO_INPUT_SOURCE_DATA_TYPE ? REAL_INPUT_SOURCE_DATA_TYPE : _values.at(_section)->_inputSourceDataType);
@@ -479,7 +591,7 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             }
             else
             {
-                std::cout << tr("Unknown input source. Please use on of the types AUDIO|RTLSDR|GENERATOR|PCM|WAV|SILENCE") << std::endl;
+                std::cout << tr("Unknown input source. Please use on of the types AUDIO|RTLSDR|GENERATOR|PCM|WAV|BLC|SILENCE") << std::endl;
                 exit(1);
             }
 
@@ -554,6 +666,9 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             else if( strcmp(argv[i + 1], "SSB") == 0 ) {
                 _values.at(_section)->_receiverModeType = SSB;
             }
+            else if( strcmp(argv[i + 1], "RTTY") == 0 ) {
+                _values.at(_section)->_receiverModeType = RTTY;
+            }
             else {
                 std::cout << "Unknown receiver type " << argv[i + 1] << std::endl;
                 exit(1);
@@ -596,6 +711,9 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             } else if( strcmp(argv[i + 1], "WAV") == 0 ) {
                 _values.at(_section)->_dumpRf = true;
                 _values.at(_section)->_dumpRfFileFormat = WAV;
+            } else if( strcmp(argv[i + 1], "BLC") == 0 ) {
+                _values.at(_section)->_dumpRf = true;
+                _values.at(_section)->_dumpRfFileFormat = BLC;
             } else {
                 _values.at(_section)->_dumpRf = false;
             }
@@ -637,6 +755,38 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             continue;
         }
 
+        // Additional receiver channels
+        if( strcmp(argv[i], "-mc") == 0 && i < argc - 1) {
+            std::string s(argv[i + 1]);
+            int pos = s.find(":");
+            if( pos <= 0 || pos >= s.size() - 1 ) {
+                std::cout << "Option '-mc' must have a parameter on the form 'NAME:FREQUENCY'" << std::endl;
+                exit(1);
+            }
+            if( atol(s.substr(pos + 1).c_str()) <= 0 ) {
+                std::cout << "FREQUENCY must be a positive number in receiver channel definition" << std::endl;
+                exit(1);
+            }
+            _values.at(_section)->_receiverChannels.push_back(new Channel(s.substr(0, pos), atol(s.substr(pos + 1).c_str())));
+            HLog("Added receiver channel %s at %ld", s.substr(0, pos).c_str(), atol(s.substr(pos + 1).c_str()));
+            i++;
+            continue;
+        }
+
+        // CW decoding
+        if( strcmp(argv[i], "-cwd") == 0 ) {
+            _values.at(_section)->_cwDecoder = true;
+            HLog("CW decoding enabled");
+            continue;
+        }
+
+        // CW skimmer
+        if( strcmp(argv[i], "-sk") == 0 ) {
+            _values.at(_section)->_skimmer = true;
+            HLog("CW skimmer enabled");
+            continue;
+        }
+
         // RTL-SDR options
         if( strcmp(argv[i], "-rtlc") == 0 && i < argc - 1) {
             _values.at(_section)->_rtlsdrCorrection = atoi(argv[i + 1]);
@@ -716,6 +866,99 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             continue;
         }
 
+        // Polyphase channelizer
+        if( strcmp(argv[i], "-pfb") == 0 ) {
+            _values.at(_section)->_polyphaseChannelizer = true;
+            HLog("Polyphase channelizer enabled");
+            continue;
+        }
+
+        // Input ring buffer size
+        if( strcmp(argv[i], "-rb") == 0 && i < argc - 1) {
+            _values.at(_section)->_inputRingBufferBlocks = atoi(argv[i + 1]);
+            HLog("Input ring buffer size set to %d blocks", _values.at(_section)->_inputRingBufferBlocks);
+            i++;
+            continue;
+        }
+
+        // Pipeline depth
+        if( strcmp(argv[i], "-pl") == 0 && i < argc - 1) {
+            _values.at(_section)->_pipelineDepth = atoi(argv[i + 1]);
+            HLog("Pipeline depth set to %d blocks", _values.at(_section)->_pipelineDepth);
+            i++;
+            continue;
+        }
+
+        // Pipeline cpu affinity
+        if( strcmp(argv[i], "-pla") == 0 && i < argc - 1) {
+            _values.at(_section)->_pipelineAffinity.clear();
+            std::istringstream cpus(argv[i + 1]);
+            std::string cpu;
+            while( std::getline(cpus, cpu, ',') ) {
+                _values.at(_section)->_pipelineAffinity.push_back(atoi(cpu.c_str()));
+                HLog("Pipeline stage %d pinned to cpu %s", _values.at(_section)->_pipelineAffinity.size(), cpu.c_str());
+            }
+            i++;
+            continue;
+        }
+
+        // Stage timing
+        if( strcmp(argv[i], "-st") == 0 ) {
+            _values.at(_section)->_stageTiming = true;
+            HLog("Stage timing enabled");
+            continue;
+        }
+
+        // Batch processing of file input
+        if( strcmp(argv[i], "-batch") == 0 && i < argc - 1) {
+            _values.at(_section)->_batchMode = true;
+            _values.at(_section)->_batchSegments = atoi(argv[i + 1]);
+            HLog("Batch mode enabled with %d segments", _values.at(_section)->_batchSegments);
+            i++;
+            continue;
+        }
+
+        // Batch segment overlap
+        if( strcmp(argv[i], "-bov") == 0 && i < argc - 1) {
+            _values.at(_section)->_batchOverlap = atoi(argv[i + 1]);
+            HLog("Batch segment overlap set to %d seconds", _values.at(_section)->_batchOverlap);
+            i++;
+            continue;
+        }
+
+        // Memory mapped file input
+        if( strcmp(argv[i], "-mm") == 0 ) {
+            _values.at(_section)->_memoryMappedInput = true;
+            HLog("Memory mapped file input enabled");
+            continue;
+        }
+
+        // Start position in file input
+        if( strcmp(argv[i], "-ss") == 0 && i < argc - 1) {
+            _values.at(_section)->_inputSeek = atof(argv[i + 1]);
+            HLog("Input start position set to %f seconds", _values.at(_section)->_inputSeek);
+            i++;
+            continue;
+        }
+
+        // Decimation plan
+        if( strcmp(argv[i], "-dp") == 0 && i < argc - 1) {
+            if( strcmp(argv[i + 1], "FIR") == 0 ) {
+                _values.at(_section)->_decimationPlan = FIR_DECIMATION;
+                HLog("Setting decimation plan to FIR");
+            }
+            else if( strcmp(argv[i + 1], "HALFBAND") == 0 ) {
+                _values.at(_section)->_decimationPlan = HALFBAND_DECIMATION;
+                HLog("Setting decimation plan to HALFBAND");
+            }
+            else {
+                std::cout << "Unknown or invalid decimation plan '" << argv[i + 1] << std::endl;
+                exit(1);
+            }
+            i++;
+            continue;
+        }
+
         // Automatic RF gain level
         if( strcmp(argv[i], "-ral") == 0 && i < argc - 1) {
             _values.at(_section)->_rfAgcLevel = atoi(argv[i + 1]);
@@ -742,6 +985,79 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
             continue;
         }
 
+        // Framing and compression of samples sent to a remote head
+        if( strcmp(argv[i], "-wf") == 0 && i < argc - 1) {
+            if( strcmp(argv[i + 1], "OFF") == 0 ) {
+                _values.at(_section)->_wireFormat = NO_WIRE;
+            } else if( strcmp(argv[i + 1], "RAW") == 0 ) {
+                _values.at(_section)->_wireFormat = RAW_WIRE;
+            } else if( strcmp(argv[i + 1], "BLC") == 0 ) {
+                _values.at(_section)->_wireFormat = BLC_WIRE;
+            } else if( strcmp(argv[i + 1], "P12") == 0 ) {
+                _values.at(_section)->_wireFormat = PACK12_WIRE;
+            } else if( strcmp(argv[i + 1], "P8") == 0 ) {
+                _values.at(_section)->_wireFormat = PACK8_WIRE;
+            } else if( strcmp(argv[i + 1], "BLC12") == 0 ) {
+                _values.at(_section)->_wireFormat = BLC12_WIRE;
+            } else if( strcmp(argv[i + 1], "BLC8") == 0 ) {
+                _values.at(_section)->_wireFormat = BLC8_WIRE;
+            } else {
+                std::cout << tr("Unknown wire format") << " '" << argv[i + 1] << "'" << std::endl;
+                exit(1);
+            }
+            HLog("Wire format set to %s", argv[i + 1]);
+            i++;
+            continue;
+        }
+
+        // Channel extraction on the remote input server
+        if( strcmp(argv[i], "-sx") == 0 && i < argc - 1) {
+            _values.at(_section)->_channelExtraction = atoi(argv[i + 1]);
+            HLog("Channel extraction set to %d Hz", _values.at(_section)->_channelExtraction);
+            i++;
+            continue;
+        }
+
+        // Number of remote heads served at once
+        if( strcmp(argv[i], "-sc") == 0 && i < argc - 1) {
+            _values.at(_section)->_remoteClients = atoi(argv[i + 1]);
+            HLog("Serving %d remote heads", _values.at(_section)->_remoteClients);
+            i++;
+            continue;
+        }
+
+        // UDP transport for samples sent to a remote head
+        if( strcmp(argv[i], "-udp") == 0 && i < argc - 1) {
+            if( strcmp(argv[i + 1], "ZERO") == 0 ) {
+                _values.at(_section)->_udpRepeat = false;
+            } else if( strcmp(argv[i + 1], "REPEAT") == 0 ) {
+                _values.at(_section)->_udpRepeat = true;
+            } else {
+                std::cout << tr("Unknown loss concealment") << " '" << argv[i + 1] << "'" << std::endl;
+                exit(1);
+            }
+            _values.at(_section)->_udpTransport = true;
+            HLog("UDP transport enabled with %s loss concealment", argv[i + 1]);
+            i++;
+            continue;
+        }
+
+        // Jitter buffer size for UDP transport
+        if( strcmp(argv[i], "-udpj") == 0 && i < argc - 1) {
+            _values.at(_section)->_jitterBufferPackets = atoi(argv[i + 1]);
+            HLog("Jitter buffer set to %d datagrams", _values.at(_section)->_jitterBufferPackets);
+            i++;
+            continue;
+        }
+
+        // Interval between printing remote stream counters
+        if( strcmp(argv[i], "-rstat") == 0 && i < argc - 1) {
+            _values.at(_section)->_remoteStatisticsInterval = atoi(argv[i + 1]);
+            HLog("Printing remote stream counters every %d seconds", _values.at(_section)->_remoteStatisticsInterval);
+            i++;
+            continue;
+        }
+
         // Scheduled start and stop
         if( strcmp(argv[i], "-b") == 0 ) {
             _values.at(_section)->_schedule.SetStart(argv[i + 1]);
@@ -793,6 +1109,44 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
     }
 
     // Check configuration for remote server/head
+    if( _values.at(_section)->_wireFormat != NO_WIRE && !_values.at(_section)->_isRemoteHead && !_values.at(_section)->_useRemoteHead ) {
+        std::cout << tr("A wire format can only be used with a remote head '-i NETWORK ..' or server '-s ..'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_remoteClients < 1 ) {
+        std::cout << tr("Please serve at least one remote head with '-sc heads'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_remoteClients > 1 && !_values.at(_section)->_useRemoteHead ) {
+        std::cout << tr("Serving several remote heads requires a server '-s ..'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_udpTransport && !_values.at(_section)->_isRemoteHead && !_values.at(_section)->_useRemoteHead ) {
+        std::cout << tr("UDP transport can only be used with a remote head '-i NETWORK ..' or server '-s ..'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_jitterBufferPackets < 1 ) {
+        std::cout << tr("Please use a jitter buffer of at least one datagram with '-udpj datagrams'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_remoteStatisticsInterval < 0 ) {
+        std::cout << tr("Please use a positive interval with '-rstat seconds'") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_channelExtraction > 0 ) {
+        if( !_values.at(_section)->_isRemoteHead && !_values.at(_section)->_useRemoteHead ) {
+            std::cout << tr("Channel extraction can only be used with a remote head '-i NETWORK ..' or server '-s ..'") << std::endl;
+            exit(1);
+        }
+        if( _values.at(_section)->_inputSourceDataType != IQ_INPUT_SOURCE_DATA_TYPE ) {
+            std::cout << tr("Channel extraction requires IQ input") << std::endl;
+            exit(1);
+        }
+        if( _values.at(_section)->_outputSampleRate % _values.at(_section)->_channelExtraction != 0 || _values.at(_section)->_outputSampleRate / _values.at(_section)->_channelExtraction < 2 ) {
+            std::cout << tr("The channel width must divide the output samplerate by an integer factor of 2 or more") << std::endl;
+            exit(1);
+        }
+    }
     if( _values.at(_section)->_isRemoteHead && _values.at(_section)->_remoteServer.empty() ) {
         std::cout << tr("Please select address of remote input with '-r address port'") << std::endl;
         exit(1);
@@ -878,6 +1232,63 @@ ConfigOptions::ConfigOptions(std::string appName, std::string appVersion, int ar
                 }
             }
         }
+        else if( _values.at(_section)->_inputSourceType == BLC_FILE ) {
+
+            // We need a filename
+            if( _values.at(_section)->_blcFile.empty() ) {
+                std::cout << tr("Please select the input filename with '-i BLC filename'") << std::endl;
+                exit(1);
+            }
+
+            // Check if the input file exists
+            struct stat stats;
+            if( stat(_values.at(_section)->_blcFile.c_str(), &stats) != -1 ) {
+                if( !S_ISREG(stats.st_mode) ) {
+                    std::cout << "Input file does not exist" << std::endl;
+                    exit(1);
+                }
+            }
+        }
+    }
+
+    // Triggered recordings keeps the leading edge in the capture buffer, which must cover the hold time
+    if( _values.at(_section)->_triggerLevel > 0 ) {
+        if( _values.at(_section)->_captureSeconds == 0 ) {
+            _values.at(_section)->_captureSeconds = (int) ceil(_values.at(_section)->_triggerHold) + 5;
+            HLog("Capture buffer set to %d seconds for triggered recordings", _values.at(_section)->_captureSeconds);
+        }
+        if( _values.at(_section)->_captureSeconds < _values.at(_section)->_triggerHold ) {
+            std::cout << tr("The capture buffer ('-cap seconds') must be at least as long as the trigger hold time") << std::endl;
+            exit(1);
+        }
+    }
+
+    // Limiting the total dump size requires segmented dump files
+    if( _values.at(_section)->_dumpSegmentLimit > 0 && _values.at(_section)->_dumpSegmentMinutes <= 0 && _values.at(_section)->_dumpSegmentSize <= 0 ) {
+        std::cout << tr("Limiting the total dump size requires segmented dump files ('-dsm minutes' or '-dsz megabytes')") << std::endl;
+        exit(1);
+    }
+    if( _values.at(_section)->_dumpSegmentLimit > 0 && _values.at(_section)->_dumpSegmentSize > _values.at(_section)->_dumpSegmentLimit ) {
+        std::cout << tr("The dump segment size can not be larger than the total dump size") << std::endl;
+        exit(1);
+    }
+
+    // Seeking requires a memory mapped file input
+    if( _values.at(_section)->_inputSeek > 0 && !_values.at(_section)->_memoryMappedInput ) {
+        std::cout << tr("Setting the input start position requires memory mapped file input ('-mm')") << std::endl;
+        exit(1);
+    }
+
+    // Batch mode requires a file as input and as output
+    if( _values.at(_section)->_batchMode ) {
+        if( _values.at(_section)->_inputSourceType != PCM_FILE && _values.at(_section)->_inputSourceType != WAV_FILE ) {
+            std::cout << tr("Batch mode requires a pcm or wav file as input ('-i PCM filename' or '-i WAV filename')") << std::endl;
+            exit(1);
+        }
+        if( _values.at(_section)->_outputFilename == "" ) {
+            std::cout << tr("Batch mode requires an output file ('-o filename')") << std::endl;
+            exit(1);
+        }
     }
 
     // Sanitize sample rate
@@ -904,9 +1315,25 @@ void ConfigOptions::DumpConfigInfo() {
     // Remote/local
     if( _values.at(_section)->_useRemoteHead ) {
         std::cout << "Receiver for remote head with dataport " << _values.at(_section)->_remoteDataPort << " and commandport " << _values.at(_section)->_remoteCommandPort << std::endl;
+        if( _values.at(_section)->_remoteClients > 1 ) {
+            std::cout << "Serving " << _values.at(_section)->_remoteClients << " remote heads on the following port pairs" << std::endl;
+            for( int client = 0; client < _values.at(_section)->_remoteClients; client++ ) {
+                std::cout << "    head " << client << ": dataport " << _values.at(_section)->_remoteDataPort + (2 * client)
+                          << " and commandport " << _values.at(_section)->_remoteCommandPort + (2 * client) << std::endl;
+            }
+        }
     } else if( _values.at(_section)->_isRemoteHead) {
         std::cout << "Head for remote receiver on " << _values.at(_section)->_remoteServer << " with dataport " << _values.at(_section)->_remoteDataPort << " and commandport " << _values.at(_section)->_remoteCommandPort << std::endl;
     }
+    if( _values.at(_section)->_udpTransport ) {
+        std::cout << "Sending samples over UDP with a jitter buffer of " << _values.at(_section)->_jitterBufferPackets << " datagrams" << std::endl;
+    }
+    if( _values.at(_section)->_channelExtraction > 0 ) {
+        std::cout << "Extracting " << _values.at(_section)->_channelExtraction << " Hz channel on the remote input server" << std::endl;
+    }
+    if( _values.at(_section)->_wireFormat != NO_WIRE ) {
+        std::cout << "Using framed wire protocol with format " << BoomaWireFormat::GetName(_values.at(_section)->_wireFormat) << std::endl;
+    }
 
     // Input
     switch( _values.at(_section)->_inputSourceType ) {
@@ -925,6 +1352,9 @@ void ConfigOptions::DumpConfigInfo() {
         case WAV_FILE:
             std::cout << "Input WAV is read from " << _values.at(_section)->_wavFile << " assuming 16 bit signed at sampling rate " << _values.at(_section)->_inputSampleRate << std::endl;
             break;
+        case BLC_FILE:
+            std::cout << "Input BLC is read from " << _values.at(_section)->_blcFile << " at sampling rate " << _values.at(_section)->_inputSampleRate << std::endl;
+            break;
         case SILENCE:
             std::cout << "Input is total silence" << std::endl;
             break;
@@ -934,6 +1364,7 @@ void ConfigOptions::DumpConfigInfo() {
                 case SIGNAL_GENERATOR:
                 case PCM_FILE:
                 case WAV_FILE:
+                case BLC_FILE:
                 case SILENCE:
                     std::cout << "Remote input is either an audio device, signalgenerator, pcm- or wavfile, or just silence." << std::endl;
                     std::cout << "Remote input is running in REAL input mode at samplerate " << _values.at(_section)->_inputSampleRate << std::endl;
@@ -993,6 +1424,9 @@ void ConfigOptions::DumpConfigInfo() {
                 std::cout << "Decimator gain set to " << _values.at(_section)->_decimatorGain << std::endl;
             }
             std::cout << "FIR Decimator running with " << _values.at(_section)->_firFilterSize << " points and cutoff frequency " << GetDecimatorCutoff() << std::endl;
+            if( _values.at(_section)->_decimationPlan == HALFBAND_DECIMATION ) {
+                std::cout << "Using halfband decimator cascade before the final FIR decimator, if possible" << std::endl;
+            }
             break;
     }
 
@@ -1158,6 +1592,7 @@ bool ConfigOptions::ReadStoredConfig(std::string configname, bool isBookmark) {
                 if (name == "signalGeneratorFrequency") _values.at(_section)->_signalGeneratorFrequency = atol(value.c_str());
                 if (name == "pcmFile") _values.at(_section)->_pcmFile = value;
                 if (name == "wavFile") _values.at(_section)->_wavFile = value;
+                if (name == "blcFile") _values.at(_section)->_blcFile = value;
                 if (name == "reservedBuffers") _values.at(_section)->_reservedBuffers = atoi(value.c_str());
                 if (name == "rtlsdrAdjust") _values.at(_section)->_rtlsdrAdjust = atoi(value.c_str());
                 if (name == "shift") _values.at(_section)->_shift = atoi(value.c_str());
@@ -1260,6 +1695,7 @@ void ConfigOptions::WriteStoredConfig(std::string configname, bool isBookmark) {
             configStream << "signalGeneratorFrequency=" << _values.at((*it).first)->_signalGeneratorFrequency << std::endl;
             configStream << "pcmFile=" << _values.at((*it).first)->_pcmFile << std::endl;
             configStream << "wavFile=" << _values.at((*it).first)->_wavFile << std::endl;
+            configStream << "blcFile=" << _values.at((*it).first)->_blcFile << std::endl;
             configStream << "reservedBuffers=" << _values.at((*it).first)->_reservedBuffers << std::endl;
             configStream << "rtlsdrAdjust=" << _values.at((*it).first)->_rtlsdrAdjust << std::endl;
             configStream << "shift=" << _values.at((*it).first)->_shift << std::endl;
@@ -1,6 +1,7 @@
 #ifndef __APPLICATION_H
 #define __APPLICATION_H
 
+#include <mutex>
 #include <thread>
 
 #include <hardtapi.h>
@@ -9,9 +10,24 @@
 #include "boomainput.h"
 #include "boomareceiver.h"
 #include "boomaoutput.h"
+#include "boomachannelinput.h"
+#include "boomacwdecoder.h"
+#include "boomarttydecoder.h"
+#include "boomaskimmer.h"
+#include "boomatiming.h"
+#include "boomafilesegmentreader.h"
 #include "booma.h"
 #include "option.h"
 
+/** Result of processing a recording in batch mode */
+struct BoomaBatchReport {
+    int Segments;
+    double InputSeconds;
+    double Seconds;
+    double RealtimeFactor;
+    long OutputSamples;
+};
+
 class BoomaApplication {
 
     public:
@@ -97,6 +113,16 @@ class BoomaApplication {
             HLog("Receiver chain is halted");
         }
 
+        // Run a given number of blocks through the receiver chain, on the calling thread
+        void RunBlocks(int blocks);
+
+        // Process the input file as fast as possible, optionally in parallel segments, and write
+        // the output to the output file (batch mode only)
+        bool GetBatchMode() {
+            return _opts->GetBatchMode();
+        }
+        bool RunBatch(BoomaBatchReport* report);
+
         // Wait for the receiver chain to exit
         void Wait() {
             HLog("Waiting for active receiver chain to halt");
@@ -145,6 +171,10 @@ class BoomaApplication {
         bool ToggleDumpRf();
 
         bool GetDumpAudio();
+        bool Capture(int seconds);
+        void StopCapture();
+        bool IsCapturing();
+        int GetCaptureSeconds();
         bool ToggleDumpAudio();
 
         int GetRfGain();
@@ -177,6 +207,8 @@ class BoomaApplication {
         bool SetPcmFile(std::string filename);
         std::string GetWavFile();
         bool SetWavFile(std::string filename);
+        std::string GetBlcFile();
+        bool SetBlcFile(std::string filename);
         int GetSignalGeneratorFrequency();
         bool SetSignalGeneratorFrequency(int frequency);
         std::string GetRemoteServer();
@@ -199,6 +231,28 @@ class BoomaApplication {
         int GetAudioFftSize();
         int GetAudioSpectrum(double* spectrum);
 
+        // Input ring buffer reporting
+        unsigned long GetInputOverflows();
+        unsigned long GetInputUnderruns();
+
+        // Position in memory mapped file input, in seconds
+        bool SeekInput(double seconds);
+        double GetInputPosition();
+
+        // Pipeline reporting
+        std::vector<BoomaPipelineStatistics> GetPipelineStatistics();
+        void ResetPipelineStatistics();
+
+        // Stage timing reporting
+        bool GetStageTiming();
+        std::vector<BoomaStageStatistics> GetStageStatistics();
+        void ResetStageStatistics();
+        std::vector<BoomaAsyncWriterStatistics> GetDumpStatistics();
+
+        // Remote stream reporting
+        std::vector<BoomaRemoteStatistics> GetRemoteStatistics();
+        int GetRemoteStatisticsInterval();
+
         // Schedule
         HTimer GetSchedule();
 
@@ -233,6 +287,26 @@ class BoomaApplication {
         bool RemoveChannel(int id);
         bool UseChannel(int id);
 
+        // Additional receiver channels decoded from the same input stream
+        int GetReceiverChannelCount();
+        std::string GetReceiverChannelName(int channel);
+        long int GetReceiverChannelFrequency(int channel);
+        bool IsReceiverChannelActive(int channel);
+        int GetReceiverChannelSignalLevel(int channel);
+        bool SetReceiverChannelOption(int channel, std::string name, std::string value);
+        std::string GetReceiverChannelOptionInfoString(int channel);
+
+        // Decoded text, returns the text decoded since the last call
+        bool HasDecoder();
+        std::string GetDecodedText();
+        int GetDecoderWpm();
+        std::string GetReceiverChannelDecodedText(int channel);
+        int GetReceiverChannelDecoderWpm(int channel);
+
+        // Skimmer
+        bool HasSkimmer();
+        std::vector<BoomaSkimmerSpot> GetSkimmerSpots();
+
         // Config sections
         std::vector<std::string> GetConfigSections();
         std::string GetConfigSection();
@@ -257,6 +331,22 @@ class BoomaApplication {
         BoomaReceiver* _receiver;
         BoomaOutput* _output;
 
+        // Additional receiver channels
+        std::vector<BoomaChannelInput*> _channelInputs;
+        std::vector<BoomaReceiver*> _channelReceivers;
+        std::vector<BoomaOutput*> _channelOutputs;
+        std::vector<bool> _channelActive;
+
+        // Decoders for the receiver and the receiver channels, and the text not yet fetched
+        BoomaDecoder* _decoder;
+        std::vector<BoomaDecoder*> _channelDecoders;
+        std::mutex _decodedTextMutex;
+        std::string _decodedText;
+        std::vector<std::string> _channelDecodedText;
+
+        // Skimmer decoding all CW signals in the input passband
+        BoomaSkimmer* _skimmer;
+
         // Disable copy constructor usage since that would
         // create multiple instances of the application core!
         BoomaApplication(const BoomaApplication&);
@@ -264,6 +354,16 @@ class BoomaApplication {
 
         // Reconfigure the entire receiver
         bool Reconfigure();
+
+        // Receiver and channel creation
+        BoomaReceiver* CreateReceiver(int frequency);
+        BoomaDecoder* CreateDecoder(int channel);
+        void AddDecodedText(std::string* text, std::string decoded);
+        bool InitializeReceiverChannels();
+        void DeleteReceiverChannels();
+
+        // Batch processing
+        bool MergeBatchSegments(std::vector<std::string> filenames, std::vector<double> overlaps, long* samples);
 };
 
 #endif
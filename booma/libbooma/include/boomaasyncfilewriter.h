@@ -0,0 +1,48 @@
+#ifndef __ASYNCFILEWRITER_H
+#define __ASYNCFILEWRITER_H
+
+#include <hardtapi.h>
+
+#include "boomaasyncwriter.h"
+
+/**
+ * Write samples to a single pcm or wav file from a background thread.
+ * The file is created when the first samples are written.
+ */
+class BoomaAsyncFileWriter : public BoomaAsyncWriter {
+
+    private:
+
+        std::string _filename;
+        bool _isWav;
+        int _samplerate;
+        int _fd;
+        off_t _size;
+        off_t _synced;
+        bool _isFailed;
+
+        bool Open();
+
+    protected:
+
+        void WriteBuffer(int16_t* samples, size_t length);
+        void Close();
+
+    public:
+
+        /**
+         * Construct a new asynchronous file writer
+         *
+         * @param id Id of this writer
+         * @param filename Name of the pcm or wav file
+         * @param isWav Write a wav file, otherwise a raw pcm file
+         * @param samplerate Samplerate, stored in the wav header
+         * @param previous Writer consumer to attach to, or nullptr when the owner calls Write() itself
+         * @param isBlocking Wait for the disk instead of dropping samples
+         * @param buffers Number of 1MB buffers that can be queued for writing
+         */
+        BoomaAsyncFileWriter(std::string id, std::string filename, bool isWav, int samplerate, HWriterConsumer<int16_t>* previous, bool isBlocking = false, int buffers = 16);
+        ~BoomaAsyncFileWriter();
+};
+
+#endif
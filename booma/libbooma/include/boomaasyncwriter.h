@@ -0,0 +1,128 @@
+#ifndef __ASYNCWRITER_H
+#define __ASYNCWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <ctime>
+#include <sys/types.h>
+
+#include <hardtapi.h>
+
+/** Counters for an asynchronous dump writer */
+struct BoomaAsyncWriterStatistics {
+    std::string Name;
+    unsigned long QueuedBytes;
+    unsigned long WrittenBytes;
+    unsigned long DroppedSamples;
+    unsigned long Writes;
+    double AverageLatency;
+    double MaxLatency;
+    std::string Segment;
+};
+
+/**
+ * Base class for writers that moves all file io off the processing thread.
+ *
+ * Samples are collected in large page aligned buffers. Full buffers are handed to a background
+ * thread that writes them with WriteBuffer(), so that a write never blocks the processing chain.
+ * If the disk can not keep up and all buffers are in use, incoming samples are dropped and counted
+ * instead of stalling the receiver, unless the writer is blocking (used when processing files,
+ * where nothing is gained by dropping samples).
+ *
+ * Subclasses must call Stop() in their destructor, so that the last samples are written and Close()
+ * is called before the subclass is destroyed.
+ */
+class BoomaAsyncWriter : public HWriter<int16_t> {
+
+    private:
+
+        int _buffers;
+        bool _isBlocking;
+        time_t _started;
+
+        // Staging buffer filled by Write()
+        int16_t* _current;
+        size_t _currentLength;
+
+        // Buffers waiting to be written, and buffers ready for reuse
+        std::deque<std::pair<int16_t*, size_t>> _queue;
+        std::deque<int16_t*> _free;
+        int _allocated;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _available;
+        std::thread* _thread;
+        bool _isRunning;
+
+        // Counters, guarded by _mutex
+        unsigned long _queuedBytes;
+        unsigned long _writtenBytes;
+        unsigned long _droppedSamples;
+        std::string _segment;
+        unsigned long _writes;
+        double _totalLatency;
+        double _maxLatency;
+
+        void WorkerThread();
+        void StopWorker();
+        void Flush();
+
+    protected:
+
+        /**
+         * Construct a new asynchronous writer
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to, or nullptr when the owner calls Write() itself
+         * @param buffers Number of 1MB buffers that can be queued for writing
+         * @param isBlocking Wait for a free buffer instead of dropping samples
+         */
+        BoomaAsyncWriter(std::string id, HWriterConsumer<int16_t>* previous, int buffers, bool isBlocking);
+
+        /** Write a buffer of samples, called on the writer thread */
+        virtual void WriteBuffer(int16_t* samples, size_t length) = 0;
+
+        /** Close the output, called when the writer thread has written all queued samples */
+        virtual void Close() = 0;
+
+        /** Time when the first sample was written */
+        time_t GetStarted() {
+            return _started;
+        }
+
+        /** Write all bytes to the file, retrying partial writes */
+        bool WriteFully(int fd, const void* data, size_t bytes);
+
+        /** Name of the file currently written, reported with the statistics of segmented writers */
+        void SetSegment(std::string segment);
+
+        /** Number of samples dropped since the writer was created */
+        unsigned long GetDroppedSamples();
+
+        /** Start writeback of everything written since the last call, so that dirty pages never pile up */
+        void StartWriteback(int fd, off_t* synced, off_t size);
+
+    public:
+
+        static const int WavHeaderSize = 44;
+
+        /** Create a wav header for a single channel of 16 bit samples */
+        static void CreateWavHeader(uint8_t* header, int rate, long samples);
+
+        virtual ~BoomaAsyncWriter();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        void GetStatistics(BoomaAsyncWriterStatistics* statistics);
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __BIQUADDESIGNER_H
+#define __BIQUADDESIGNER_H
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+/**
+ * Design cascaded biquad bandpass filters for a HCascadedBiQuadFilter.
+ *
+ * The filter is a Butterworth bandpass with a 4. order prototype, giving 4 biquad sections
+ * of b0, b1, b2, a1, a2 (with a1 and a2 negated, as expected by Hardt). The band edges
+ * are prewarped before the bilinear transform, so the passband is correct at any samplerate.
+ *
+ * Each section is scaled to unity gain at the center of the passband, so that no
+ * intermediate section overflows.
+ *
+ * Designs are cached, keyed by center, width and samplerate, so changing between a few
+ * settings does not redesign the filter each time.
+ */
+class BoomaBiQuadDesigner {
+
+    private:
+
+        static std::mutex _mutex;
+        static std::map<std::tuple<int, int, int>, std::vector<float>> _designs;
+
+        static void Design(int center, int width, int rate, std::vector<float>* coefficients);
+
+    public:
+
+        static const int Sections = 4;
+        static const int Coefficients = Sections * 5;
+
+        /**
+         * Get the coefficients for a bandpass filter
+         *
+         * @param center Center of the passband
+         * @param width Width of the passband, narrowed if the passband does not fit between 0 and rate/2
+         * @param rate Samplerate
+         * @return Coefficients (Coefficients values). The design is owned by the cache and is never released
+         */
+        static float* GetBandpass(int center, int width, int rate);
+};
+
+#endif
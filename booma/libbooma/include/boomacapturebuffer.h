@@ -0,0 +1,102 @@
+#ifndef __CAPTUREBUFFER_H
+#define __CAPTUREBUFFER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <ctime>
+
+#include <hardtapi.h>
+
+#include "boomaasyncfilewriter.h"
+
+/**
+ * Keep the last n seconds of samples in memory, so that an event can be saved after it has been noticed.
+ *
+ * Samples are kept in one preallocated ring, with room for a little more than the requested history.
+ * The capture thread lives as long as the buffer. When a capture is started, it copies the buffered
+ * samples out of the ring, oldest first, followed by the samples received after the trigger, until
+ * the requested amount of time after the trigger has passed. The ring is never cleared, so the
+ * history is intact for the next capture.
+ *
+ * The processing thread never waits for the disk. The capture thread copies the samples in chunks
+ * and hands them to a BoomaAsyncFileWriter, the extra room in the ring gives it time to stay ahead of
+ * the processing thread. Should it fall more than that behind, the overwritten samples are skipped
+ * and logged.
+ */
+class BoomaCaptureBuffer : public HWriter<int16_t> {
+
+    private:
+
+        std::string _prefix;
+        int _samplerate;
+        int _channels;
+        size_t _size;
+
+        // Ring holding the history and the extra room, and the number of samples ever written to it
+        int16_t* _ring;
+        size_t _capacity;
+        uint64_t _written;
+
+        // Capture thread, waiting for a capture to be requested. A capture starts at the sample
+        // numbered _first and ends when the written sample count reaches _end
+        std::mutex _mutex;
+        std::condition_variable _arrived;
+        std::thread* _captureThread;
+        bool _isCapturing;
+        bool _isStopping;
+        uint64_t _first;
+        uint64_t _end;
+        std::string _filename;
+
+        void CaptureThread();
+        void WriteCapture(std::string filename, uint64_t first);
+
+    public:
+
+        /**
+         * Construct a new capture buffer
+         *
+         * @param id Id of this writer
+         * @param prefix Filename prefix for captures
+         * @param seconds Number of seconds to keep in the buffer
+         * @param samplerate Samplerate
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param previous Writer consumer to attach to
+         */
+        BoomaCaptureBuffer(std::string id, std::string prefix, int seconds, int samplerate, int channels, HWriterConsumer<int16_t>* previous);
+        ~BoomaCaptureBuffer();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /**
+         * Write the buffered samples and the following samples to a new file
+         *
+         * @param seconds Number of seconds to keep writing after the buffered samples, or -1 to write until StopCapture()
+         * @return False if a capture is already running
+         */
+        bool Capture(int seconds);
+
+        /** End a running capture now */
+        void StopCapture();
+
+        bool IsCapturing();
+
+        /** Name of the file written by the last capture */
+        std::string GetFilename();
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __CHANNELEXTRACTOR_H
+#define __CHANNELEXTRACTOR_H
+
+#include <hardtapi.h>
+
+#include "boomafirdecimator.h"
+#include "boomaoscillator.h"
+
+/**
+ * Extract a narrow channel from an IQ stream, for a remote input server.
+ *
+ * Set-frequency commands from the remote head selects the center of the channel. When the
+ * channel is inside the span already received by the device, the channel is moved by mixing
+ * and the device is left alone, so the stream continues without interruption. Otherwise the
+ * device is retuned to the channel frequency minus the usual rtl-sdr offset, so that the channel
+ * stays clear of the dc spike, and the channel is mixed down from the offset.
+ *
+ * Commands arrive on another thread than the reads, the mixer takes a new frequency at the next
+ * block, see BoomaOscillator.
+ *
+ * The channel is lowpass filtered and decimated to a samplerate equal to its width. The remote
+ * head restores the original samplerate with a BoomaChannelReconstructor.
+ */
+class BoomaChannelExtractor : public HReader<int16_t> {
+
+    private:
+
+        /** Reads from the device and shifts the channel center to 0Hz */
+        class ChannelMixer : public HReader<int16_t> {
+
+            public:
+
+                HReader<int16_t>* Reader;
+                BoomaOscillator Oscillator;
+
+                ChannelMixer(std::string id, HReader<int16_t>* reader):
+                    HReader<int16_t>(id),
+                    Reader(reader) {}
+
+                int Read(int16_t* dest, size_t blocksize) {
+                    int length = Reader->Read(dest, blocksize);
+                    if( length > 0 ) {
+                        Oscillator.Mix(dest, length);
+                    }
+                    return length;
+                }
+
+                bool Start() {
+                    return Reader->Start();
+                }
+
+                bool Stop() {
+                    return Reader->Stop();
+                }
+
+                bool Command(HCommand* command) {
+                    return Reader->Command(command);
+                }
+        };
+
+        int _samplerate;
+        int _width;
+        int _span;
+        int _center;
+        int _offset;
+        bool _isRetuneAllowed;
+        ChannelMixer* _mixer;
+        BoomaFirDecimator* _decimator;
+
+    public:
+
+        /**
+         * Construct a new channel extractor
+         *
+         * @param id Id of this reader
+         * @param reader Reader with interleaved IQ samples
+         * @param samplerate Samplerate of the input
+         * @param width Width of the channel, this is also the output samplerate
+         * @param span Largest usable offset from the device center frequency
+         * @param center Initial center frequency of the device
+         * @param offset Distance from the device center frequency to the channel when retuning
+         * @param blocksize Blocksize
+         * @param isRetuneAllowed If false, channels outside the span are rejected instead of retuning a shared device
+         */
+        BoomaChannelExtractor(std::string id, HReader<int16_t>* reader, int samplerate, int width, int span, int center, int offset, size_t blocksize, bool isRetuneAllowed = true);
+        ~BoomaChannelExtractor();
+
+        int Read(int16_t* dest, size_t blocksize) {
+            return _decimator->Read(dest, blocksize);
+        }
+
+        bool Start() {
+            return _decimator->Start();
+        }
+
+        bool Stop() {
+            return _decimator->Stop();
+        }
+
+        bool Command(HCommand* command);
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __CHANNELINPUT_H
+#define __CHANNELINPUT_H
+
+#include <hardtapi.h>
+#include "configoptions.h"
+#include "boomainput.h"
+#include "boomafirfilter.h"
+#include "boomaexception.h"
+#include "booma.h"
+
+/**
+ * Input for an additional receiver channel.
+ *
+ * Taps the shared, already decimated, stream from a BoomaInput and moves the
+ * channel frequency to where a receiver expects it, so that any number of
+ * receivers can run on the same input without re-reading or re-decimating samples.
+ * With a polyphase channelizer in the input, channels outside the main passband
+ * are taken from the nearest channelizer bin.
+ */
+class BoomaChannelInput {
+
+    private:
+
+        std::string _name;
+        long int _frequency;
+        int _ifFrequency;
+        int _bin;
+
+        // Moving the channel to the center of the IQ spectrum
+        HIqMultiplier<int16_t>* _channelMultiplier;
+
+        // Channel filtering
+        BoomaFirFilter* _channelIqFirFilter;
+        BoomaFirFilter* _channelFirFilter;
+
+        // Final consumer
+        HWriterConsumer<int16_t>* _lastConsumer;
+
+        bool IsLocalInput(ConfigOptions* opts);
+        int GetChannelOffset(ConfigOptions* opts, BoomaInput* input);
+
+    public:
+
+        class BoomaChannelInputException : public BoomaException {
+
+            public:
+
+                BoomaChannelInputException(std::string reason) : BoomaException(reason) {}
+                std::string Type() { return "BoomaChannelInputException"; }
+        };
+
+        BoomaChannelInput(ConfigOptions* opts, BoomaInput* input, std::string name, long int frequency);
+        ~BoomaChannelInput();
+
+        HWriterConsumer<int16_t>* GetLastWriterConsumer() {
+            return _lastConsumer;
+        }
+
+        std::string GetName() {
+            return _name;
+        }
+
+        long int GetFrequency() {
+            return _frequency;
+        }
+
+        int GetIfFrequency() {
+            return _ifFrequency;
+        }
+
+        bool IsFrequencySupported(ConfigOptions* opts, BoomaInput* input);
+
+        bool SetFrequency(ConfigOptions* opts, BoomaInput* input);
+
+        bool SetInputFilterWidth(ConfigOptions* opts, int width);
+};
+
+#endif
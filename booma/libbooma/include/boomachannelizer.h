@@ -0,0 +1,83 @@
+#ifndef __CHANNELIZER_H
+#define __CHANNELIZER_H
+
+#include <complex>
+#include <vector>
+
+#include <hardtapi.h>
+#include "boomafft.h"
+#include "booma.h"
+
+/**
+ * Critically sampled polyphase analysis filterbank for IQ samples.
+ *
+ * Splits the input spectrum into M evenly spaced channels, each decimated by M, in one
+ * pass: every output sample costs one polyphase filter pass (M * taps-per-phase multiplications)
+ * and one M-point FFT, shared by all channels. Channel 0 (centered at 0Hz) is returned by Read(),
+ * all other channels are written to the writers attached to GetChannel(bin).
+ *
+ * Bin k is centered at k * (inputRate / M) for k <= (M - 1) / 2 and at (k - M) * (inputRate / M) above.
+ */
+class BoomaChannelizer : public HReader<int16_t> {
+
+    private:
+
+        class ChannelConsumer : public HWriterConsumer<int16_t> {
+
+            public:
+
+                HWriter<int16_t>* Writer;
+
+                ChannelConsumer():
+                    Writer(nullptr) {}
+
+                void SetWriter(HWriter<int16_t>* writer) {
+                    Writer = writer;
+                }
+        };
+
+        HReader<int16_t>* _reader;
+        int _channels;
+        int _tapsPerPhase;
+        int _length;
+        size_t _blocksize;
+
+        // Prototype lowpass filter and the input buffer (history + one block) for I and Q
+        std::vector<float> _coefficients;
+        std::vector<float> _i;
+        std::vector<float> _q;
+
+        // Input block, polyphase filter outputs and channel outputs
+        int16_t* _input;
+        std::vector<std::complex<float>> _phases;
+        std::vector<std::complex<float>> _bins;
+        BoomaFft _fft;
+
+        // Output buffers and consumers for channels other than 0
+        std::vector<ChannelConsumer*> _consumers;
+        std::vector<int16_t*> _outputs;
+
+        static float Bessel(float x);
+
+    public:
+
+        BoomaChannelizer(std::string id, HReader<int16_t>* reader, int channels, int inputRate, int cutoff, int tapsPerPhase, size_t blocksize);
+        ~BoomaChannelizer();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+
+        HWriterConsumer<int16_t>* GetChannel(int bin);
+
+        int GetChannels() {
+            return _channels;
+        }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef __CHANNELRECONSTRUCTOR_H
+#define __CHANNELRECONSTRUCTOR_H
+
+#include <hardtapi.h>
+
+#include "boomafirinterpolator.h"
+#include "boomaoscillator.h"
+
+/**
+ * Restore the samplerate of a channel extracted by a remote input server, see BoomaChannelExtractor.
+ *
+ * The channel is interpolated as IQ samples by a BoomaFirInterpolator and shifted up to the
+ * position where the receiver expects the signal, so that the rest of the chain sees the same
+ * stream as it would have received without channel extraction.
+ */
+class BoomaChannelReconstructor : public BoomaFirInterpolator {
+
+    private:
+
+        int _samplerate;
+        BoomaOscillator _oscillator;
+
+    protected:
+
+        void WriteBlock(int16_t* src, size_t blocksize);
+
+    public:
+
+        /**
+         * Construct a new channel reconstructor
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to
+         * @param width Samplerate of the extracted channel
+         * @param samplerate Samplerate to restore
+         * @param blocksize Number of samples written to the next writer at a time
+         */
+        BoomaChannelReconstructor(std::string id, HWriterConsumer<int16_t>* previous, int width, int samplerate, size_t blocksize);
+
+        /** Position of the channel center in the restored stream */
+        void SetShift(int frequency) {
+            _oscillator.SetFrequency(frequency, _samplerate);
+        }
+};
+
+#endif
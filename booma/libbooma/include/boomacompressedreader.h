@@ -0,0 +1,63 @@
+#ifndef __COMPRESSEDREADER_H
+#define __COMPRESSEDREADER_H
+
+#include <stdio.h>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomalosslesscodec.h"
+
+/**
+ * Read samples from a losslessly compressed BLC file, as written by BoomaCompressedWriter.
+ * The last block is padded with zeros. The channels and samplerate in the file header must
+ * match the expected values, otherwise a BoomaInputException is thrown.
+ */
+class BoomaCompressedReader : public HReader<int16_t> {
+
+    private:
+
+        FILE* _file;
+        int _channels;
+        int _samplerate;
+        std::vector<int16_t> _samples;
+        size_t _position;
+        bool _isEndOfFile;
+
+    public:
+
+        /**
+         * Construct a new compressed file reader
+         *
+         * @param id Id of this reader
+         * @param filename BLC file to read
+         * @param channels Expected number of interleaved channels
+         * @param samplerate Expected samplerate
+         */
+        BoomaCompressedReader(std::string id, std::string filename, int channels, int samplerate);
+        ~BoomaCompressedReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        int GetChannels() {
+            return _channels;
+        }
+
+        int GetSamplerate() {
+            return _samplerate;
+        }
+};
+
+#endif
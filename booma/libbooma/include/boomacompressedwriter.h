@@ -0,0 +1,72 @@
+#ifndef __COMPRESSEDWRITER_H
+#define __COMPRESSEDWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomalosslesscodec.h"
+
+/**
+ * Write samples to a losslessly compressed BLC file.
+ *
+ * Blocks are copied into a bounded queue and compressed and written by a background thread, so
+ * that the processing chain only pays for the copy. When the queue is full the writing thread
+ * waits, no samples are ever dropped. The file is created when the first block is written.
+ */
+class BoomaCompressedWriter : public HWriter<int16_t> {
+
+    private:
+
+        std::string _filename;
+        int _channels;
+        int _samplerate;
+        int _depth;
+        FILE* _file;
+
+        std::deque<std::vector<int16_t>> _queue;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+        std::thread* _thread;
+        bool _isRunning;
+
+        unsigned long _samples;
+        unsigned long _bytes;
+
+        void WorkerThread();
+        void StopWorker();
+
+    public:
+
+        /**
+         * Construct a new compressed writer
+         *
+         * @param id Id of this writer
+         * @param filename Name of the BLC file
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param samplerate Samplerate, stored in the file header
+         * @param previous Writer consumer to attach to
+         * @param depth Number of blocks that can be queued for compression
+         */
+        BoomaCompressedWriter(std::string id, std::string filename, int channels, int samplerate, HWriterConsumer<int16_t>* previous, int depth = 64);
+        ~BoomaCompressedWriter();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /** Compressed size relative to the uncompressed size */
+        double GetCompressionRatio();
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef __CWDECODER_H
+#define __CWDECODER_H
+
+#include <functional>
+#include <string>
+
+#include <hardtapi.h>
+
+#include "boomadecoder.h"
+
+/**
+ * Decode morse from the audio output of a CW receiver.
+ *
+ * The rectified signal is averaged over short ticks (2 ms), which is all that is done per
+ * sample, so that a decoder can run on every channel of a receiver. Everything else runs once
+ * per tick, and can also be given the level of a signal directly (see BoomaSkimmer): The
+ * envelope is compared to a threshold halfway between the tracked signal and noise levels
+ * (with some hysteresis), and the length of marks and spaces is used to find dots, dashes
+ * and the gaps between characters and words. The length of a dot follows the
+ * incomming signal, so the decoder adapts to the speed of the sender.
+ *
+ * Decoded characters, and a space at the end of each word, is given to the callback as they
+ * are found. The callback runs on the thread that writes to the decoder.
+ */
+class BoomaCwDecoder : public BoomaDecoder {
+
+    private:
+
+        std::function<void(std::string)> _callback;
+
+        // Envelope, averaged over one tick
+        int _tickLength;
+        int _tickSamples;
+        long _tickSum;
+        float _envelope;
+
+        // Signal and noise levels
+        float _signal;
+        float _noise;
+
+        // Length of the current and the previous (unprocessed) state, in ticks
+        bool _isMark;
+        int _ticks;
+        int _previous;
+
+        // Length of a dot in ticks, and of the last mark
+        float _dot;
+        int _lastMark;
+
+        // Current character as a position in the morse tree, and if a word has been started
+        int _symbol;
+        bool _isWord;
+
+        void Track(bool isMark);
+        void AddElement(int length);
+        void Emit(std::string text);
+
+        static const std::string& GetAlphabet();
+
+    protected:
+
+        void Decode(int16_t* src, int blocksize);
+
+    public:
+
+        /**
+         * Construct a new CW decoder
+         *
+         * @param id Id of this writer
+         * @param samplerate Samplerate of the decoded signal
+         * @param callback Function receiving the decoded text
+         */
+        BoomaCwDecoder(std::string id, int samplerate, std::function<void(std::string)> callback);
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /** Add the level of the signal for one tick, when the decoder is not used as a writer */
+        void Tick(float level);
+
+        /** Forget the current signal, speed and character. Optionally start with a known noise level */
+        void Reset(float noise = 0);
+
+        /** Estimated speed of the decoded signal, in words per minute */
+        int GetWpm();
+
+        /** Signal to noise ratio, in dB */
+        int GetSnr();
+
+        /** Time since the key was last down */
+        int GetIdleMilliseconds();
+};
+
+#endif
@@ -1,12 +1,17 @@
 #ifndef __CWRECEIVER_H
 #define __CWRECEIVER_H
 
+#include <algorithm>
+
 #include <hardtapi.h>
 
 #include "booma.h"
 #include "configoptions.h"
 #include "boomareceiver.h"
 #include "boomainput.h"
+#include "boomabiquaddesigner.h"
+#include "boomaifdecimator.h"
+#include "boomafirinterpolator.h"
 
 class BoomaCwReceiver : public BoomaReceiver {
 
@@ -25,12 +30,32 @@ class BoomaCwReceiver : public BoomaReceiver {
         HMultiplier<int16_t>* _beatToneMixer;
         HCascadedBiQuadFilter<int16_t>* _postSelect;
 
+        // Optional low rate path, the narrow filters and the beattone mixer runs at the internal rate
+        BoomaIfDecimator* _ifDecimator;
+        BoomaFirInterpolator* _interpolator;
+        int _internalRate;
+        int _internalIf;
+
         // Postprocessing
         // ...(empty)...
 
-        static float _bandpassCoeffs[6][20];
         static int _bandpassWidths[];
-        static float _cwCoeffs[];
+
+        int GetIfFrequency(ConfigOptions* opts) {
+            // 6KHz when the samplerate allows it, otherwise a quarter of the samplerate
+            return std::min(6000, opts->GetOutputSampleRate() / 4);
+        }
+
+        float* GetIfCoefficients() {
+            return BoomaBiQuadDesigner::GetBandpass(_internalIf, _bandpassWidths[GetOption("Bandwidth")], _internalRate);
+        }
+
+        float* GetOutputCoefficients() {
+            // 400Hz around 1KHz, covering all beattones
+            return BoomaBiQuadDesigner::GetBandpass(1000, 400, _internalRate);
+        }
+
+        int GetLowRateFactor(ConfigOptions* opts);
 
         bool IsDataTypeSupported(InputSourceDataType datatype) {
             switch( datatype ) {
@@ -62,9 +87,9 @@ class BoomaCwReceiver : public BoomaReceiver {
 
         bool IsFrequencySupported(ConfigOptions* opts, long frequency) {
             if( opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ) {
-                // This receiver will not tune lower than 6KHz since we use 6KHz as
-                // the internal IF in the heterodyne mixing stage.
-                return frequency < opts->GetOutputSampleRate() / 2 && (frequency > 6000);
+                // This receiver will not tune lower than the internal IF used
+                // in the heterodyne mixing stage.
+                return frequency < opts->GetOutputSampleRate() / 2 && (frequency > GetIfFrequency(opts));
             } else {
                 // With an rtlsdr source, the frequency can be almost anything
                 return frequency >= 0;
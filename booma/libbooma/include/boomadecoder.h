@@ -16,6 +16,12 @@ class BoomaDecoder: public HWriter<int16_t> {
             return blocksize;
         }
 
+        /** Estimated speed of the decoded signal, in words per minute */
+        virtual int GetWpm() = 0;
+
+        /** Receiver option used by the decoder. Given for all options when the receiver is built, and on each change */
+        virtual void SetReceiverOption(std::string name, int value) {}
+
 };
 
 #endif
@@ -0,0 +1,121 @@
+#ifndef __FANOUT_H
+#define __FANOUT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+/**
+ * Reader for one client of a BoomaFanout.
+ *
+ * Blocks are kept in a bounded queue. When a client does not keep up, or is not
+ * connected, the oldest blocks are dropped so that the device reader never waits.
+ */
+class BoomaFanoutReader : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _source;
+        size_t _blocksize;
+
+        std::mutex _mutex;
+        std::condition_variable _available;
+        std::vector<int16_t*> _blocks;
+        std::vector<int> _lengths;
+        size_t _head;
+        size_t _count;
+        bool _isEnd;
+        bool _isDropping;
+        unsigned long _dropped;
+
+    public:
+
+        BoomaFanoutReader(std::string id, HReader<int16_t>* source, int blocks, size_t blocksize);
+        ~BoomaFanoutReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        /** Commands goes to the shared device */
+        bool Command(HCommand* command) {
+            return _source->Command(command);
+        }
+
+        /** Add a block, dropping the oldest block if the queue is full */
+        void Push(int16_t* src, int length);
+
+        /** Signal that no more blocks will be added */
+        void End();
+
+        /** Number of blocks dropped because the client did not keep up */
+        unsigned long GetDropped();
+
+        /** Number of blocks waiting in the queue */
+        unsigned long GetQueueDepth();
+};
+
+/**
+ * Share one input reader between several clients.
+ *
+ * A thread reads from the input and hands each block to all clients, each client
+ * reads from its own BoomaFanoutReader.
+ */
+class BoomaFanout {
+
+    private:
+
+        std::string _id;
+        HReader<int16_t>* _source;
+        size_t _blocksize;
+        bool* _isTerminated;
+        std::vector<BoomaFanoutReader*> _clients;
+        std::thread* _thread;
+        std::atomic<bool> _isRunning;
+
+        void ReaderThread();
+
+    public:
+
+        /**
+         * Construct a new fan-out
+         *
+         * @param id Id used for logging and for the client readers
+         * @param source Shared input reader
+         * @param blocksize Blocksize
+         * @param isTerminated Stop reading when this becomes true
+         */
+        BoomaFanout(std::string id, HReader<int16_t>* source, size_t blocksize, bool* isTerminated);
+        ~BoomaFanout();
+
+        /**
+         * Add a client
+         *
+         * @param blocks Length of the client queue in blocks
+         * @return Reader for the client, owned by the fan-out
+         */
+        BoomaFanoutReader* AddClient(int blocks);
+
+        bool Start();
+        bool Stop();
+
+        int GetClients() {
+            return _clients.size();
+        }
+
+        BoomaFanoutReader* GetClient(int client) {
+            return _clients.at(client);
+        }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef __FFT_H
+#define __FFT_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * Mixed radix FFT for any size N.
+ *
+ * Factors N into small primes (radix 2 butterflies are handled specially) so that
+ * sizes that are not a power of two, such as typical decimation factors, still
+ * transform in O(N log N).
+ */
+class BoomaFft {
+
+    private:
+
+        int _size;
+        std::vector<int> _factors;
+        std::vector<std::complex<float>> _twiddles;
+        std::vector<std::complex<float>> _scratch;
+
+        void Transform(std::complex<float>* out, const std::complex<float>* in, int fstride, int factor, bool inverse);
+        void Butterfly2(std::complex<float>* out, int fstride, int m, bool inverse);
+        void ButterflyGeneric(std::complex<float>* out, int fstride, int p, int m, bool inverse);
+
+        std::complex<float> Twiddle(int index, bool inverse) {
+            return inverse ? std::conj(_twiddles[index]) : _twiddles[index];
+        }
+
+    public:
+
+        BoomaFft(int size);
+
+        /** Calculate X[k] = sum x[n] * exp(-j*2*pi*k*n/N) */
+        void Forward(const std::complex<float>* in, std::complex<float>* out);
+
+        /** Calculate x[n] = sum X[k] * exp(+j*2*pi*k*n/N), unscaled */
+        void Inverse(const std::complex<float>* in, std::complex<float>* out);
+
+        int GetSize() {
+            return _size;
+        }
+};
+
+#endif
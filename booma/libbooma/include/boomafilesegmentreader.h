@@ -0,0 +1,60 @@
+#ifndef __FILESEGMENTREADER_H
+#define __FILESEGMENTREADER_H
+
+#include <stdio.h>
+
+#include <hardtapi.h>
+
+/**
+ * Read a segment of the samples in a pcm or wav file.
+ *
+ * Used when processing a recording in batch mode, where the file is split into segments that
+ * are processed in parallel. The last block of a segment is padded with zeros.
+ */
+class BoomaFileSegmentReader : public HReader<int16_t> {
+
+    private:
+
+        FILE* _file;
+        long _remaining;
+
+    public:
+
+        /**
+         * Construct a new segment reader
+         *
+         * @param id Id of this reader
+         * @param filename Name of the pcm or wav file
+         * @param offset Byte offset of the first sample in the segment
+         * @param length Number of samples in the segment
+         */
+        BoomaFileSegmentReader(std::string id, std::string filename, long offset, long length);
+        ~BoomaFileSegmentReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /**
+         * Get the byte offset of the first sample and the number of samples in a pcm or wav file
+         *
+         * @param filename Name of the pcm or wav file
+         * @param isWav The file is a wav file
+         * @param offset Byte offset of the first sample
+         * @param length Number of samples
+         * @return True if the file could be read
+         */
+        static bool GetLayout(std::string filename, bool isWav, long* offset, long* length);
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __FIRDECIMATOR_H
+#define __FIRDECIMATOR_H
+
+#include <vector>
+
+#include <hardtapi.h>
+#include "boomafirkernel.h"
+
+/**
+ * Decimating FIR filter for realvalued or interleaved IQ samples, using the cpu dispatched BoomaFirKernel.
+ *
+ * Only the samples that are kept are calculated. The decimation phase is carried across input
+ * blocks, so the factor does not have to divide the blocksize.
+ */
+class BoomaFirDecimator : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        BoomaFirKernel _kernel;
+        int _factor;
+        bool _isIq;
+        size_t _blocksize;
+
+        // Input block and history followed by the deinterleaved input, for I (or realvalued samples) and Q
+        int16_t* _input;
+        std::vector<int16_t> _i;
+        std::vector<int16_t> _q;
+        int _available;
+        int _next;
+
+        bool ReadInput();
+
+    public:
+
+        BoomaFirDecimator(std::string id, HReader<int16_t>* reader, int factor, float* coefficients, int length, size_t blocksize, bool isIq = false);
+        ~BoomaFirDecimator();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return _reader->Start();
+        }
+
+        bool Stop() {
+            return _reader->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+};
+
+#endif
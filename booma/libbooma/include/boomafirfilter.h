@@ -0,0 +1,40 @@
+#ifndef __FIRFILTER_H
+#define __FIRFILTER_H
+
+#include <mutex>
+#include <vector>
+
+#include <hardtapi.h>
+#include "boomafirkernel.h"
+
+/**
+ * FIR filter for realvalued or interleaved IQ samples, using the cpu dispatched BoomaFirKernel.
+ *
+ * IQ samples are filtered as two separate realvalued streams with the same coefficients.
+ */
+class BoomaFirFilter : public HFilter<int16_t> {
+
+    private:
+
+        BoomaFirKernel _kernel;
+        bool _isIq;
+        std::mutex _mutex;
+
+        // History followed by the current block, for I (or realvalued samples) and Q
+        std::vector<int16_t> _i;
+        std::vector<int16_t> _q;
+
+        void Init();
+
+    public:
+
+        BoomaFirFilter(std::string id, HWriter<int16_t>* writer, float* coefficients, int length, size_t blocksize, bool isIq = false);
+        BoomaFirFilter(std::string id, HWriterConsumer<int16_t>* consumer, float* coefficients, int length, size_t blocksize, bool isIq = false);
+        BoomaFirFilter(std::string id, HReader<int16_t>* reader, float* coefficients, int length, size_t blocksize, bool isIq = false);
+
+        void Filter(int16_t* src, int16_t* dest, size_t blocksize);
+
+        void SetCoefficients(float* coefficients, int length);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __FIRINTERPOLATOR_H
+#define __FIRINTERPOLATOR_H
+
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomafirkernel.h"
+
+/**
+ * Interpolating FIR filter, using one BoomaFirKernel per output phase.
+ *
+ * Realvalued samples (1 channel) and interleaved IQ samples (2 channels) are interpolated
+ * with the same kernels. Input blocks may have any size, the output is written in whole blocks.
+ */
+class BoomaFirInterpolator : public HWriter<int16_t>, public HWriterConsumer<int16_t> {
+
+    private:
+
+        HWriter<int16_t>* _writer;
+        int _factor;
+        int _channels;
+        size_t _blocksize;
+
+        // One kernel per output phase, the input history for each channel and the output not yet written
+        std::vector<BoomaFirKernel*> _phases;
+        std::vector<std::vector<int16_t>> _input;
+        std::vector<int16_t> _output;
+
+    protected:
+
+        /** Write one whole block of output to the next writer */
+        virtual void WriteBlock(int16_t* src, size_t blocksize);
+
+    public:
+
+        /**
+         * Construct a new interpolator
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to
+         * @param factor Interpolation factor
+         * @param cutoff Cutoff of the interpolation filter
+         * @param samplerate Output samplerate
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param blocksize Number of samples written to the next writer at a time
+         */
+        BoomaFirInterpolator(std::string id, HWriterConsumer<int16_t>* previous, int factor, int cutoff, int samplerate, int channels, size_t blocksize);
+        virtual ~BoomaFirInterpolator();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start() {
+            return _writer == nullptr || _writer->Start();
+        }
+
+        bool Stop() {
+            return _writer == nullptr || _writer->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _writer == nullptr || _writer->Command(command);
+        }
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            _writer = writer;
+        }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __FIRKERNEL_H
+#define __FIRKERNEL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Dot product of 'length' int16 samples and coefficients, length is a multiple of BOOMA_FIR_KERNEL_ALIGNMENT */
+typedef int32_t (*BoomaFirDotProduct)(const int16_t* samples, const int16_t* coefficients, int length);
+
+#define BOOMA_FIR_KERNEL_ALIGNMENT 16
+
+/**
+ * Fixed point FIR kernel.
+ *
+ * Coefficients are stored reversed, zero padded at the front to a multiple of
+ * BOOMA_FIR_KERNEL_ALIGNMENT and scaled to int16 with the largest shift that cannot
+ * overflow the int32 accumulator. The dot product is selected once at runtime,
+ * from the best of AVX2, SSE2, NEON or plain scalar code supported by the cpu.
+ */
+class BoomaFirKernel {
+
+    private:
+
+        std::vector<int16_t> _coefficients;
+        int _shift;
+        int32_t _rounding;
+        BoomaFirDotProduct _dotProduct;
+
+    public:
+
+        BoomaFirKernel(float* coefficients, int length);
+
+        void SetCoefficients(float* coefficients, int length);
+
+        /** Number of taps including the padding, samples[0 .. GetLength() - 1] must be readable */
+        int GetLength() {
+            return _coefficients.size();
+        }
+
+        /** Filter output for the sample at samples[GetLength() - 1] */
+        inline int16_t Calculate(const int16_t* samples) {
+            int32_t result = (_dotProduct(samples, &_coefficients[0], _coefficients.size()) + _rounding) >> _shift;
+            return result > 32767 ? 32767 : (result < -32768 ? -32768 : (int16_t) result);
+        }
+
+        static std::string GetImplementation();
+};
+
+#endif
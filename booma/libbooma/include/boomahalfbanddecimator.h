@@ -0,0 +1,71 @@
+#ifndef __HALFBANDDECIMATOR_H
+#define __HALFBANDDECIMATOR_H
+
+#include <vector>
+
+#include <hardtapi.h>
+
+/**
+ * Decimate by 2 using a halfband lowpass FIR filter, for realvalued or interleaved IQ samples.
+ *
+ * A halfband filter has every other coefficient equal to zero (except the center tap, which is 0.5),
+ * and the remaining coefficients are symmetric. Each output sample therefore costs one multiplication
+ * per nonzero coefficient pair plus one for the center tap, about a quarter of a plain FIR filter of
+ * the same length, and only the samples that are kept are calculated.
+ */
+class BoomaHalfbandDecimator : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        int _taps;
+        int _length;
+        bool _isIq;
+        size_t _blocksize;
+
+        // Nonzero coefficients at odd distances 1, 3, 5.. from the center, fixed point
+        std::vector<int32_t> _coefficients;
+        int32_t _center;
+        int _shift;
+        int32_t _rounding;
+
+        // Input block and history followed by the deinterleaved input, for I (or realvalued samples) and Q
+        int16_t* _input;
+        std::vector<int16_t> _i;
+        std::vector<int16_t> _q;
+        int _available;
+        int _next;
+
+        bool ReadInput();
+
+        static float Bessel(float x);
+
+        inline int16_t Calculate(const int16_t* samples);
+
+    public:
+
+        /** Create a halfband decimator with 'taps' nonzero coefficients on each side of the center tap */
+        BoomaHalfbandDecimator(std::string id, HReader<int16_t>* reader, int taps, size_t blocksize, bool isIq = false);
+        ~BoomaHalfbandDecimator();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return _reader->Start();
+        }
+
+        bool Stop() {
+            return _reader->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+
+        /** Total filter length, including the zero coefficients */
+        int GetLength() {
+            return _length;
+        }
+};
+
+#endif
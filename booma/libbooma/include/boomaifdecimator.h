@@ -0,0 +1,93 @@
+#ifndef __IFDECIMATOR_H
+#define __IFDECIMATOR_H
+
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomafirkernel.h"
+#include "boomaoscillator.h"
+
+/**
+ * Move the band around an IF to a lower samplerate, for narrow receivers.
+ *
+ * The realvalued input is filtered with a complex bandpass around the IF (a lowpass shifted to
+ * the IF, kept as a cosine and a sine kernel) and decimated, giving the band as IQ samples at
+ * the low samplerate. Only the samples that are kept are calculated, and the shift to the IF is
+ * part of the kernels, so nothing is done for the discarded samples.
+ *
+ * The IQ samples are then shifted to a selectable low IF and the realvalued part is written, so
+ * the following stages sees the band as an ordinary realvalued signal. Since the shift is done
+ * on IQ samples, it has no image and can also be used as the beattone mixer of a receiver.
+ * The band covers IF +/- a quarter of the low samplerate.
+ *
+ * The decimation phase is carried across blocks, so each input block gives blocksize/factor
+ * samples, plus or minus one.
+ */
+class BoomaIfDecimator : public HWriter<int16_t>, public HWriterConsumer<int16_t> {
+
+    private:
+
+        HWriter<int16_t>* _writer;
+        int _factor;
+        int _rate;
+        int _center;
+        BoomaFirKernel* _cosine;
+        BoomaFirKernel* _sine;
+        BoomaOscillator _oscillator;
+
+        // Input history, and the output for the current block as IQ samples
+        std::vector<int16_t> _input;
+        std::vector<int16_t> _iq;
+        std::vector<int16_t> _output;
+        int _next;
+
+    public:
+
+        /**
+         * Construct a new IF decimator
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to
+         * @param center IF to move
+         * @param samplerate Input samplerate
+         * @param factor Decimation factor, the low samplerate is samplerate/factor
+         */
+        BoomaIfDecimator(std::string id, HWriterConsumer<int16_t>* previous, int center, int samplerate, int factor);
+        ~BoomaIfDecimator();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start() {
+            return _writer == nullptr || _writer->Start();
+        }
+
+        bool Stop() {
+            return _writer == nullptr || _writer->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _writer == nullptr || _writer->Command(command);
+        }
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            _writer = writer;
+        }
+
+        /** Set the low IF, the position of the input IF in the decimated signal. Default is a quarter of the low samplerate */
+        void SetShift(int frequency) {
+            _oscillator.SetFrequency((frequency - _center) % _rate, _rate);
+        }
+
+        /** The low samplerate */
+        int GetSamplerate() {
+            return _rate;
+        }
+
+        /** Largest number of samples written at a time */
+        size_t GetBlocksize(size_t blocksize) {
+            return (blocksize / _factor) + 1;
+        }
+};
+
+#endif
@@ -5,6 +5,27 @@
 #include "configoptions.h"
 #include "boomaexception.h"
 #include "boomainputexception.h"
+#include "boomachannelizer.h"
+#include "boomafirfilter.h"
+#include "boomafirdecimator.h"
+#include "boomahalfbanddecimator.h"
+#include "boomaringbufferreader.h"
+#include "boomamappedfilereader.h"
+#include "boomaiqgenerator.h"
+#include "boomacompressedreader.h"
+#include "boomacompressedwriter.h"
+#include "boomasegmentedwriter.h"
+#include "boomaasyncfilewriter.h"
+#include "boomacapturebuffer.h"
+#include "boomawireencoder.h"
+#include "boomawiredecoder.h"
+#include "boomachannelextractor.h"
+#include "boomachannelreconstructor.h"
+#include "boomafanout.h"
+#include "boomaudpsender.h"
+#include "boomaudpreader.h"
+#include "boomapipelinebuffer.h"
+#include "boomatiming.h"
 #include "booma.h"
 
 class BoomaInput {
@@ -15,24 +36,44 @@ public:
 
         // Input and processor
         HReader<int16_t>* _inputReader;
+        BoomaMappedFileReader* _mappedReader;
         HStreamProcessor<int16_t>* _streamProcessor;
         HNetworkProcessor<int16_t>* _networkProcessor;
+        BoomaWireDecoder* _wireDecoder;
+        BoomaChannelReconstructor* _channelReconstructor;
+
+        // Remote input server streams, several when the input is shared between heads
+        std::vector<BoomaChannelExtractor*> _channelExtractors;
+        std::vector<BoomaWireEncoder*> _wireEncoders;
+        BoomaFanout* _fanout;
+        std::vector<HNetworkProcessor<int16_t>*> _clientProcessors;
+        std::vector<BoomaUdpSender*> _udpSenders;
+
+        // Remote head with UDP transport
+        BoomaUdpReader* _udpReader;
+        HNullWriter<int16_t>* _networkNullWriter;
+
+        // Decoupling the input reader from the processing chain
+        BoomaRingBufferReader* _ringBuffer;
 
         // Decimation
         HGain<int16_t>* _decimatorGain;
         HAgc<int16_t>* _decimatorAgc;
         HIqMultiplier<int16_t>* _ifMultiplier;
-        HIqFirDecimator<int16_t>* _iqFirDecimator;
+        BoomaFirDecimator* _iqFirDecimator;
         HIqDecimator<int16_t>* _iqDecimator;
-        HFirDecimator<int16_t>* _firDecimator;
+        BoomaFirDecimator* _firDecimator;
         HDecimator<int16_t>* _decimator;
+        BoomaChannelizer* _channelizer;
+        std::vector<BoomaHalfbandDecimator*> _halfbandDecimators;
+        BoomaFirDecimator* _intermediateDecimator;
 
         // Preamp
         HGain<int16_t>* _preamp;
 
         // Input filtering
-        HIqFirFilter<int16_t>* _inputIqFirFilter;
-        HFirFilter<int16_t>* _inputFirFilter;
+        BoomaFirFilter* _inputIqFirFilter;
+        BoomaFirFilter* _inputFirFilter;
 
         // Dumping rf input
         HSplitter<int16_t>* _rfSplitter;
@@ -40,6 +81,7 @@ public:
         HBufferedWriter<int16_t>* _rfBuffer;
         HWriter<int16_t>* _rfWriter;
         HDelay<int16_t>* _rfDelay;
+        BoomaCaptureBuffer* _rfCapture;
 
         // RF spectrum reporting
         HFftOutput<int16_t>* _rfFft;
@@ -51,6 +93,15 @@ public:
         int _rfSpectrumSize;
         HGain<int16_t>* _rfFftGain;
 
+        // Splitting off additional receiver channels
+        HSplitter<int16_t>* _channelSplitter;
+
+        // Optional pipeline split between the input and the receiver
+        BoomaPipelineBuffer* _pipeline;
+
+        // Optional stage timing
+        BoomaTimingCollection _timing;
+
         // Final consumer
         HWriterConsumer<int16_t>* _lastConsumer;
 
@@ -58,10 +109,18 @@ public:
         int _hardwareFrequency;
         int _ifFrequency;
 
-        HReader<int16_t>* SetInputReader(ConfigOptions* opts);
+        HReader<int16_t>* SetInputReader(ConfigOptions* opts, HReader<int16_t>* inputReader);
         void SetReaderFrequencies(ConfigOptions *opts, int frequency);
+        HReader<int16_t>* SetRingBuffer(ConfigOptions* opts, HReader<int16_t>* previous);
         bool GetDecimationRate(int inputRate, int outputRate, int* first, int* second);
+        int GetChannelPosition(ConfigOptions* opts);
+        HReader<int16_t>* SetRemoteStream(ConfigOptions* opts, HReader<int16_t>* previous, std::string suffix, int dataPort, bool isRetuneAllowed);
+        void RunClients(int blocks);
+        void RunUdp(int blocks);
+        bool GetHalfbandDecimationPlan(int inputRate, int outputRate, int* stages, int* intermediateFactor, int* finalFactor);
+        HReader<int16_t>* SetHalfbandDecimation(ConfigOptions* opts, HReader<int16_t>* previous, bool isIq, int stages, int intermediateFactor, int finalFactor);
         HReader<int16_t>* SetDecimation(ConfigOptions* opts, HReader<int16_t>* reader);
+        HReader<int16_t>* SetDecimatorGain(ConfigOptions* opts, HReader<int16_t>* previous);
         HWriterConsumer<int16_t>* SetInputFilter(ConfigOptions* options, HWriterConsumer<int16_t>* previous);
         HWriterConsumer<int16_t>* SetShift(ConfigOptions* options, HWriterConsumer<int16_t>* previous);
         HWriterConsumer<int16_t>* SetPreamp(ConfigOptions* opts, HWriterConsumer<int16_t>* previous);
@@ -76,18 +135,33 @@ public:
                 std::string Type() { return "BoomaInputException"; }
         };
 
-        BoomaInput(ConfigOptions* opts, bool* isTerminated);
+        BoomaInput(ConfigOptions* opts, bool* isTerminated, HReader<int16_t>* inputReader = nullptr);
         ~BoomaInput();
 
         HWriterConsumer<int16_t>* GetLastWriterConsumer() {
             return _lastConsumer;
         }
 
+        HWriterConsumer<int16_t>* GetChannelWriterConsumer(int bin = 0);
+        int GetChannelizerBin(ConfigOptions* opts, long int frequency);
+        int GetChannelOffset(ConfigOptions* opts, long int frequency, int bin = 0);
+
+        int GetVirtualFrequency() {
+            return _virtualFrequency;
+        }
+
         void Run(int blocks = 0);
 
         void Halt();
 
         bool SetDumpRf(bool enabled);
+        bool CaptureRf(int seconds);
+        void StopCaptureRf();
+        bool IsCapturingRf();
+
+        BoomaCaptureBuffer* GetRfCapture() {
+            return _rfCapture;
+        }
 
         bool SetFrequency(ConfigOptions* opts, int frequency);
 
@@ -101,6 +175,23 @@ public:
 
         int GetRfSpectrum(double* spectrum);
         int GetRfFftSize();
+
+        unsigned long GetInputOverflows();
+        unsigned long GetInputUnderruns();
+
+        bool Seek(ConfigOptions* opts, double seconds);
+        double GetPosition(ConfigOptions* opts);
+
+        BoomaPipelineBuffer* GetPipeline() {
+            return _pipeline;
+        }
+
+        BoomaTimingCollection* GetTiming() {
+            return &_timing;
+        }
+
+        void GetDumpStatistics(std::vector<BoomaAsyncWriterStatistics>* statistics);
+        void GetRemoteStatistics(std::vector<BoomaRemoteStatistics>* statistics);
 };
 
 #endif
@@ -0,0 +1,45 @@
+#ifndef __IQGENERATOR_H
+#define __IQGENERATOR_H
+
+#include <hardtapi.h>
+
+#include "boomaoscillator.h"
+
+/**
+ * Generate a complex sine as interleaved IQ samples, the IQ counterpart of HSineGenerator.
+ */
+class BoomaIqGenerator : public HReader<int16_t> {
+
+    private:
+
+        int _amplitude;
+        BoomaOscillator _oscillator;
+
+    public:
+
+        /**
+         * Construct a new IQ generator
+         *
+         * @param id Id of this reader
+         * @param samplerate Samplerate of the complex samples
+         * @param frequency Frequency of the sine, negative frequencies are below the center
+         * @param amplitude Amplitude of the sine
+         */
+        BoomaIqGenerator(std::string id, int samplerate, int frequency, int amplitude);
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+};
+
+#endif
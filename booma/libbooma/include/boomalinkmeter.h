@@ -0,0 +1,73 @@
+#ifndef __LINKMETER_H
+#define __LINKMETER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <stdint.h>
+
+/** Counters for one remote stream, on the server or on the head */
+struct BoomaRemoteStatistics {
+    std::string Name;
+    double BytesPerSecond;
+    double Latency;
+    double MaxLatency;
+    double Jitter;
+    double ClockDrift;
+    bool HasTimestamps;
+    unsigned long QueueDepth;
+    unsigned long Dropped;
+};
+
+/**
+ * Measure throughput and delay of a remote stream over windows of one second.
+ *
+ * Delays are measured from the timestamp the server puts in each wire frame to the time the
+ * head decodes the frame, so the latency includes the offset between the two clocks and is
+ * only meaningful when both machines are synchronized (NTP). The jitter (average minus the
+ * smallest delay) and the clock drift (change of the smallest delay, in ppm) are not affected
+ * by a constant offset.
+ */
+class BoomaLinkMeter {
+
+    private:
+
+        std::mutex _mutex;
+        std::chrono::steady_clock::time_point _windowStart;
+
+        // Current window
+        unsigned long long _bytes;
+        double _delaySum;
+        double _delayMax;
+        double _delayMin;
+        unsigned long _delays;
+
+        // Results from the last complete window, delays in milliseconds
+        double _bytesPerSecond;
+        double _latency;
+        double _maxLatency;
+        double _jitter;
+        double _drift;
+        double _previousMin;
+        bool _hasTimestamps;
+
+        void Roll();
+
+    public:
+
+        BoomaLinkMeter();
+
+        /** Count transferred bytes */
+        void AddBytes(size_t bytes);
+
+        /** Count a received frame with the server timestamp (microseconds since the epoch) */
+        void AddTimestamp(uint64_t timestamp);
+
+        /** Copy the results from the last complete window */
+        void GetStatistics(BoomaRemoteStatistics* statistics);
+
+        /** Microseconds since the epoch, used for frame timestamps */
+        static uint64_t Now();
+};
+
+#endif
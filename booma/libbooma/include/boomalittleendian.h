@@ -0,0 +1,22 @@
+#ifndef __LITTLEENDIAN_H
+#define __LITTLEENDIAN_H
+
+#include <cstdint>
+
+/** Store the lowest 'bytes' bytes of value, least significant byte first */
+inline void WriteLittleEndian(uint8_t* dest, uint32_t value, int bytes) {
+    for( int i = 0; i < bytes; i++ ) {
+        dest[i] = (value >> (i * 8)) & 0xff;
+    }
+}
+
+/** Read a value of 'bytes' bytes, stored least significant byte first */
+inline uint32_t ReadLittleEndian(const uint8_t* src, int bytes) {
+    uint32_t value = 0;
+    for( int i = 0; i < bytes; i++ ) {
+        value |= ((uint32_t) src[i]) << (i * 8);
+    }
+    return value;
+}
+
+#endif
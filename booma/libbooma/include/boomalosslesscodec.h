@@ -0,0 +1,71 @@
+#ifndef __LOSSLESSCODEC_H
+#define __LOSSLESSCODEC_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+/**
+ * Lossless compression of 16 bit samples, used for the BLC dump format.
+ *
+ * Each frame is compressed one channel at a time. A fixed linear predictor of order 0 to 3 is
+ * selected for each channel, and the prediction residuals are Rice coded with a parameter
+ * chosen for the frame. Channels that does not compress are stored raw.
+ *
+ * A BLC file is a file header followed by frames:
+ *
+ *   File header:  "BLC1", channels (uint8), 3 reserved bytes, samplerate (uint32)
+ *   Frame header: "BLCF", samples in the frame (uint16), payload bytes (uint32)
+ *   Payload:      For each channel: order (uint8, 255 = raw), rice parameter (uint8),
+ *                 warm-up samples (int16 * order) and the residual bits, padded to a whole byte
+ *
+ * All values are little endian.
+ */
+class BoomaLosslessCodec {
+
+    public:
+
+        static const int FileHeaderSize = 12;
+        static const int FrameHeaderSize = 10;
+
+        /** Largest number of samples in a frame, the size of the sample count in the frame header */
+        static const int MaxFrameSamples = 65535;
+
+        /** Largest payload of a frame with 'length' samples, when every channel is stored raw */
+        static size_t GetMaxPayloadSize(int length, int channels) {
+            return (channels * 2) + (length * sizeof(int16_t));
+        }
+
+        /** Write a file header */
+        static bool WriteFileHeader(FILE* file, int channels, int samplerate);
+
+        /** Read a file header, returns false if the file is not a BLC file */
+        static bool ReadFileHeader(FILE* file, int* channels, int* samplerate);
+
+        /** Compress a frame of interleaved samples, the number of samples must be a multiple of the channel count */
+        static void Encode(const int16_t* samples, int length, int channels, std::vector<uint8_t>* frame);
+
+        /**
+         * Read and decompress the next frame
+         *
+         * @param file File to read from
+         * @param channels Number of interleaved channels
+         * @param samples Decompressed samples are appended to this vector
+         * @return False at end of file, or if the frame is corrupt
+         * @throws BoomaInputException if the frame header claims a larger frame than the encoder can write
+         */
+        static bool Decode(FILE* file, int channels, std::vector<int16_t>* samples);
+
+        /**
+         * Decompress a complete frame held in memory
+         *
+         * @param frame Frame header and payload
+         * @param frameSize Number of bytes available at frame
+         * @param channels Number of interleaved channels
+         * @param samples Decompressed samples are appended to this vector
+         * @return False if the frame is truncated or corrupt
+         */
+        static bool DecodeFrame(const uint8_t* frame, size_t frameSize, int channels, std::vector<int16_t>* samples);
+};
+
+#endif
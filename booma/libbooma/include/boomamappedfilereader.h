@@ -0,0 +1,76 @@
+#ifndef __MAPPEDFILEREADER_H
+#define __MAPPEDFILEREADER_H
+
+#include <atomic>
+
+#include <hardtapi.h>
+
+/**
+ * Read samples from a memory mapped pcm or wav file.
+ *
+ * The file is mapped read-only with sequential readahead, so reading a block is a single copy
+ * from the page cache without any read() calls. The reader can be positioned anywhere in the
+ * file instantly, and the mapped samples can be accessed directly through GetWindow().
+ *
+ * Pages that has been read are released regularly, so that very large captures does not
+ * grow the resident size of the process.
+ */
+class BoomaMappedFileReader : public HReader<int16_t> {
+
+    private:
+
+        int _fd;
+        void* _map;
+        size_t _mapSize;
+        size_t _dataOffset;
+        const int16_t* _samples;
+        long _length;
+        std::atomic<long> _position;
+        std::atomic<size_t> _released;
+
+        void Release(long position);
+
+    public:
+
+        /**
+         * Construct a new memory mapped file reader
+         *
+         * @param id Id of this reader
+         * @param filename Name of the pcm or wav file
+         * @param isWav The file is a wav file
+         * @param first First sample to read
+         * @param length Number of samples to read, or -1 to read to the end of the file
+         */
+        BoomaMappedFileReader(std::string id, std::string filename, bool isWav, long first = 0, long length = -1);
+        ~BoomaMappedFileReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return true;
+        }
+
+        bool Stop() {
+            return true;
+        }
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /** Get a pointer to the mapped samples at position, or nullptr if there are not length samples available */
+        const int16_t* GetWindow(long position, size_t length);
+
+        /** Move the read position to the given sample */
+        bool Seek(long position);
+
+        long GetPosition() {
+            return _position;
+        }
+
+        long GetLength() {
+            return _length;
+        }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef __OSCILLATOR_H
+#define __OSCILLATOR_H
+
+#include <atomic>
+#include <complex>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * Numerically controlled oscillator for shifting interleaved IQ samples in frequency.
+ *
+ * The oscillator is a rotating phasor that is renormalized once per block, so the
+ * frequency can be changed at any time without a phase jump. The frequency may be set from
+ * another thread (fx. a retune command) while mixing, the new rotation is then used from the
+ * next block.
+ */
+class BoomaOscillator {
+
+    private:
+
+        std::complex<double> _phasor;
+        std::complex<double> _rotation;
+        bool _isMixing;
+
+        // Rotation waiting for the next block
+        std::mutex _mutex;
+        std::complex<double> _pending;
+        std::atomic<bool> _isChanged;
+        std::atomic<int> _frequency;
+
+    public:
+
+        BoomaOscillator():
+            _phasor(1, 0),
+            _rotation(1, 0),
+            _isMixing(false),
+            _pending(1, 0),
+            _isChanged(false),
+            _frequency(0) {}
+
+        /** Set the shift in Hz, positive frequencies moves the spectrum up */
+        void SetFrequency(int frequency, int samplerate) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _frequency = frequency;
+            _pending = std::polar(1.0, (2 * M_PI * frequency) / samplerate);
+            _isChanged = true;
+        }
+
+        int GetFrequency() {
+            return _frequency;
+        }
+
+        /** Shift a block of interleaved IQ samples in place */
+        void Mix(int16_t* samples, size_t length) {
+            if( _isChanged.exchange(false) ) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _rotation = _pending;
+                _isMixing = _frequency != 0;
+            }
+            if( !_isMixing ) {
+                return;
+            }
+            for( size_t i = 0; i + 1 < length; i += 2 ) {
+                std::complex<double> value = std::complex<double>(samples[i], samples[i + 1]) * _phasor;
+                samples[i] = Clip(value.real());
+                samples[i + 1] = Clip(value.imag());
+                _phasor *= _rotation;
+            }
+            _phasor /= std::abs(_phasor);
+        }
+
+        static inline int16_t Clip(double value) {
+            long rounded = lround(value);
+            return rounded > 32767 ? 32767 : (rounded < -32768 ? -32768 : (int16_t) rounded);
+        }
+};
+
+#endif
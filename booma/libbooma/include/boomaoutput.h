@@ -4,6 +4,12 @@
 #include <hardtapi.h>
 #include "configoptions.h"
 #include "boomareceiver.h"
+#include "boomatiming.h"
+#include "boomacompressedwriter.h"
+#include "boomasegmentedwriter.h"
+#include "boomaasyncfilewriter.h"
+#include "boomacapturebuffer.h"
+#include "boomasignaltrigger.h"
 
 class BoomaOutput {
 
@@ -24,6 +30,7 @@ class BoomaOutput {
         HBreaker<int16_t>* _audioBreaker;
         HBufferedWriter<int16_t>* _audioBuffer;
         HDelay<int16_t>* _audioDelay;
+        BoomaCaptureBuffer* _audioCapture;
 
         // Signal level reporting
         HSplitter<int16_t>* _ifSplitter;
@@ -34,6 +41,12 @@ class BoomaOutput {
         int _signalMax;
         double _signalSum;
 
+        // Recording triggered by the signal level
+        BoomaSignalTrigger* _signalTrigger;
+        bool _triggerAudio;
+        BoomaCaptureBuffer* _triggerRfCapture;
+        double _signalLevelSeconds;
+
         // Audio spectrum reporting
         HFftOutput<int16_t>* _audioFft;
         HCustomWriter<HFftResults>* _audioFftWriter;
@@ -56,14 +69,29 @@ class BoomaOutput {
         // Output filter
         int _outputFilterWidth;
 
+        // Optional stage timing
+        BoomaTimingCollection _timing;
+
         bool IsWav(std::string filename);
 
     public:
 
-        BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver);
+        BoomaOutput(ConfigOptions* opts, BoomaReceiver* receiver, std::string outputFilename = "", std::string dumpPrefix = "OUTPUT");
         ~BoomaOutput();
 
         bool SetDumpAudio(bool enabled);
+        bool CaptureAudio(int seconds);
+        void StopCaptureAudio();
+        bool IsCapturingAudio();
+
+        /** Let the signal trigger control this rf capture buffer as well */
+        void SetTriggerRfCapture(BoomaCaptureBuffer* capture) {
+            _triggerRfCapture = capture;
+        }
+
+        bool IsTriggered() {
+            return _signalTrigger != nullptr && _signalTrigger->IsTriggered();
+        }
         int SetVolume(int volume);
 
         int GetSignalLevel();
@@ -76,6 +104,12 @@ class BoomaOutput {
 
         int GetAudioFftSize();
         int GetAudioSpectrum(double* spectrum);
+
+        BoomaTimingCollection* GetTiming() {
+            return &_timing;
+        }
+
+        void GetDumpStatistics(std::vector<BoomaAsyncWriterStatistics>* statistics);
 };
 
 #endif
@@ -0,0 +1,93 @@
+#ifndef __PIPELINEBUFFER_H
+#define __PIPELINEBUFFER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+/** Queue statistics for one pipeline stage */
+struct BoomaPipelineStatistics {
+    std::string Name;
+    int Depth;
+    int HighWater;
+    unsigned long Blocks;
+    unsigned long FullWaits;
+    double AverageLatency;
+    double MaxLatency;
+};
+
+/**
+ * Split the processing chain into two threads.
+ *
+ * Blocks written to the pipeline buffer are copied into a bounded queue of preallocated blocks
+ * and written to the next writer by a worker thread, optionally pinned to a cpu. When the queue is
+ * full the writing thread waits, so the added latency is bounded by the queue depth.
+ * The worker must be started with StartWorker() (or Start()) before blocks are written, blocks
+ * written while it is not running are dropped. Latencies are reported in milliseconds.
+ */
+class BoomaPipelineBuffer : public HWriter<int16_t>, public HWriterConsumer<int16_t> {
+
+    private:
+
+        HWriter<int16_t>* _writer;
+        std::string _name;
+        int _depth;
+        size_t _blocksize;
+        int _cpu;
+
+        // Bounded queue of preallocated blocks
+        std::vector<int16_t*> _queue;
+        std::vector<int> _lengths;
+        std::vector<std::chrono::steady_clock::time_point> _enqueued;
+        int _head;
+        int _count;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+
+        // Starting and stopping the worker is serialized, _isRunning is guarded by _mutex
+        std::mutex _workerMutex;
+        std::thread* _thread;
+        bool _isRunning;
+
+        // Statistics
+        int _highWater;
+        unsigned long _blocks;
+        unsigned long _fullWaits;
+        double _totalLatency;
+        double _maxLatency;
+
+        void WorkerThread();
+        void SetAffinity();
+
+    public:
+
+        BoomaPipelineBuffer(std::string id, HWriterConsumer<int16_t>* previous, int depth, size_t blocksize, int cpu = -1);
+        ~BoomaPipelineBuffer();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            _writer = writer;
+        }
+
+        bool Start();
+        bool Stop();
+
+        /** Start or stop the worker thread only, stopping drains the queue first */
+        void StartWorker();
+        void StopWorker();
+
+        bool Command(HCommand* command) {
+            return _writer != nullptr ? _writer->Command(command) : true;
+        }
+
+        BoomaPipelineStatistics GetStatistics();
+        void ResetStatistics();
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include "configoptions.h"
 #include "boomainput.h"
 #include "boomadecoder.h"
+#include "boomapipelinebuffer.h"
+#include "boomatiming.h"
 #include "option.h"
 
 #include "boomareceiverexception.h"
@@ -22,6 +24,13 @@ class BoomaReceiver {
         HWriterConsumer<int16_t>* _receive;
         HWriterConsumer<int16_t>* _postProcess;
         HSplitter<int16_t>* _decoder;
+        BoomaDecoder* _attachedDecoder;
+
+        // Optional pipeline split between the receiver and the output
+        BoomaPipelineBuffer* _pipeline;
+
+        // Optional stage timing
+        BoomaTimingCollection _timing;
 
         std::vector<Option> _options;
 
@@ -59,7 +68,10 @@ class BoomaReceiver {
         BoomaReceiver(ConfigOptions* opts, int initialFrequency):
             _hasBuilded(false),
             _frequency(initialFrequency),
-            _rfAgc(nullptr) {
+            _rfAgc(nullptr),
+            _attachedDecoder(nullptr),
+            _pipeline(nullptr),
+            _timing(opts->GetStageTiming()) {
 
             HLog("Creating BoomaReceiver with initial frequency %d", _frequency);
         }
@@ -69,6 +81,7 @@ class BoomaReceiver {
     public:
 
         virtual ~BoomaReceiver() {
+            SAFE_DELETE(_pipeline);
             SAFE_DELETE(_rfAgc);
         }
 
@@ -87,6 +100,7 @@ class BoomaReceiver {
         virtual std::string GetOptionInfoString() = 0;
 
         void Build(ConfigOptions* opts, BoomaInput* input, BoomaDecoder* decoder = NULL);
+        void Build(ConfigOptions* opts, HWriterConsumer<int16_t>* previous, BoomaDecoder* decoder = NULL);
 
         bool SetFrequency(ConfigOptions* opts, int frequency) {
             _frequency = frequency;
@@ -101,7 +115,15 @@ class BoomaReceiver {
         virtual bool IsFrequencySupported(ConfigOptions* opts, long frequency) = 0;
 
         HWriterConsumer<int16_t>* GetLastWriterConsumer() {
-            return _decoder->Consumer();
+            return _pipeline != nullptr ? _pipeline->Consumer() : _decoder->Consumer();
+        }
+
+        BoomaPipelineBuffer* GetPipeline() {
+            return _pipeline;
+        }
+
+        BoomaTimingCollection* GetTiming() {
+            return &_timing;
         }
 
         int SetRfGain(int gain);
@@ -0,0 +1,80 @@
+#ifndef __RINGBUFFERREADER_H
+#define __RINGBUFFERREADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+/**
+ * Decouple an input reader from the processing chain.
+ *
+ * The input reader runs on its own thread and hands blocks to the processing thread through a
+ * lock-free single-producer/single-consumer ring of preallocated blocks. When the ring is full the
+ * reader thread either drops the newest block (live sources, which can not wait) or waits for the
+ * processing thread (files and generators, which must not lose samples).
+ *
+ * Blocks are moved without locking. A thread that has to wait for the other side (an empty ring, or
+ * a full ring that can not drop) registers as a waiter and sleeps on a condition variable. The
+ * other side only takes the mutex to wake it when there is a waiter, so as long as neither side
+ * has to wait, no locks are taken. A retune flushes the blocks read at the old frequency.
+ */
+class BoomaRingBufferReader : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        size_t _blocksize;
+        int _blocks;
+        bool _dropOnOverflow;
+
+        // Ring of preallocated blocks. The reader thread only moves the head, the processing thread only moves the tail
+        std::vector<int16_t*> _ring;
+        std::vector<int> _lengths;
+        std::atomic<unsigned long> _head;
+        std::atomic<unsigned long> _tail;
+        int16_t* _overflowBlock;
+
+        // Waiting for the other side
+        std::mutex _waitMutex;
+        std::condition_variable _changed;
+        std::atomic<int> _waiters;
+        std::atomic<bool> _isFlushRequested;
+
+        std::thread* _thread;
+        std::atomic<bool> _isRunning;
+        std::atomic<bool> _isEndOfInput;
+
+        std::atomic<unsigned long> _overflows;
+        std::atomic<unsigned long> _underruns;
+
+        void ReaderThread();
+        void Notify();
+
+    public:
+
+        BoomaRingBufferReader(std::string id, HReader<int16_t>* reader, int blocks, size_t blocksize, bool dropOnOverflow);
+        ~BoomaRingBufferReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command);
+
+        /** Number of input blocks dropped because the ring was full */
+        unsigned long GetOverflows() {
+            return _overflows;
+        }
+
+        /** Number of reads that had to wait for the input because the ring was empty */
+        unsigned long GetUnderruns() {
+            return _underruns;
+        }
+};
+
+#endif
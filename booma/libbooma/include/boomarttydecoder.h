@@ -0,0 +1,104 @@
+#ifndef __RTTYDECODER_H
+#define __RTTYDECODER_H
+
+#include <complex>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomadecoder.h"
+
+/**
+ * Demodulate and decode RTTY (Baudot with 1 start bit, 5 data bits and 1.5 stop bits) from the
+ * audio output of an RTTY receiver, which places the mark and space tones around RTTY_TONE_CENTER.
+ *
+ * Each tone is mixed down to zero and summed over short chips (RTTY_CHIPS_PER_BIT per bit), which
+ * is all that is done per sample. Everything else runs once per chip: The sum of the chips in the
+ * last bit is a filter matched to one bit of the tone. The level and the noise floor of each tone
+ * is tracked (automatic threshold correction), so that the slicer can compare the tones even when
+ * one of them fades. Characters are framed from the start bit and checked against the stop bit,
+ * and dropped if the bits were not clear enough, so that noise does not print as text.
+ *
+ * Shift, baudrate and polarity are the receiver options 'Shift', 'Baudrate' and 'Reverse'.
+ * Decoded characters are given to the callback on the thread that writes to the decoder.
+ */
+class BoomaRttyDecoder : public BoomaDecoder {
+
+    private:
+
+        std::mutex _mutex;
+        std::function<void(std::string)> _callback;
+        int _rate;
+
+        // Settings, the baudrate is given in 1/100 baud
+        int _shift;
+        int _baudrate;
+        bool _isReversed;
+
+        // Tone oscillators and the sums for the current chip
+        std::complex<float> _markPhase;
+        std::complex<float> _markStep;
+        std::complex<float> _spacePhase;
+        std::complex<float> _spaceStep;
+        std::complex<float> _markSum;
+        std::complex<float> _spaceSum;
+        int _chipLength;
+        int _chipSamples;
+
+        // Chips of the last bit, and the length of a bit in chips
+        std::vector<std::complex<float>> _markChips;
+        std::vector<std::complex<float>> _spaceChips;
+        int _chip;
+        float _bitLength;
+
+        // Level and noise floor of each tone
+        float _markLevel;
+        float _markFloor;
+        float _spaceLevel;
+        float _spaceFloor;
+
+        // Current character, the next bit, the number of chips until it is sampled and the
+        // summed quality of the bits
+        int _bit;
+        float _next;
+        int _code;
+        float _quality;
+        bool _isFigures;
+
+        void Configure();
+        void Chip();
+        float Slice(float mark, float space);
+        void Frame(float decision);
+        void Character(int code);
+
+        void Track(float value, float* level, float* floor);
+
+    protected:
+
+        void Decode(int16_t* src, int blocksize);
+
+    public:
+
+        /**
+         * Construct a new RTTY decoder, initially for 170Hz shift and 45.45 baud
+         *
+         * @param id Id of this writer
+         * @param samplerate Samplerate of the decoded signal
+         * @param callback Function receiving the decoded text
+         */
+        BoomaRttyDecoder(std::string id, int samplerate, std::function<void(std::string)> callback);
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        void SetReceiverOption(std::string name, int value);
+
+        /** Speed in words per minute, 7.5 bits per character and 6 characters per word */
+        int GetWpm();
+};
+
+#endif
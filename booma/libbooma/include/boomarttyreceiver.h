@@ -0,0 +1,106 @@
+#ifndef __RTTYRECEIVER_H
+#define __RTTYRECEIVER_H
+
+#include <algorithm>
+
+#include <hardtapi.h>
+
+#include "booma.h"
+#include "configoptions.h"
+#include "boomareceiver.h"
+#include "boomainput.h"
+#include "boomabiquaddesigner.h"
+
+/**
+ * RTTY receiver, tuned to the mark frequency with the space frequency 'Shift' Hz below it.
+ *
+ * The signal is mixed to the IF, filtered to the width of the shift and the keying sidebands,
+ * and mixed down so that the mark and space tones are placed around RTTY_TONE_CENTER, with the
+ * mark tone above the space tone. Decoding is done by a BoomaRttyDecoder on the output.
+ */
+class BoomaRttyReceiver : public BoomaReceiver {
+
+    private:
+
+        // Preprocessing
+        HHumFilter<int16_t>* _humfilter;
+        HIq2IConverter<int16_t>* _iq2IConverter;
+        HIqMultiplier<int16_t>* _iqMultiplier;
+        HBiQuadFilter<HBandpassBiQuad<int16_t>, int16_t>* _preselect;
+        HGain<int16_t>* _passbandGain;
+        HMultiplier<int16_t>* _ifMixer;
+
+        // Receiver
+        HCascadedBiQuadFilter<int16_t>* _ifFilter;
+        HMultiplier<int16_t>* _toneMixer;
+        HCascadedBiQuadFilter<int16_t>* _postSelect;
+
+        int GetIfFrequency(ConfigOptions* opts) {
+            // 6KHz when the samplerate allows it, otherwise a quarter of the samplerate
+            return std::min(6000, opts->GetOutputSampleRate() / 4);
+        }
+
+        int GetBandwidth() {
+            // The shift and the first keying sidebands of both tones
+            return GetOption("Shift") + ((2 * GetOption("Baudrate")) / 100);
+        }
+
+        float* GetIfCoefficients(ConfigOptions* opts) {
+            return BoomaBiQuadDesigner::GetBandpass(GetIfFrequency(opts) - (GetOption("Shift") / 2), GetBandwidth(), opts->GetOutputSampleRate());
+        }
+
+        float* GetOutputCoefficients(ConfigOptions* opts) {
+            return BoomaBiQuadDesigner::GetBandpass(RTTY_TONE_CENTER, GetBandwidth(), opts->GetOutputSampleRate());
+        }
+
+        int GetToneMixerFrequency(ConfigOptions* opts) {
+            // Center between the tones at the IF, moved to the center between the output tones
+            return GetIfFrequency(opts) - (GetOption("Shift") / 2) - RTTY_TONE_CENTER;
+        }
+
+        bool IsDataTypeSupported(InputSourceDataType datatype) {
+            switch( datatype ) {
+                case InputSourceDataType::REAL_INPUT_SOURCE_DATA_TYPE: return true;
+                case InputSourceDataType::IQ_INPUT_SOURCE_DATA_TYPE: return true;
+                case InputSourceDataType::I_INPUT_SOURCE_DATA_TYPE: return true;
+                case InputSourceDataType::Q_INPUT_SOURCE_DATA_TYPE: return true;
+                default: return false;
+            }
+        }
+
+        HWriterConsumer<int16_t>* PreProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous);
+        HWriterConsumer<int16_t>* Receive(ConfigOptions* opts, HWriterConsumer<int16_t>* previous);
+        HWriterConsumer<int16_t>* PostProcess(ConfigOptions* opts, HWriterConsumer<int16_t>* previous);
+
+        void OptionChanged(ConfigOptions* opts, std::string name, int value);
+
+        bool SetInternalFrequency(ConfigOptions* opts, int frequency);
+
+        long GetDefaultFrequency(ConfigOptions* opts) {
+            return (opts->GetOutputSampleRate() / 2) / 2;
+        }
+
+        bool IsFrequencySupported(ConfigOptions* opts, long frequency) {
+            if( opts->GetInputSourceDataType() == REAL_INPUT_SOURCE_DATA_TYPE ) {
+                // This receiver will not tune lower than the internal IF used
+                // in the heterodyne mixing stage.
+                return frequency < opts->GetOutputSampleRate() / 2 && (frequency > GetIfFrequency(opts));
+            } else {
+                // With an rtlsdr source, the frequency can be almost anything
+                return frequency >= 0;
+            }
+        }
+
+    public:
+
+        BoomaRttyReceiver(ConfigOptions* opts, int initialFrequency);
+        ~BoomaRttyReceiver();
+
+        std::string GetName() {
+            return "RTTY";
+        }
+
+        std::string GetOptionInfoString();
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __SEGMENTEDWRITER_H
+#define __SEGMENTEDWRITER_H
+
+#include <deque>
+
+#include <hardtapi.h>
+
+#include "boomaasyncwriter.h"
+
+/**
+ * Write samples to a rotating series of pcm or wav files.
+ *
+ * A new file is started every time the current file reaches the configured duration or size. Files
+ * are named '<basename>_<YYYYMMDD-HHMMSS>_<sequence>.<pcm|wav>', where the timestamp is the time of
+ * the first sample in the file. When the files written by this writer exceeds the configured total
+ * size, the oldest files are deleted.
+ *
+ * Each file is preallocated when it is created, and all file io is done by the writer thread.
+ * Samples dropped while a segment was open are logged when it is closed.
+ */
+class BoomaSegmentedWriter : public BoomaAsyncWriter {
+
+    private:
+
+        struct Segment {
+            std::string Filename;
+            off_t Size;
+        };
+
+        std::string _basename;
+        bool _isWav;
+        int _samplerate;
+        int _channels;
+        long _segmentSamples;
+        off_t _totalBytes;
+
+        // Current and previous segments, only accessed by the writer thread
+        int _fd;
+        Segment _segment;
+        long _segmentWritten;
+        unsigned long _segmentDropped;
+        off_t _synced;
+        int _sequence;
+        std::deque<Segment> _segments;
+        off_t _segmentsSize;
+        unsigned long _written;
+
+        bool OpenSegment();
+        void CloseSegment();
+        void DeleteSegments();
+
+    protected:
+
+        void WriteBuffer(int16_t* samples, size_t length);
+        void Close();
+
+    public:
+
+        /**
+         * Construct a new segmented writer
+         *
+         * @param id Id of this writer
+         * @param basename Filename prefix of the segments
+         * @param isWav Write wav files, otherwise raw pcm files
+         * @param samplerate Samplerate, stored in the wav header and used to name and split segments
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param segmentSeconds Maximum duration of a segment in seconds, 0 for no limit
+         * @param segmentBytes Maximum size of a segment in bytes, 0 for no limit
+         * @param totalBytes Maximum size of all segments written by this writer, 0 for no limit
+         * @param previous Writer consumer to attach to
+         * @param isBlocking Wait for the disk instead of dropping samples
+         * @param buffers Number of 1MB buffers that can be queued for writing
+         */
+        BoomaSegmentedWriter(std::string id, std::string basename, bool isWav, int samplerate, int channels, long segmentSeconds, off_t segmentBytes, off_t totalBytes, HWriterConsumer<int16_t>* previous, bool isBlocking = false, int buffers = 16);
+        ~BoomaSegmentedWriter();
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __SIGNALTRIGGER_H
+#define __SIGNALTRIGGER_H
+
+/**
+ * Decide when to start and stop a triggered recording from a series of signal level measurements.
+ *
+ * The trigger fires when the level has been at or above the threshold for the hold time, and is
+ * released when the level has been below the threshold for the release time.
+ */
+class BoomaSignalTrigger {
+
+    public:
+
+        enum Event {
+            NONE = 0,
+            START = 1,
+            STOP = 2
+        };
+
+    private:
+
+        int _threshold;
+        double _hold;
+        double _release;
+        bool _isTriggered;
+        double _above;
+        double _below;
+
+    public:
+
+        /**
+         * Construct a new signal trigger
+         *
+         * @param threshold Signal level (S) that triggers a recording
+         * @param hold Seconds the level must stay at or above the threshold before the recording starts
+         * @param release Seconds the level must stay below the threshold before the recording stops
+         */
+        BoomaSignalTrigger(int threshold, double hold, double release):
+            _threshold(threshold),
+            _hold(hold),
+            _release(release),
+            _isTriggered(false),
+            _above(0),
+            _below(0) {}
+
+        /**
+         * Add a measurement
+         *
+         * @param level Measured signal level (S)
+         * @param seconds Time covered by the measurement
+         * @return START or STOP when the recording should be started or stopped, otherwise NONE
+         */
+        Event Update(int level, double seconds);
+
+        bool IsTriggered() {
+            return _isTriggered;
+        }
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef __SKIMMER_H
+#define __SKIMMER_H
+
+#include <complex>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomacwdecoder.h"
+#include "boomafft.h"
+
+/** A CW signal found by the skimmer */
+struct BoomaSkimmerSpot {
+    int Offset;
+    long Frequency;
+    std::string Callsign;
+    std::string Text;
+    int Snr;
+    int Wpm;
+};
+
+/**
+ * Find and decode every CW signal in the input passband.
+ *
+ * The input (realvalued or IQ) is transformed with an FFT of about SKIMMER_BIN_WIDTH Hz per bin,
+ * once for every tick of the CW decoder (2 ms), so the level of each bin is an envelope that the
+ * decoder timing can use directly. A pool of SKIMMER_CHANNELS decoders is created up front: At
+ * regular intervals, bins standing out from the noise floor (the median of all bins) are given a
+ * free decoder, decoders follow their signal if it drifts to a neighbouring bin, and decoders
+ * that have not seen a mark for SKIMMER_IDLE_SECONDS are returned to the pool.
+ *
+ * The FFT is shared by all signals, so each decoded signal only costs a few operations per tick.
+ */
+class BoomaSkimmer : public HWriter<int16_t> {
+
+    private:
+
+        class Slot {
+
+            public:
+
+                BoomaCwDecoder* Decoder;
+                int Bin;
+                bool IsActive;
+                std::string Text;
+                std::string Word;
+                std::string Callsign;
+
+                Slot():
+                    Decoder(nullptr),
+                    Bin(0),
+                    IsActive(false) {}
+        };
+
+        std::mutex _mutex;
+        int _rate;
+        bool _isIq;
+        int _size;
+        int _bins;
+        int _hop;
+
+        // Input history and the current frame
+        BoomaFft* _fft;
+        std::vector<float> _window;
+        std::vector<std::complex<float>> _history;
+        std::vector<std::complex<float>> _frame;
+        std::vector<std::complex<float>> _spectrum;
+        int _position;
+        int _next;
+
+        // Bin powers for the current frame, and the largest since the last detection
+        std::vector<float> _power;
+        std::vector<float> _peak;
+        std::vector<float> _sorted;
+        std::vector<int> _owner;
+        int _frames;
+
+        // Decoder pool
+        std::vector<Slot> _slots;
+        std::vector<int> _free;
+
+        void Add(std::complex<float> sample);
+        void Analyze();
+        void Detect();
+        void Release(int slot);
+        void AddText(int slot, std::string text);
+        int GetOffset(int bin);
+
+        static bool IsCallsign(std::string word);
+
+    public:
+
+        /**
+         * Construct a new skimmer
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to
+         * @param samplerate Input samplerate
+         * @param isIq Input is IQ samples
+         */
+        BoomaSkimmer(std::string id, HWriterConsumer<int16_t>* previous, int samplerate, bool isIq);
+        ~BoomaSkimmer();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /** Forget all signals, for instance when the input has been retuned */
+        void Reset();
+
+        /** Signals that has decoded text. The frequency is left as 0, the offset is the position in the input */
+        std::vector<BoomaSkimmerSpot> GetSpots();
+};
+
+#endif
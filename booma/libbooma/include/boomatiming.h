@@ -0,0 +1,197 @@
+#ifndef __TIMING_H
+#define __TIMING_H
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <hardtapi.h>
+
+/** Time spent in one stage of the processing chain. Latencies are per call, in nanoseconds */
+struct BoomaStageStatistics {
+    std::string Name;
+    unsigned long Calls;
+    unsigned long Samples;
+    double Nanoseconds;
+    double NanosecondsPerSample;
+    double Min;
+    double P50;
+    double P99;
+    double Max;
+};
+
+/**
+ * Logarithmic latency histogram with 16 linear sub-buckets per power of two, so that
+ * percentiles are accurate to within about 6%.
+ *
+ * There is a single writer, the thread running the stage, while the statistics may be read
+ * and reset from any other thread. All fields are therefore atomic, updated with relaxed
+ * load and store, so a read may see a histogram that is at most one call behind.
+ */
+class BoomaTimingHistogram {
+
+    private:
+
+        static const int SubBuckets = 16;
+        static const int Buckets = 64 * SubBuckets;
+
+        std::vector<std::atomic<unsigned long>> _buckets;
+        std::atomic<unsigned long> _count;
+        std::atomic<double> _min;
+        std::atomic<double> _max;
+
+        static int Index(double nanoseconds);
+        static double Value(int index);
+
+    public:
+
+        BoomaTimingHistogram();
+
+        void Add(double nanoseconds);
+        double GetPercentile(double percentile);
+
+        double GetMin() {
+            return _count.load(std::memory_order_relaxed) > 0 ? _min.load(std::memory_order_relaxed) : 0;
+        }
+
+        double GetMax() {
+            return _max.load(std::memory_order_relaxed);
+        }
+
+        unsigned long GetCount() {
+            return _count.load(std::memory_order_relaxed);
+        }
+
+        void Reset();
+};
+
+/**
+ * Timing of one stage.
+ *
+ * Timed stages may be nested, when a stage calls into the rest of the chain. Time spent in
+ * nested timed stages (on the same thread) is subtracted, so that each stage reports the
+ * time spent in its own code only. Begin() and End() are called by the thread running the
+ * stage, the statistics may be read and reset from any other thread.
+ */
+class BoomaTimingCounter {
+
+    private:
+
+        std::string _name;
+        BoomaTimingHistogram _histogram;
+        std::atomic<unsigned long> _samples;
+        std::atomic<double> _nanoseconds;
+        std::chrono::steady_clock::time_point _start;
+
+    public:
+
+        BoomaTimingCounter(std::string name);
+
+        void Begin();
+        void End(size_t samples);
+
+        BoomaStageStatistics GetStatistics();
+        void Reset();
+};
+
+/** Pass-through writer timing the stage after it */
+class BoomaTimingWriter : public HWriter<int16_t>, public HWriterConsumer<int16_t> {
+
+    private:
+
+        HWriter<int16_t>* _writer;
+        BoomaTimingCounter _counter;
+
+    public:
+
+        BoomaTimingWriter(std::string id, HWriterConsumer<int16_t>* previous);
+
+        int Write(int16_t* src, size_t blocksize);
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            _writer = writer;
+        }
+
+        bool Start() {
+            return _writer != nullptr ? _writer->Start() : true;
+        }
+
+        bool Stop() {
+            return _writer != nullptr ? _writer->Stop() : true;
+        }
+
+        bool Command(HCommand* command) {
+            return _writer != nullptr ? _writer->Command(command) : true;
+        }
+
+        BoomaTimingCounter* GetCounter() {
+            return &_counter;
+        }
+};
+
+/** Pass-through reader timing the stage before it */
+class BoomaTimingReader : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        BoomaTimingCounter _counter;
+
+    public:
+
+        BoomaTimingReader(std::string id, HReader<int16_t>* reader);
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return _reader->Start();
+        }
+
+        bool Stop() {
+            return _reader->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+
+        BoomaTimingCounter* GetCounter() {
+            return &_counter;
+        }
+};
+
+/**
+ * Timing probes for the stages of one component (input, receiver or output).
+ *
+ * When disabled, Probe() returns the given reader or writer consumer unchanged, so
+ * there is no overhead at all.
+ */
+class BoomaTimingCollection {
+
+    private:
+
+        bool _isEnabled;
+        std::vector<BoomaTimingWriter*> _writers;
+        std::vector<BoomaTimingReader*> _readers;
+        std::vector<BoomaTimingCounter*> _counters;
+
+    public:
+
+        BoomaTimingCollection(bool enabled);
+        ~BoomaTimingCollection();
+
+        bool IsEnabled() {
+            return _isEnabled;
+        }
+
+        /** Time the stage that will be attached to the returned writer consumer */
+        HWriterConsumer<int16_t>* Probe(std::string name, HWriterConsumer<int16_t>* previous);
+
+        /** Time the given reader */
+        HReader<int16_t>* Probe(std::string name, HReader<int16_t>* reader);
+
+        void GetStatistics(std::vector<BoomaStageStatistics>* statistics);
+        void Reset();
+};
+
+#endif
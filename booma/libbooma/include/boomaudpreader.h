@@ -0,0 +1,92 @@
+#ifndef __UDPREADER_H
+#define __UDPREADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomawireformat.h"
+#include "boomalinkmeter.h"
+
+/**
+ * Receive samples sent by a BoomaUdpSender, for a remote head.
+ *
+ * Datagrams are held in a small jitter buffer, ordered by sequence number. A datagram that
+ * has not arrived when later datagrams fills the buffer, or when the buffer runs dry, is
+ * concealed with silence or with a repeat of the previous datagram, so the receiver chain
+ * never waits for a retransmission.
+ */
+class BoomaUdpReader : public HReader<int16_t> {
+
+    private:
+
+        std::string _server;
+        int _port;
+        int _depth;
+        bool _isRepeat;
+        double _samplerate;
+        int _socket;
+
+        std::thread* _thread;
+        std::atomic<bool> _isRunning;
+
+        // Jitter buffer
+        std::mutex _mutex;
+        std::condition_variable _arrived;
+        std::map<uint32_t, std::vector<int16_t>> _packets;
+        uint32_t _next;
+        bool _isPlaying;
+        std::vector<int16_t> _previous;
+        std::vector<int16_t> _pending;
+
+        unsigned long _received;
+        unsigned long _lost;
+        unsigned long _late;
+        BoomaLinkMeter _meter;
+
+        void ReceiverThread();
+
+    public:
+
+        /**
+         * Construct a new UDP reader
+         *
+         * @param id Id of this reader
+         * @param server Address of the remote input server
+         * @param port UDP data port of the server
+         * @param depth Number of datagrams held in the jitter buffer
+         * @param isRepeat Conceal lost datagrams by repeating the previous datagram, otherwise with silence
+         * @param samplerate Number of values per second, including both I and Q for IQ data
+         */
+        BoomaUdpReader(std::string id, std::string server, int port, int depth, bool isRepeat, int samplerate);
+        ~BoomaUdpReader();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command) {
+            return true;
+        }
+
+        /** Number of datagrams that were concealed */
+        unsigned long GetLost() {
+            return _lost;
+        }
+
+        /** Number of datagrams that arrived after they had been concealed */
+        unsigned long GetLate() {
+            return _late;
+        }
+
+        /** Throughput, delay and jitter buffer depth of the received datagrams */
+        void GetStatistics(BoomaRemoteStatistics* statistics);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef __UDPSENDER_H
+#define __UDPSENDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <netinet/in.h>
+#include <thread>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomawireformat.h"
+#include "boomalinkmeter.h"
+
+/**
+ * Send the samples from a reader to a remote head as UDP datagrams.
+ *
+ * Each datagram holds one wire frame (see BoomaWireFormat) of at most UDP_PACKET_SAMPLES
+ * samples, so a lost datagram only loses its own samples and the head can detect the loss
+ * from the sequence numbers. The head announces its address by sending "BUH1" datagrams to
+ * the data port, samples are sent to the address of the latest announcement.
+ *
+ * Samples are read and sent by a sender thread of its own, started and stopped with the reader.
+ * The network processor still runs the TCP connections, for commands and as a keepalive: Its
+ * data connection only carries one empty block for every UDP_HEARTBEAT_BLOCKS blocks sent as
+ * datagrams, or every UDP_KEEPALIVE_SECONDS seconds if the input stalls. A TCP write that stalls
+ * never holds up the datagrams.
+ */
+class BoomaUdpSender : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        WireFormatType _format;
+        int _channels;
+        size_t _blocksize;
+        int16_t* _block;
+        int _socket;
+        struct sockaddr_storage _head;
+        socklen_t _headLength;
+        uint32_t _sequence;
+        std::vector<uint8_t> _frame;
+        unsigned long _failed;
+        BoomaLinkMeter _meter;
+
+        // Sender thread, and the keepalive handed to the network processor
+        std::thread* _thread;
+        std::atomic<bool> _isRunning;
+        std::mutex _mutex;
+        std::condition_variable _heartbeat;
+        bool _isHeartbeatDue;
+        bool _isEndOfInput;
+        int _endOfInput;
+
+        void SenderThread();
+        void ReceiveAnnouncements();
+
+    public:
+
+        /**
+         * Construct a new UDP sender
+         *
+         * @param id Id of this reader
+         * @param reader Reader to send samples from
+         * @param port UDP port to receive announcements on
+         * @param format Wire format of the datagrams
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param blocksize Number of samples read from the reader at a time
+         */
+        BoomaUdpSender(std::string id, HReader<int16_t>* reader, int port, WireFormatType format, int channels, size_t blocksize);
+        ~BoomaUdpSender();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start();
+        bool Stop();
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+
+        /** Throughput of the datagrams sent */
+        void GetStatistics(BoomaRemoteStatistics* statistics) {
+            _meter.GetStatistics(statistics);
+        }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef __WIREDECODER_H
+#define __WIREDECODER_H
+
+#include <atomic>
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomawireformat.h"
+#include "boomalinkmeter.h"
+
+/**
+ * Decode the wire frames received by a remote head, see BoomaWireEncoder.
+ *
+ * The format is taken from each frame, so the head does not need to know the format
+ * chosen by the server. Gaps in the sequence numbers are reported.
+ *
+ * A head that does not expect frames passes the samples on unchanged. In both cases the
+ * start of the stream is checked, and a BoomaInputException is thrown if the server and
+ * the head does not agree on the use of wire frames. Raw samples are metered, but has
+ * no timestamps.
+ */
+class BoomaWireDecoder : public HWriter<int16_t>, public HWriterConsumer<int16_t> {
+
+    private:
+
+        HWriter<int16_t>* _writer;
+        size_t _blocksize;
+        bool _isFramed;
+        bool _isChecked;
+        std::vector<uint8_t> _received;
+        std::vector<int16_t> _samples;
+        WireFormatType _format;
+        uint32_t _expected;
+        unsigned long _frames;
+        std::atomic<unsigned long> _lost;
+        std::atomic<unsigned long> _corrupt;
+        std::atomic<size_t> _queued;
+        BoomaLinkMeter _meter;
+
+    public:
+
+        /**
+         * Construct a new wire decoder
+         *
+         * @param id Id of this writer
+         * @param previous Writer consumer to attach to
+         * @param blocksize Number of samples written to the next writer at a time
+         * @param isFramed The server sends wire frames ('-wf'), otherwise raw samples
+         */
+        BoomaWireDecoder(std::string id, HWriterConsumer<int16_t>* previous, size_t blocksize, bool isFramed);
+        ~BoomaWireDecoder();
+
+        int Write(int16_t* src, size_t blocksize);
+
+        bool Start() {
+            return _writer == nullptr || _writer->Start();
+        }
+
+        bool Stop() {
+            return _writer == nullptr || _writer->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _writer == nullptr || _writer->Command(command);
+        }
+
+        void SetWriter(HWriter<int16_t>* writer) {
+            _writer = writer;
+        }
+
+        /** The server sends wire frames */
+        bool IsFramed() {
+            return _isFramed;
+        }
+
+        /** Number of frames missing from the sequence */
+        unsigned long GetLostFrames() {
+            return _lost;
+        }
+
+        /** Number of damaged frames that were skipped */
+        unsigned long GetCorruptFrames() {
+            return _corrupt;
+        }
+
+        /** Throughput and delay of the received stream */
+        void GetStatistics(BoomaRemoteStatistics* statistics);
+};
+
+#endif
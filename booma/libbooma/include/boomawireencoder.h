@@ -0,0 +1,69 @@
+#ifndef __WIREENCODER_H
+#define __WIREENCODER_H
+
+#include <vector>
+
+#include <hardtapi.h>
+
+#include "boomawireformat.h"
+#include "boomalinkmeter.h"
+
+/**
+ * Encode the samples from a reader into wire frames, for a remote input server.
+ *
+ * The network processor sends fixed size blocks, so the encoded frames are sent as a continuous
+ * stream of bytes cut into blocks. When the frames are compressed, each block read by the network
+ * processor holds several blocks of samples.
+ *
+ * Without a wire format (NO_WIRE) the samples are passed on unchanged, and only metered.
+ */
+class BoomaWireEncoder : public HReader<int16_t> {
+
+    private:
+
+        HReader<int16_t>* _reader;
+        WireFormatType _format;
+        int _channels;
+        size_t _blocksize;
+        int16_t* _block;
+        uint32_t _sequence;
+        std::vector<uint8_t> _pending;
+        unsigned long long _samplesIn;
+        unsigned long long _bytesOut;
+        BoomaLinkMeter _meter;
+
+    public:
+
+        /**
+         * Construct a new wire encoder
+         *
+         * @param id Id of this reader
+         * @param reader Reader to encode samples from
+         * @param format Wire format
+         * @param channels Number of interleaved channels (2 for IQ data)
+         * @param blocksize Number of samples read from the reader at a time
+         */
+        BoomaWireEncoder(std::string id, HReader<int16_t>* reader, WireFormatType format, int channels, size_t blocksize);
+        ~BoomaWireEncoder();
+
+        int Read(int16_t* dest, size_t blocksize);
+
+        bool Start() {
+            return _reader->Start();
+        }
+
+        bool Stop() {
+            return _reader->Stop();
+        }
+
+        bool Command(HCommand* command) {
+            return _reader->Command(command);
+        }
+
+        /** Throughput of the encoded stream */
+        void GetStatistics(BoomaRemoteStatistics* statistics) {
+            _meter.GetStatistics(statistics);
+        }
+};
+
+#endif
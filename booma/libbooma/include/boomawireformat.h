@@ -0,0 +1,77 @@
+#ifndef __WIREFORMAT_H
+#define __WIREFORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "configoptions.h"
+
+/**
+ * Framing and compression of samples sent from a remote input server to a remote head.
+ *
+ * Each block of samples read by the server is sent as one self describing frame, so the head
+ * follows whatever format the server has been configured to send:
+ *
+ *   Frame header: "BW", version (uint8), format (uint8), sequence number (uint32),
+ *                 samples in the frame (uint16), channels (uint8), shift (uint8),
+ *                 payload bytes (uint32), timestamp (uint64, microseconds since the epoch)
+ *   Payload:      RAW_WIRE:          int16 samples
+ *                 PACK12_WIRE:       two 12 bit samples in three bytes
+ *                 PACK8_WIRE:        one 8 bit sample per byte
+ *                 BLC*_WIRE:         a BLC frame, see BoomaLosslessCodec
+ *
+ * The reduced width formats scale each frame by the smallest right shift that makes the
+ * largest sample fit, so quiet signals keep their full resolution. BLC_WIRE is lossless,
+ * BLC12_WIRE and BLC8_WIRE reduce the width before compressing.
+ *
+ * All values are little endian.
+ */
+class BoomaWireFormat {
+
+    public:
+
+        static const int HeaderSize = 24;
+        static const int Version = 2;
+
+        enum Result {
+            DECODED = 0,
+            INCOMPLETE = 1,
+            CORRUPT = 2
+        };
+
+        /**
+         * Encode a block of interleaved samples
+         *
+         * @param samples Samples
+         * @param length Number of samples, must be a multiple of the channel count
+         * @param channels Number of interleaved channels
+         * @param format Wire format
+         * @param sequence Sequence number of the frame
+         * @param timestamp Time the samples were sent, microseconds since the epoch
+         * @param frame The frame is appended to this vector
+         */
+        static void Encode(const int16_t* samples, int length, int channels, WireFormatType format, uint32_t sequence, uint64_t timestamp, std::vector<uint8_t>* frame);
+
+        /**
+         * Decode the first frame in a stream of received bytes
+         *
+         * @param data Received bytes
+         * @param size Number of received bytes
+         * @param used Number of bytes consumed, this includes bytes skipped while searching for a frame header
+         * @param format Format of the decoded frame
+         * @param sequence Sequence number of the decoded frame
+         * @param timestamp Timestamp of the decoded frame
+         * @param samples Decoded samples are appended to this vector
+         * @return DECODED, INCOMPLETE if more bytes are needed, or CORRUPT if a damaged frame was skipped
+         */
+        static Result Decode(const uint8_t* data, size_t size, size_t* used, WireFormatType* format, uint32_t* sequence, uint64_t* timestamp, std::vector<int16_t>* samples);
+
+        /** True if the bytes starts with a plausible frame header */
+        static bool IsHeader(const uint8_t* data, size_t size);
+
+        /** Name of a wire format, for logging */
+        static const char* GetName(WireFormatType format);
+};
+
+#endif
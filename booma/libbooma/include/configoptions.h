@@ -143,6 +143,34 @@ class ConfigOptions {
             return true;
         }
 
+        WireFormatType GetWireFormat() {
+            return _values.at(_section)->_wireFormat;
+        }
+
+        int GetChannelExtraction() {
+            return _values.at(_section)->_channelExtraction;
+        }
+
+        int GetRemoteClients() {
+            return _values.at(_section)->_remoteClients;
+        }
+
+        bool GetUdpTransport() {
+            return _values.at(_section)->_udpTransport;
+        }
+
+        bool GetUdpRepeat() {
+            return _values.at(_section)->_udpRepeat;
+        }
+
+        int GetJitterBufferPackets() {
+            return _values.at(_section)->_jitterBufferPackets;
+        }
+
+        int GetRemoteStatisticsInterval() {
+            return _values.at(_section)->_remoteStatisticsInterval;
+        }
+
         bool GetUseRemoteHead() {
             return _values.at(_section)->_useRemoteHead;
         }
@@ -236,6 +264,15 @@ class ConfigOptions {
             return true;
         }
 
+        std::string GetBlcFile() {
+            return _values.at(_section)->_blcFile;
+        }
+
+        bool SetBlcFile(std::string filename) {
+            _values.at(_section)->_blcFile = filename;
+            return true;
+        }
+
         bool GetEnableProbes() {
             return _values.at(_section)->_enableProbes;
         }
@@ -290,6 +327,50 @@ class ConfigOptions {
             return _values.at(_section)->_dumpFileSuffix;
         }
 
+        bool GetDumpSegmented() {
+            return _values.at(_section)->_dumpSegmentMinutes > 0 || _values.at(_section)->_dumpSegmentSize > 0;
+        }
+
+        int GetDumpSegmentMinutes() {
+            return _values.at(_section)->_dumpSegmentMinutes;
+        }
+
+        int GetDumpSegmentSize() {
+            return _values.at(_section)->_dumpSegmentSize;
+        }
+
+        int GetDumpSegmentLimit() {
+            return _values.at(_section)->_dumpSegmentLimit;
+        }
+
+        bool GetAsyncDump() {
+            return _values.at(_section)->_asyncDump;
+        }
+
+        int GetCaptureSeconds() {
+            return _values.at(_section)->_captureSeconds;
+        }
+
+        int GetTriggerLevel() {
+            return _values.at(_section)->_triggerLevel;
+        }
+
+        double GetTriggerHold() {
+            return _values.at(_section)->_triggerHold;
+        }
+
+        double GetTriggerRelease() {
+            return _values.at(_section)->_triggerRelease;
+        }
+
+        bool GetTriggerRf() {
+            return _values.at(_section)->_triggerRf;
+        }
+
+        bool GetTriggerAudio() {
+            return _values.at(_section)->_triggerAudio;
+        }
+
         std::string GetOutputFilename() {
             return _values.at(_section)->_outputFilename;
         }
@@ -302,6 +383,50 @@ class ConfigOptions {
             return (_values.at(_section)->_outputSampleRate / 2) * 0.9;
         }
 
+        bool GetPolyphaseChannelizer() {
+            return _values.at(_section)->_polyphaseChannelizer;
+        }
+
+        DecimationPlanType GetDecimationPlan() {
+            return _values.at(_section)->_decimationPlan;
+        }
+
+        int GetInputRingBufferBlocks() {
+            return _values.at(_section)->_inputRingBufferBlocks;
+        }
+
+        int GetPipelineDepth() {
+            return _values.at(_section)->_pipelineDepth;
+        }
+
+        bool GetStageTiming() {
+            return _values.at(_section)->_stageTiming;
+        }
+
+        bool GetBatchMode() {
+            return _values.at(_section)->_batchMode;
+        }
+
+        int GetBatchSegments() {
+            return _values.at(_section)->_batchSegments;
+        }
+
+        int GetBatchOverlap() {
+            return _values.at(_section)->_batchOverlap;
+        }
+
+        bool GetMemoryMappedInput() {
+            return _values.at(_section)->_memoryMappedInput;
+        }
+
+        double GetInputSeek() {
+            return _values.at(_section)->_inputSeek;
+        }
+
+        int GetPipelineCpu(int stage) {
+            return stage < _values.at(_section)->_pipelineAffinity.size() ? _values.at(_section)->_pipelineAffinity.at(stage) : -1;
+        }
+
         int GetRtlsdrCorrectionFactor() {
             return _values.at(_section)->_rtlsdrCorrectionFactor;
         }
@@ -360,6 +485,18 @@ class ConfigOptions {
             return false;
         }
 
+        std::vector<Channel*> GetReceiverChannels() {
+            return _values.at(_section)->_receiverChannels;
+        }
+
+        bool GetCwDecoder() {
+            return _values.at(_section)->_cwDecoder;
+        }
+
+        bool GetSkimmer() {
+            return _values.at(_section)->_skimmer;
+        }
+
         bool SetInputFilterWidth(int width) {
             _values.at(_section)->_inputFilterWidth = width;
             return true;
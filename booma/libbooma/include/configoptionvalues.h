@@ -10,7 +10,8 @@ enum InputSourceType {
     WAV_FILE = 4,
     SILENCE = 5,
     NETWORK = 6,
-    RTLSDR = 7
+    RTLSDR = 7,
+    BLC_FILE = 8
 };
 
 /** Type of input data received from the input device */
@@ -28,13 +29,32 @@ enum ReceiverModeType {
     CW = 1,
     AURORAL = 2,
     AM = 3,
-    SSB = 4
+    SSB = 4,
+    RTTY = 5
 };
 
 /** Format of the dump file */
 enum DumpFileFormatType {
     PCM = 0,
-    WAV = 1
+    WAV = 1,
+    BLC = 2
+};
+
+/** Framing and compression of samples sent to a remote head */
+enum WireFormatType {
+    RAW_WIRE = 0,
+    BLC_WIRE = 1,
+    PACK12_WIRE = 2,
+    PACK8_WIRE = 3,
+    BLC12_WIRE = 4,
+    BLC8_WIRE = 5,
+    NO_WIRE = 255
+};
+
+/** Structure of the input decimation chain */
+enum DecimationPlanType {
+    FIR_DECIMATION = 0,
+    HALFBAND_DECIMATION = 1
 };
 
  class ConfigOptionValues {
@@ -60,6 +80,13 @@ enum DumpFileFormatType {
              _remoteServer = other->_remoteServer;
              _remoteDataPort = other->_remoteDataPort;
              _remoteCommandPort = other->_remoteCommandPort;
+             _wireFormat = other->_wireFormat;
+             _channelExtraction = other->_channelExtraction;
+             _remoteClients = other->_remoteClients;
+             _udpTransport = other->_udpTransport;
+             _udpRepeat = other->_udpRepeat;
+             _jitterBufferPackets = other->_jitterBufferPackets;
+             _remoteStatisticsInterval = other->_remoteStatisticsInterval;
              _useRemoteHead = other->_useRemoteHead;
              _rfGain = other->_rfGain;
              _rfAgcLevel = other->_rfAgcLevel;
@@ -69,10 +96,21 @@ enum DumpFileFormatType {
              _dumpRfFileFormat = other->_dumpRfFileFormat;
              _dumpAudioFileFormat = other->_dumpAudioFileFormat;
              _dumpFileSuffix = other->_dumpFileSuffix;
+             _dumpSegmentMinutes = other->_dumpSegmentMinutes;
+             _dumpSegmentSize = other->_dumpSegmentSize;
+             _dumpSegmentLimit = other->_dumpSegmentLimit;
+             _asyncDump = other->_asyncDump;
+             _captureSeconds = other->_captureSeconds;
+             _triggerLevel = other->_triggerLevel;
+             _triggerHold = other->_triggerHold;
+             _triggerRelease = other->_triggerRelease;
+             _triggerRf = other->_triggerRf;
+             _triggerAudio = other->_triggerAudio;
              _schedule = other->_schedule;
              _signalGeneratorFrequency = other->_signalGeneratorFrequency;
              _pcmFile = other->_pcmFile;
              _wavFile = other->_wavFile;
+             _blcFile = other->_blcFile;
              _frequencyAlign = other->_frequencyAlign;
              _frequencyAlignVolume = other->_frequencyAlignVolume;
              _enableProbes = other->_enableProbes;
@@ -88,6 +126,20 @@ enum DumpFileFormatType {
              _firFilterSize = other->_firFilterSize;
              _inputFilterWidth = other->_inputFilterWidth;
              _channels = other->_channels;
+             _receiverChannels = other->_receiverChannels;
+             _cwDecoder = other->_cwDecoder;
+             _skimmer = other->_skimmer;
+             _polyphaseChannelizer = other->_polyphaseChannelizer;
+             _decimationPlan = other->_decimationPlan;
+             _inputRingBufferBlocks = other->_inputRingBufferBlocks;
+             _pipelineDepth = other->_pipelineDepth;
+             _pipelineAffinity = other->_pipelineAffinity;
+             _stageTiming = other->_stageTiming;
+             _batchMode = other->_batchMode;
+             _batchSegments = other->_batchSegments;
+             _batchOverlap = other->_batchOverlap;
+             _memoryMappedInput = other->_memoryMappedInput;
+             _inputSeek = other->_inputSeek;
          }
          
         // Samplerates
@@ -123,6 +175,13 @@ enum DumpFileFormatType {
         std::string _remoteServer;
         int _remoteDataPort = 0;
         int _remoteCommandPort = 0;
+        WireFormatType _wireFormat = NO_WIRE;
+        int _channelExtraction = 0;
+        int _remoteClients = 1;
+        bool _udpTransport = false;
+        bool _udpRepeat = false;
+        int _jitterBufferPackets = 4;
+        int _remoteStatisticsInterval = 0;
         bool _useRemoteHead = false;
     
         // Preamp gain, agc setting and input filter width
@@ -140,6 +199,16 @@ enum DumpFileFormatType {
         DumpFileFormatType _dumpRfFileFormat = PCM;
         DumpFileFormatType _dumpAudioFileFormat = WAV;
         std::string _dumpFileSuffix = "";
+        int _dumpSegmentMinutes = 0;
+        int _dumpSegmentSize = 0;
+        int _dumpSegmentLimit = 0;
+        bool _asyncDump = false;
+        int _captureSeconds = 0;
+        int _triggerLevel = 0;
+        double _triggerHold = 1;
+        double _triggerRelease = 5;
+        bool _triggerRf = false;
+        bool _triggerAudio = true;
     
         // Scheduled start and stop
         HTimer _schedule;
@@ -148,6 +217,7 @@ enum DumpFileFormatType {
         int _signalGeneratorFrequency = -1;
         std::string _pcmFile = "";
         std::string _wavFile = "";
+        std::string _blcFile = "";
         bool _frequencyAlign = false;
         int _frequencyAlignVolume = 500;
         bool _enableProbes = false;
@@ -174,10 +244,30 @@ enum DumpFileFormatType {
         int _rfAgcLevel = 500;
         int _decimatorAgcLevel = 1000;
         int _afFftAgcLevel = 150;
+        bool _polyphaseChannelizer = false;
+        DecimationPlanType _decimationPlan = FIR_DECIMATION;
+        int _inputRingBufferBlocks = 0;
+        int _pipelineDepth = 0;
+        std::vector<int> _pipelineAffinity;
+        bool _stageTiming = false;
+        bool _batchMode = false;
+        int _batchSegments = 0;
+        int _batchOverlap = 2;
+        bool _memoryMappedInput = false;
+        double _inputSeek = 0;
 
         // Memory channels
          std::vector<Channel*> _channels;
 
+         // Additional receiver channels decoded from the same input stream (not stored)
+         std::vector<Channel*> _receiverChannels;
+
+         // Decode CW in the receiver and all receiver channels (not stored)
+         bool _cwDecoder = false;
+
+         // Decode all CW signals in the input passband (not stored)
+         bool _skimmer = false;
+
          // Faulty configuration flag
          bool _faulty = false;
 };